@@ -113,7 +113,7 @@ bool exe_close(PlayerType *player_ptr, POSITION y, POSITION x)
     }
 
     int16_t closed_feat = feat_state(player_ptr->current_floor_ptr, old_feat, TerrainCharacteristics::CLOSE);
-    if ((!g_ptr->o_idx_list.empty() || g_ptr->is_object()) && (closed_feat != old_feat) && terrains_info[closed_feat].flags.has_not(TerrainCharacteristics::DROP)) {
+    if ((!player_ptr->current_floor_ptr->grid_array.o_idx_list(g_ptr).empty() || g_ptr->is_object()) && (closed_feat != old_feat) && terrains_info[closed_feat].flags.has_not(TerrainCharacteristics::DROP)) {
         msg_print(_("何かがつっかえて閉まらない。", "Something prevents it from closing."));
         return more;
     }
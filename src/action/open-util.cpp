@@ -23,7 +23,7 @@
 OBJECT_IDX chest_check(FloorType *floor_ptr, POSITION y, POSITION x, bool trapped)
 {
     auto *g_ptr = &floor_ptr->grid_array[y][x];
-    for (const auto this_o_idx : g_ptr->o_idx_list) {
+    for (const auto this_o_idx : floor_ptr->grid_array.o_idx_list(g_ptr)) {
         const auto &item = floor_ptr->o_list[this_o_idx];
         const auto is_empty = trapped || (item.pval == 0);
         const auto trapped_only = trapped && (item.pval > 0);
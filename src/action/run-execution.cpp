@@ -237,7 +237,7 @@ static bool run_test(PlayerType *player_ptr)
             }
         }
 
-        for (const auto this_o_idx : g_ptr->o_idx_list) {
+        for (const auto this_o_idx : floor_ptr->grid_array.o_idx_list(g_ptr)) {
             ItemEntity *o_ptr;
             o_ptr = &floor_ptr->o_list[this_o_idx];
             if (o_ptr->marked.has(OmType::FOUND)) {
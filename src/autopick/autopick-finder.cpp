@@ -9,6 +9,7 @@
 #include "autopick/autopick-dirty-flags.h"
 #include "autopick/autopick-entry.h"
 #include "autopick/autopick-matcher.h"
+#include "autopick/autopick-rule-index.h"
 #include "autopick/autopick-util.h"
 #include "core/show-file.h"
 #include "flavor/flavor-describer.h"
@@ -32,6 +33,7 @@
  * @details
  * A function for Auto-picker/destroyer
  * Examine whether the object matches to the list of keywords or not.
+ * 鑑定状態や名前が前回から変わっていなければ、キャッシュした結果を返す.
  */
 int find_autopick_list(PlayerType *player_ptr, ItemEntity *o_ptr)
 {
@@ -40,16 +42,15 @@ int find_autopick_list(PlayerType *player_ptr, ItemEntity *o_ptr)
         return -1;
     }
 
-    describe_flavor(player_ptr, o_name, o_ptr, (OD_NO_FLAVOR | OD_OMIT_PREFIX | OD_NO_PLURAL));
-    str_tolower(o_name);
-    for (auto i = 0U; i < autopick_list.size(); i++) {
-        autopick_type *entry = &autopick_list[i];
-        if (is_autopick_match(player_ptr, o_ptr, entry, o_name)) {
-            return i;
-        }
+    auto &rule_index = AutopickRuleIndex::get_instance();
+    const auto cached_idx = rule_index.find_cached(*o_ptr);
+    if (cached_idx) {
+        return *cached_idx;
     }
 
-    return -1;
+    describe_flavor(player_ptr, o_name, o_ptr, (OD_NO_FLAVOR | OD_OMIT_PREFIX | OD_NO_PLURAL));
+    str_tolower(o_name);
+    return rule_index.find_match(player_ptr, o_ptr, o_name);
 }
 
 /*!
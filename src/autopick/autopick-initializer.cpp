@@ -1,5 +1,6 @@
 ﻿#include "autopick/autopick-initializer.h"
 #include "autopick/autopick-entry.h"
+#include "autopick/autopick-rule-index.h"
 #include "autopick/autopick-util.h"
 #include "system/angband.h"
 
@@ -14,4 +15,5 @@ void init_autopick(void)
     autopick_type entry;
     autopick_new_entry(&entry, easy_autopick_inscription, true);
     autopick_list.push_back(std::move(entry));
+    AutopickRuleIndex::get_instance().invalidate();
 }
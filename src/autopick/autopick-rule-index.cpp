@@ -0,0 +1,381 @@
+﻿/*!
+ * @brief 自動拾いリストの検索索引と一致結果のキャッシュ
+ * @details
+ * 行毎にis_autopick_match()を総当たりで呼ぶ代わりに、
+ * tvalによる候補の絞り込みと文字列部分の一括照合を行い、残った行だけを詳しく調べる.
+ */
+
+#include "autopick/autopick-rule-index.h"
+#include "autopick/autopick-flags-table.h"
+#include "autopick/autopick-key-flag-process.h"
+#include "autopick/autopick-matcher.h"
+#include "autopick/autopick-util.h"
+#include "game-option/text-display-options.h"
+#include "system/baseitem-info.h"
+#include "system/item-entity.h"
+#include <algorithm>
+#include <queue>
+
+bool AutopickItemState::operator==(const AutopickItemState &other) const
+{
+    auto is_equal = (this->describe_options == other.describe_options);
+    is_equal &= (this->bi_id == other.bi_id) && (this->ident == other.ident) && (this->feeling == other.feeling);
+    is_equal &= (this->is_aware == other.is_aware) && (this->is_tried == other.is_tried);
+    is_equal &= (this->inscription == other.inscription) && (this->art_name == other.art_name);
+    is_equal &= (this->pval == other.pval) && (this->number == other.number) && (this->timeout == other.timeout) && (this->fuel == other.fuel);
+    is_equal &= (this->discount == other.discount) && (this->dd == other.dd) && (this->ds == other.ds);
+    is_equal &= (this->to_h == other.to_h) && (this->to_d == other.to_d) && (this->to_a == other.to_a) && (this->ac == other.ac);
+    is_equal &= (this->ego_idx == other.ego_idx) && (this->fixed_artifact_idx == other.fixed_artifact_idx);
+    is_equal &= (this->smith_hit == other.smith_hit) && (this->smith_damage == other.smith_damage);
+    return is_equal && (this->art_flags == other.art_flags) && (this->curse_flags == other.curse_flags);
+}
+
+AutopickRuleIndex &AutopickRuleIndex::get_instance()
+{
+    static AutopickRuleIndex instance{};
+    return instance;
+}
+
+/*!
+ * @brief 自動拾いリストの変更に伴い、索引とキャッシュを破棄する
+ */
+void AutopickRuleIndex::invalidate()
+{
+    this->is_compiled = false;
+    this->item_caches.clear();
+}
+
+/*!
+ * @brief アイテムの一致結果がキャッシュされていれば返す
+ * @param item 調べるアイテム
+ * @return 自動拾いリストの登録番号(無登録なら-1)、キャッシュされていなければnullopt
+ */
+std::optional<int> AutopickRuleIndex::find_cached(const ItemEntity &item)
+{
+    if (!this->is_compiled || (this->compiled_size != autopick_list.size())) {
+        this->compile();
+        return std::nullopt;
+    }
+
+    const auto it = this->item_caches.find(&item);
+    if ((it == this->item_caches.end()) || !(it->second.state == make_item_state(item))) {
+        return std::nullopt;
+    }
+
+    return it->second.rule_idx;
+}
+
+/*!
+ * @brief 索引を用いてアイテムに一致する最初の自動拾いリストの行を探す
+ * @param player_ptr プレイヤーへの参照ポインタ
+ * @param o_ptr アイテムへの参照ポインタ
+ * @param o_name 小文字化したアイテム名
+ * @return 自動拾いのリストに登録されていたらその登録番号、なかったら-1
+ * @details
+ * 途中でプレイヤーの状態に依存する行を調べた場合や、
+ * アイテム名の記述そのものがプレイヤーの状態に依存する場合、結果はキャッシュしない
+ */
+int AutopickRuleIndex::find_match(PlayerType *player_ptr, ItemEntity *o_ptr, concptr o_name)
+{
+    if (!this->is_compiled || (this->compiled_size != autopick_list.size())) {
+        this->compile();
+    }
+
+    this->match_patterns(o_name);
+    auto rule_idx = -1;
+    auto depends_on_player = describes_player_state(*o_ptr);
+    for (const auto i : this->get_candidates(o_ptr->bi_key.tval())) {
+        if (!this->is_name_candidate(i)) {
+            continue;
+        }
+
+        depends_on_player |= this->rules[i].depends_on_player;
+        if (is_autopick_match(player_ptr, o_ptr, &autopick_list[i], o_name)) {
+            rule_idx = i;
+            break;
+        }
+    }
+
+    if (depends_on_player) {
+        return rule_idx;
+    }
+
+    if (this->item_caches.size() >= ITEM_CACHE_MAX) {
+        this->item_caches.clear();
+    }
+
+    this->item_caches[o_ptr] = { make_item_state(*o_ptr), rule_idx };
+    return rule_idx;
+}
+
+/*!
+ * @brief 自動拾いリスト全体を索引へコンパイルする
+ */
+void AutopickRuleIndex::compile()
+{
+    this->rules.clear();
+    this->rules.reserve(autopick_list.size());
+    for (const auto &entry : autopick_list) {
+        this->rules.push_back(compile_rule(entry));
+    }
+
+    for (auto &candidate : this->candidates) {
+        candidate.reset();
+    }
+
+    this->compile_patterns();
+    this->item_caches.clear();
+    this->compiled_size = autopick_list.size();
+    this->is_compiled = true;
+}
+
+/*!
+ * @brief 部分一致の照合が必要な行の文字列からAho-Corasickオートマトンを作る
+ */
+void AutopickRuleIndex::compile_patterns()
+{
+    this->nodes.assign(1, {});
+    for (auto i = 0; i < static_cast<int>(autopick_list.size()); i++) {
+        if (!this->rules[i].has_substring) {
+            continue;
+        }
+
+        auto node = 0;
+        for (const auto c : autopick_list[i].name) {
+            auto next = this->find_child(node, c);
+            if (next < 0) {
+                next = static_cast<int>(this->nodes.size());
+                this->nodes[node].children.emplace_back(c, next);
+                this->nodes.emplace_back();
+            }
+
+            node = next;
+        }
+
+        this->nodes[node].rule_indices.push_back(i);
+    }
+
+    std::queue<int> que;
+    for (const auto &[c, child] : this->nodes[0].children) {
+        que.push(child);
+    }
+
+    while (!que.empty()) {
+        const auto node = que.front();
+        que.pop();
+        for (const auto &[c, child] : this->nodes[node].children) {
+            auto fail = this->nodes[node].fail;
+            auto next = this->find_child(fail, c);
+            while ((next < 0) && (fail != 0)) {
+                fail = this->nodes[fail].fail;
+                next = this->find_child(fail, c);
+            }
+
+            auto &child_node = this->nodes[child];
+            child_node.fail = std::max(next, 0);
+            const auto &fail_node = this->nodes[child_node.fail];
+            child_node.output = fail_node.rule_indices.empty() ? fail_node.output : child_node.fail;
+            que.push(child);
+        }
+    }
+
+    this->matched_stamps.assign(autopick_list.size(), 0);
+    this->match_stamp = 0;
+}
+
+/*!
+ * @brief 指定したtvalのアイテムに一致し得る行の一覧を返す
+ * @param tval アイテムの大分類
+ * @return 自動拾いリストの登録番号の昇順リスト
+ * @details 一覧は初めて要求された時に作る
+ */
+const std::vector<int> &AutopickRuleIndex::get_candidates(ItemKindType tval)
+{
+    auto &candidate = this->candidates[enum2i(tval)];
+    if (candidate) {
+        return *candidate;
+    }
+
+    candidate.emplace();
+    for (auto i = 0; i < static_cast<int>(this->rules.size()); i++) {
+        if (this->rules[i].tvals.test(enum2i(tval))) {
+            candidate->push_back(i);
+        }
+    }
+
+    return *candidate;
+}
+
+int AutopickRuleIndex::find_child(int node, char c) const
+{
+    for (const auto &[child_c, child] : this->nodes[node].children) {
+        if (child_c == c) {
+            return child;
+        }
+    }
+
+    return -1;
+}
+
+/*!
+ * @brief アイテム名に部分一致する行へ一括で印を付ける
+ * @param o_name 小文字化したアイテム名
+ * @details
+ * バイト単位で照合するため、漢字の途中から一致したものにも印が付く.
+ * 最終的な判定はis_autopick_match()が行うので、候補を余分に残すだけで結果は変わらない.
+ */
+void AutopickRuleIndex::match_patterns(concptr o_name)
+{
+    if (++this->match_stamp == 0) {
+        std::fill(this->matched_stamps.begin(), this->matched_stamps.end(), 0);
+        this->match_stamp = 1;
+    }
+
+    auto node = 0;
+    for (auto ptr = o_name; *ptr; ptr++) {
+        auto next = this->find_child(node, *ptr);
+        while ((next < 0) && (node != 0)) {
+            node = this->nodes[node].fail;
+            next = this->find_child(node, *ptr);
+        }
+
+        node = std::max(next, 0);
+        for (auto output = this->nodes[node].rule_indices.empty() ? this->nodes[node].output : node; output >= 0; output = this->nodes[output].output) {
+            for (const auto i : this->nodes[output].rule_indices) {
+                this->matched_stamps[i] = this->match_stamp;
+            }
+        }
+    }
+}
+
+bool AutopickRuleIndex::is_name_candidate(int rule_idx) const
+{
+    return !this->rules[rule_idx].has_substring || (this->matched_stamps[rule_idx] == this->match_stamp);
+}
+
+/*!
+ * @brief 自動拾いリストの1行から、一致し得るtvalと状態依存性を求める
+ * @param entry 自動拾いリストの行
+ * @return コンパイル済みの行
+ * @details is_autopick_match() のうち、tvalだけで判定できる条件を抜き出したもの
+ */
+AutopickRuleIndex::CompiledRule AutopickRuleIndex::compile_rule(const autopick_type &entry_ref)
+{
+    const auto *entry = &entry_ref;
+    CompiledRule rule{};
+    rule.depends_on_player = IS_FLG(FLG_COLLECTING) || IS_FLG(FLG_BOOSTED) || IS_FLG(FLG_WANTED);
+    rule.depends_on_player |= IS_FLG(FLG_UNREADABLE) || IS_FLG(FLG_REALM1) || IS_FLG(FLG_REALM2);
+    rule.has_substring = !entry->name.empty() && (entry->name[0] != '^');
+    for (auto i = 0; i < ITEM_KIND_TYPE_NUM; i++) {
+        const BaseitemKey bi_key(i2enum<ItemKindType>(i));
+        const auto tval = bi_key.tval();
+        auto can_match = true;
+        can_match &= !IS_FLG(FLG_BOOSTED) || bi_key.is_melee_weapon();
+        can_match &= !(IS_FLG(FLG_GOOD) || IS_FLG(FLG_NAMELESS) || IS_FLG(FLG_AVERAGE)) || bi_key.is_equipement();
+        can_match &= !IS_FLG(FLG_UNIQUE) || (tval == ItemKindType::CORPSE) || (tval == ItemKindType::STATUE);
+        can_match &= !IS_FLG(FLG_HUMAN) || (tval == ItemKindType::CORPSE);
+        can_match &= !(IS_FLG(FLG_FIRST) || IS_FLG(FLG_SECOND) || IS_FLG(FLG_THIRD) || IS_FLG(FLG_FOURTH)) || bi_key.is_spell_book();
+        if (IS_FLG(FLG_WEAPONS)) {
+            can_match &= bi_key.is_weapon();
+        } else if (IS_FLG(FLG_FAVORITE_WEAPONS)) {
+            rule.depends_on_player = true;
+        } else if (IS_FLG(FLG_ARMORS)) {
+            can_match &= bi_key.is_protector();
+        } else if (IS_FLG(FLG_MISSILES)) {
+            can_match &= bi_key.is_ammo();
+        } else if (IS_FLG(FLG_DEVICES)) {
+            can_match &= (tval == ItemKindType::SCROLL) || (tval == ItemKindType::STAFF) || (tval == ItemKindType::WAND) || (tval == ItemKindType::ROD);
+        } else if (IS_FLG(FLG_LIGHTS)) {
+            can_match &= tval == ItemKindType::LITE;
+        } else if (IS_FLG(FLG_JUNKS)) {
+            can_match &= (tval == ItemKindType::SKELETON) || (tval == ItemKindType::BOTTLE) || (tval == ItemKindType::JUNK) || (tval == ItemKindType::STATUE);
+        } else if (IS_FLG(FLG_CORPSES)) {
+            can_match &= (tval == ItemKindType::CORPSE) || (tval == ItemKindType::SKELETON);
+        } else if (IS_FLG(FLG_SPELLBOOKS)) {
+            can_match &= bi_key.is_spell_book();
+        } else if (IS_FLG(FLG_HAFTED)) {
+            can_match &= tval == ItemKindType::HAFTED;
+        } else if (IS_FLG(FLG_SHIELDS)) {
+            can_match &= tval == ItemKindType::SHIELD;
+        } else if (IS_FLG(FLG_BOWS)) {
+            can_match &= tval == ItemKindType::BOW;
+        } else if (IS_FLG(FLG_RINGS)) {
+            can_match &= tval == ItemKindType::RING;
+        } else if (IS_FLG(FLG_AMULETS)) {
+            can_match &= tval == ItemKindType::AMULET;
+        } else if (IS_FLG(FLG_SUITS)) {
+            can_match &= bi_key.is_armour();
+        } else if (IS_FLG(FLG_CLOAKS)) {
+            can_match &= tval == ItemKindType::CLOAK;
+        } else if (IS_FLG(FLG_HELMS)) {
+            can_match &= (tval == ItemKindType::CROWN) || (tval == ItemKindType::HELM);
+        } else if (IS_FLG(FLG_GLOVES)) {
+            can_match &= tval == ItemKindType::GLOVES;
+        } else if (IS_FLG(FLG_BOOTS)) {
+            can_match &= tval == ItemKindType::BOOTS;
+        }
+
+        rule.tvals.set(i, can_match);
+    }
+
+    return rule;
+}
+
+/*!
+ * @brief 一致結果のキャッシュに用いるアイテムの状態を取り出す
+ * @param item 調べるアイテム
+ * @return アイテムの状態
+ * @details 耐性の略記や素朴な記述のオプションを切り替えるとアイテム名が変わるため、それらも含める
+ */
+AutopickItemState AutopickRuleIndex::make_item_state(const ItemEntity &item)
+{
+    AutopickItemState state{};
+    state.describe_options = (plain_descriptions ? 0x01 : 0) | (abbrev_extra ? 0x02 : 0) | (abbrev_all ? 0x04 : 0);
+    state.bi_id = item.bi_id;
+    state.ident = item.ident;
+    state.feeling = item.feeling;
+    state.is_aware = item.is_aware();
+    state.is_tried = item.is_tried();
+    state.inscription = item.inscription;
+    state.art_name = item.art_name;
+    state.pval = item.pval;
+    state.number = item.number;
+    state.timeout = item.timeout;
+    state.fuel = item.fuel;
+    state.discount = item.discount;
+    state.dd = item.dd;
+    state.ds = item.ds;
+    state.to_h = item.to_h;
+    state.to_d = item.to_d;
+    state.to_a = item.to_a;
+    state.ac = item.ac;
+    state.ego_idx = enum2i(item.ego_idx);
+    state.fixed_artifact_idx = enum2i(item.fixed_artifact_idx);
+    state.smith_hit = item.smith_hit;
+    state.smith_damage = item.smith_damage;
+    state.art_flags = item.art_flags;
+    state.curse_flags = item.curse_flags;
+    return state;
+}
+
+/*!
+ * @brief アイテム名の記述がプレイヤーの状態によって変わるかを返す
+ * @param item 調べるアイテム
+ * @return 変わるならtrue
+ * @details
+ * 射撃武器の射撃速度、装備中の射撃武器に合う矢弾の期待ダメージ、忍者の鉄の楔及び騎乗中のランスのダイスは
+ * プレイヤーの能力や装備から計算されるため、アイテムの状態だけではキャッシュの鮮度を判定できない
+ */
+bool AutopickRuleIndex::describes_player_state(const ItemEntity &item)
+{
+    switch (item.bi_key.tval()) {
+    case ItemKindType::BOW:
+    case ItemKindType::SHOT:
+    case ItemKindType::ARROW:
+    case ItemKindType::BOLT:
+    case ItemKindType::SPIKE:
+        return true;
+    default:
+        return item.is_lance();
+    }
+}
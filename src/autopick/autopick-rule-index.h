@@ -0,0 +1,115 @@
+﻿#pragma once
+
+#include "object-enchant/tr-flags.h"
+#include "object-enchant/trc-types.h"
+#include "object/tval-types.h"
+#include "system/angband.h"
+#include "util/enum-converter.h"
+#include "util/flag-group.h"
+#include <array>
+#include <bitset>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+/*!
+ * @brief 自動拾いの一致判定キャッシュに用いるアイテムの状態
+ * @details アイテム名の記述と鑑定状態を左右する値だけを保持する. 記述を変えるオプションの値も含める
+ */
+struct AutopickItemState {
+    byte describe_options;
+    short bi_id;
+    byte ident;
+    byte feeling;
+    bool is_aware;
+    bool is_tried;
+    uint16_t inscription;
+    uint16_t art_name;
+    PARAMETER_VALUE pval;
+    ITEM_NUMBER number;
+    TIME_EFFECT timeout;
+    short fuel;
+    byte discount;
+    DICE_NUMBER dd;
+    DICE_SID ds;
+    HIT_PROB to_h;
+    int to_d;
+    ARMOUR_CLASS to_a;
+    ARMOUR_CLASS ac;
+    int ego_idx;
+    short fixed_artifact_idx;
+    byte smith_hit;
+    byte smith_damage;
+    TrFlags art_flags;
+    EnumClassFlagGroup<CurseTraitType> curse_flags;
+
+    bool operator==(const AutopickItemState &other) const;
+};
+
+class ItemEntity;
+class PlayerType;
+struct autopick_type;
+
+/*!
+ * @brief 自動拾いリストをコンパイルした検索索引
+ * @details
+ * 各行が一致し得るtvalの候補表と、行の文字列部分を一括照合するAho-Corasickオートマトンを持つ.
+ * 一致結果はアイテム毎にキャッシュし、鑑定状態や名前が変わるまで再利用する.
+ * 自動拾いリストを書き換えたらinvalidate()を呼ぶこと.
+ */
+class AutopickRuleIndex {
+public:
+    AutopickRuleIndex(const AutopickRuleIndex &) = delete;
+    AutopickRuleIndex(AutopickRuleIndex &&) = delete;
+    AutopickRuleIndex &operator=(const AutopickRuleIndex &) = delete;
+    AutopickRuleIndex &operator=(AutopickRuleIndex &&) = delete;
+    static AutopickRuleIndex &get_instance();
+
+    void invalidate();
+    std::optional<int> find_cached(const ItemEntity &item);
+    int find_match(PlayerType *player_ptr, ItemEntity *o_ptr, concptr o_name);
+
+private:
+    AutopickRuleIndex() = default;
+
+    static constexpr auto ITEM_KIND_TYPE_NUM = enum2i(ItemKindType::GOLD) + 1;
+    static constexpr size_t ITEM_CACHE_MAX = 4096;
+
+    struct CompiledRule {
+        std::bitset<ITEM_KIND_TYPE_NUM> tvals; /*!< 一致し得るtvalの集合 */
+        bool depends_on_player; /*!< プレイヤーや周囲の状態で結果が変わるか */
+        bool has_substring; /*!< 部分一致の照合が必要か (空文字列と前方一致は含まない) */
+    };
+
+    struct PatternNode {
+        std::vector<std::pair<char, int>> children;
+        int fail = 0;
+        int output = -1; /*!< 失敗リンクを辿って最初に見つかる、一致パターンを持つノード */
+        std::vector<int> rule_indices;
+    };
+
+    struct ItemMatchCache {
+        AutopickItemState state;
+        int rule_idx;
+    };
+
+    bool is_compiled = false;
+    size_t compiled_size = 0;
+    std::vector<CompiledRule> rules;
+    std::array<std::optional<std::vector<int>>, ITEM_KIND_TYPE_NUM> candidates;
+    std::vector<PatternNode> nodes;
+    std::vector<uint32_t> matched_stamps;
+    uint32_t match_stamp = 0;
+    std::unordered_map<const ItemEntity *, ItemMatchCache> item_caches;
+
+    void compile();
+    void compile_patterns();
+    const std::vector<int> &get_candidates(ItemKindType tval);
+    int find_child(int node, char c) const;
+    void match_patterns(concptr o_name);
+    bool is_name_candidate(int rule_idx) const;
+
+    static CompiledRule compile_rule(const autopick_type &entry);
+    static AutopickItemState make_item_state(const ItemEntity &item);
+    static bool describes_player_state(const ItemEntity &item);
+};
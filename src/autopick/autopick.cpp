@@ -70,8 +70,8 @@ void autopick_delayed_alter(PlayerType *player_ptr)
         autopick_delayed_alter_aux(player_ptr, item);
     }
 
-    auto &grid = player_ptr->current_floor_ptr->grid_array[player_ptr->y][player_ptr->x];
-    for (auto it = grid.o_idx_list.begin(); it != grid.o_idx_list.end();) {
+    auto &o_idx_list = player_ptr->current_floor_ptr->grid_array.o_idx_list(player_ptr->y, player_ptr->x);
+    for (auto it = o_idx_list.begin(); it != o_idx_list.end();) {
         INVENTORY_IDX item = *it++;
         autopick_delayed_alter_aux(player_ptr, -item);
     }
@@ -102,7 +102,8 @@ void autopick_alter_item(PlayerType *player_ptr, INVENTORY_IDX item, bool destro
  */
 void autopick_pickup_items(PlayerType *player_ptr, grid_type *g_ptr)
 {
-    for (auto it = g_ptr->o_idx_list.begin(); it != g_ptr->o_idx_list.end();) {
+    auto &o_idx_list = player_ptr->current_floor_ptr->grid_array.o_idx_list(g_ptr);
+    for (auto it = o_idx_list.begin(); it != o_idx_list.end();) {
         OBJECT_IDX this_o_idx = *it++;
         auto *o_ptr = &player_ptr->current_floor_ptr->o_list[this_o_idx];
         int idx = find_autopick_list(player_ptr, o_ptr);
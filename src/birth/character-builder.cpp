@@ -16,6 +16,7 @@
 #include "birth/birth-wizard.h"
 #include "birth/game-play-initializer.h"
 #include "birth/quick-start.h"
+#include "core/game-simulator.h"
 #include "core/window-redrawer.h"
 #include "floor/floor-town.h"
 #include "floor/wild.h"
@@ -92,7 +93,9 @@ void player_birth(PlayerType *player_ptr)
     w_ptr->play_time = 0;
     wipe_monsters_list(player_ptr);
     player_wipe_without_name(player_ptr);
-    if (!ask_quick_start(player_ptr)) {
+    if (is_simulating()) {
+        roll_simulated_character(player_ptr);
+    } else if (!ask_quick_start(player_ptr)) {
         play_music(TERM_XTRA_MUSIC_BASIC, MUSIC_BASIC_NEW_GAME);
         while (true) {
             if (player_birth_wizard(player_ptr)) {
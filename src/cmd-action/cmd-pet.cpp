@@ -30,6 +30,7 @@
 #include "monster/monster-describer.h"
 #include "monster/monster-description-types.h"
 #include "monster/monster-info.h"
+#include "monster/monster-processor.h"
 #include "monster/monster-status-setter.h"
 #include "monster/monster-status.h"
 #include "monster/smart-learn-types.h"
@@ -79,7 +80,6 @@ void do_cmd_pet_dismiss(PlayerType *player_ptr)
     bool all_pets = false;
     int Dismissed = 0;
 
-    uint16_t dummy_why;
     bool cu, cv;
 
     cu = game_term->scr->cu;
@@ -98,7 +98,7 @@ void do_cmd_pet_dismiss(PlayerType *player_ptr)
         }
     }
 
-    ang_sort(player_ptr, who.data(), &dummy_why, who.size(), ang_sort_comp_pet_dismiss, ang_sort_swap_hook);
+    ang_sort(who, [player_ptr](auto m_idx1, auto m_idx2) { return ang_sort_comp_pet_dismiss(player_ptr, m_idx1, m_idx2); });
 
     /* Process the monsters (backwards) */
     for (auto i = 0U; i < who.size(); i++) {
@@ -294,7 +294,9 @@ bool do_cmd_riding(PlayerType *player_ptr, bool force)
             set_action(player_ptr, ACTION_NONE);
         }
 
+        settle_monster_energy(player_ptr, g_ptr->m_idx);
         player_ptr->riding = g_ptr->m_idx;
+        reschedule_monster(player_ptr, g_ptr->m_idx);
 
         /* Hack -- remove tracked monster */
         if (player_ptr->riding == player_ptr->health_who) {
@@ -154,7 +154,7 @@ void do_cmd_query_symbol(PlayerType *player_ptr)
     query = inkey();
     prt(buf, 0, 0);
     why = 2;
-    ang_sort(player_ptr, who.data(), &why, who.size(), ang_sort_comp_hook, ang_sort_swap_hook);
+    ang_sort(who, [why](auto r_idx1, auto r_idx2) { return ang_sort_comp_hook(r_idx1, r_idx2, why); });
     if (query == 'k') {
         why = 4;
         query = 'y';
@@ -165,7 +165,7 @@ void do_cmd_query_symbol(PlayerType *player_ptr)
     }
 
     if (why == 4) {
-        ang_sort(player_ptr, who.data(), &why, who.size(), ang_sort_comp_hook, ang_sort_swap_hook);
+        ang_sort(who, [why](auto r_idx1, auto r_idx2) { return ang_sort_comp_hook(r_idx1, r_idx2, why); });
     }
 
     auto i = who.size() - 1;
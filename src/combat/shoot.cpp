@@ -66,6 +66,7 @@
 #include "target/projection-path-calculator.h"
 #include "target/target-checker.h"
 #include "target/target-getter.h"
+#include "term/animation-scheduler.h"
 #include "timed-effect/player-hallucination.h"
 #include "timed-effect/timed-effects.h"
 #include "util/bit-flags-calculator.h"
@@ -699,10 +700,8 @@ void exe_fire(PlayerType *player_ptr, INVENTORY_IDX item, ItemEntity *j_ptr, SPE
                 if (delay_factor > 0) {
                     print_rel(player_ptr, c, a, ny, nx);
                     move_cursor_relative(ny, nx);
-                    term_fresh();
-                    term_xtra(TERM_XTRA_DELAY, delay_factor);
+                    AnimationScheduler::get_instance().present_frame(delay_factor);
                     lite_spot(player_ptr, ny, nx);
-                    term_fresh();
                 }
             }
 
@@ -710,7 +709,7 @@ void exe_fire(PlayerType *player_ptr, INVENTORY_IDX item, ItemEntity *j_ptr, SPE
             else {
                 /* Pause anyway, for consistancy **/
                 if (delay_factor > 0) {
-                    term_xtra(TERM_XTRA_DELAY, delay_factor);
+                    AnimationScheduler::get_instance().present_frame(delay_factor);
                 }
             }
 
@@ -919,14 +918,14 @@ void exe_fire(PlayerType *player_ptr, INVENTORY_IDX item, ItemEntity *j_ptr, SPE
 
                                 m_ptr->fx = nx;
                                 m_ptr->fy = ny;
+                                player_ptr->current_floor_ptr->m_spatial_index.place(m_idx, ny, nx);
 
                                 update_monster(player_ptr, m_idx, true);
 
                                 if (delay_factor > 0) {
                                     lite_spot(player_ptr, ny, nx);
                                     lite_spot(player_ptr, oy, ox);
-                                    term_fresh();
-                                    term_xtra(TERM_XTRA_DELAY, delay_factor);
+                                    AnimationScheduler::get_instance().present_frame(delay_factor);
                                 }
 
                                 x = nx;
@@ -949,6 +948,8 @@ void exe_fire(PlayerType *player_ptr, INVENTORY_IDX item, ItemEntity *j_ptr, SPE
             }
         }
 
+        AnimationScheduler::get_instance().finish();
+
         /* Chance of breakage (during attacks) */
         auto j = (hit_body ? breakage_chance(player_ptr, q_ptr, PlayerClass(player_ptr).equals(PlayerClassType::ARCHER), snipe_type) : 0);
 
@@ -17,8 +17,10 @@
 #include "cmd-io/cmd-gameoption.h"
 #include "core/asking-player.h"
 #include "core/game-closer.h"
+#include "core/game-simulator.h"
 #include "core/player-processor.h"
 #include "core/player-update-types.h"
+#include "core/profiler.h"
 #include "core/score-util.h"
 #include "core/scores.h"
 #include "core/speed-table.h"
@@ -168,7 +170,9 @@ static void init_random_seed(PlayerType *player_ptr, bool new_game)
         process_player_name(player_ptr);
     }
 
-    if (init_random_seed) {
+    if (is_simulating()) {
+        seed_simulation();
+    } else if (init_random_seed) {
         Rand_state_init();
     }
 }
@@ -382,7 +386,11 @@ static void process_game_turn(PlayerType *player_ptr)
             break;
         }
 
+        ProfileScope profile_scope(ProfileSection::FLOOR_CHANGE);
         change_floor(player_ptr);
+        if (is_simulating()) {
+            count_simulated_floor();
+        }
     }
 }
 
@@ -440,6 +448,13 @@ void play_game(PlayerType *player_ptr, bool new_game, bool browsing_movie)
     (void)combine_and_reorder_home(player_ptr, StoreSaleType::HOME);
     (void)combine_and_reorder_home(player_ptr, StoreSaleType::MUSEUM);
     select_floor_music(player_ptr);
+    if (is_simulating()) {
+        begin_simulation(player_ptr);
+        process_game_turn(player_ptr);
+        finish_simulation(player_ptr);
+        return;
+    }
+
     process_game_turn(player_ptr);
     close_game(player_ptr);
     quit(nullptr);
@@ -0,0 +1,413 @@
+﻿/*
+ * @file game-simulator.cpp
+ * @brief 端末無しでゲームを自動進行させるシミュレーションモード
+ * @details
+ * 画面出力を捨てる仮想端末を用意し、キー入力をスクリプトまたは乱数で供給して
+ * process_dungeon() を回し続ける。一定のゲームターンを進めたらゲームターン毎秒、
+ * フロア生成回数及び処理区分毎の経過時間を標準出力へ報告する。
+ * 指定があれば、最後のフロアにモンスターを詰め込んで update_monsters() の直列と並列の速度も比べる。
+ * シードが同じであれば同じ入力列・同じゲーム展開となるため、性能の回帰試験に用いる。
+ */
+
+#include "core/game-simulator.h"
+#include "avatar/avatar.h"
+#include "birth/birth-body-spec.h"
+#include "birth/birth-stat.h"
+#include "birth/game-play-initializer.h"
+#include "birth/history-generator.h"
+#include "core/player-update-types.h"
+#include "core/profiler.h"
+#include "floor/floor-connectivity.h"
+#include "floor/floor-save.h"
+#include "floor/floor-speculator.h"
+#include "game-option/cheat-options.h"
+#include "game-option/special-options.h"
+#include "main/info-initializer.h"
+#include "monster-floor/monster-generator.h"
+#include "monster-floor/monster-remover.h"
+#include "monster-floor/monster-summon.h"
+#include "monster-floor/place-monster-types.h"
+#include "monster/monster-update.h"
+#include "player-ability/player-ability-types.h"
+#include "player-base/player-class.h"
+#include "player-info/class-info.h"
+#include "player-info/race-info.h"
+#include "player-info/race-types.h"
+#include "player/patron.h"
+#include "player/player-personality-types.h"
+#include "player/player-personality.h"
+#include "player/player-sex.h"
+#include "player/player-status.h"
+#include "player/race-info-table.h"
+#include "save/floor-writer.h"
+#include "system/dungeon-info.h"
+#include "system/floor-type-definition.h"
+#include "system/player-type-definition.h"
+#include "term/gameterm.h"
+#include "term/z-term.h"
+#include "util/enum-converter.h"
+#include "util/int-char-converter.h"
+#include "util/rng-xoshiro.h"
+#include "util/string-processor.h"
+#include "util/worker-pool.h"
+#include "wizard/wizard-special-process.h"
+#include "world/world.h"
+#include <algorithm>
+#include <array>
+#include <cstdio>
+#include <limits>
+#include <string_view>
+
+namespace {
+
+constexpr auto HEADLESS_TERM_WIDTH = 80;
+constexpr auto HEADLESS_TERM_HEIGHT = 24;
+constexpr auto HEADLESS_KEY_QUEUE_SIZE = 256;
+constexpr auto SIMULATION_MAX_DEPTH = 50; //!< 階層移動で選ぶ最大の階層
+constexpr std::string_view RANDOM_MOVE_KEYS = "12346789";
+constexpr auto CROWD_MIN_SIZE = 32; //!< update_monsters() を計測する最初のモンスター数
+constexpr auto CROWD_ROUNDS = 5; //!< update_monsters() の直列と並列を交互に計測する回数 (最速の回を採る)
+constexpr auto CROWD_ITERATIONS = 50; //!< 1回の計測で update_monsters() を呼ぶ回数
+constexpr std::string_view STOP_KEYS = "\033ay"; //!< 終了後に与えるキー列 (ESCで抜けられない能力値の選択にも答える)
+
+SimulationOptions simulation_options;
+std::string simulation_keys; //!< 制御文字等を展開したキー列
+size_t simulation_key_index = 0;
+Xoshiro128StarStar input_rng; //!< ゲーム本体の乱数とは独立した入力用の乱数
+term_type headless_term;
+
+bool simulating = false;
+bool measuring = false;
+bool stop_requested = false;
+size_t stop_key_index = 0;
+int64_t start_turn = 0;
+int64_t end_turn = 0;
+int64_t start_time_ns = 0;
+int64_t init_time_ns = 0; //!< シミュレーションモードを初期化した時刻
+int key_count = 0;
+int floor_count = 0; //!< 計測開始から生成・移動したフロアの数
+int verified_floor_count = 0; //!< 保存後に読み戻して検査したフロアの数
+int broken_floor_count = 0; //!< 読み戻した内容が一致しなかったフロアの数
+
+/*!
+ * @brief 乱数で次の入力キーを決める
+ * @details 大半はプレイヤーの移動で、階段があれば昇降する。
+ * レベル10毎の能力値上昇の選択で止まらないよう、選択肢 (a～f) と確認の y も時々与える
+ */
+char decide_random_key()
+{
+    const auto roll = input_rng() % 100;
+    if (roll < 88) {
+        return RANDOM_MOVE_KEYS[input_rng() % RANDOM_MOVE_KEYS.length()];
+    }
+
+    if (roll < 93) {
+        return '>';
+    }
+
+    if (roll < 96) {
+        return '<';
+    }
+
+    if (roll < 97) {
+        return static_cast<char>('a' + input_rng() % A_MAX);
+    }
+
+    if (roll < 98) {
+        return 'y';
+    }
+
+    return ESCAPE;
+}
+
+/*!
+ * @brief ゲームが入力を待っている時に与えるキーを決める
+ * @details
+ * 規定のゲームターンに達したらゲームを終了させ、以降は全てのプロンプトを STOP_KEYS で抜ける。
+ * また一定回数の入力毎にランダムな階層へ移動してフロア生成を発生させる。
+ * ダンジョン内にいれば半分は階段を下りた時と同じく1つ下の階層へ移動し、先読みしたフロアへの差し替えも発生させる。
+ */
+char next_simulated_key()
+{
+    if (!measuring) {
+        return ESCAPE;
+    }
+
+    if (!stop_requested && (static_cast<int64_t>(w_ptr->game_turn) >= end_turn)) {
+        stop_requested = true;
+        p_ptr->playing = false;
+        p_ptr->leaving = true;
+    }
+
+    if (stop_requested) {
+        const auto key = STOP_KEYS[stop_key_index];
+        stop_key_index = (stop_key_index + 1) % STOP_KEYS.length();
+        return key;
+    }
+
+    key_count++;
+    if ((simulation_options.floor_interval > 0) && (key_count % simulation_options.floor_interval == 0) && !p_ptr->leaving) {
+        auto depth = static_cast<DEPTH>(1 + input_rng() % SIMULATION_MAX_DEPTH);
+        const auto dun_level = p_ptr->current_floor_ptr->dun_level;
+        if ((input_rng() % 2 == 0) && (dun_level > 0) && (dun_level < SIMULATION_MAX_DEPTH)) {
+            depth = dun_level + 1;
+        }
+
+        wiz_jump_floor(p_ptr, DUNGEON_ANGBAND, depth);
+        return ESCAPE;
+    }
+
+    if (simulation_keys.empty()) {
+        return decide_random_key();
+    }
+
+    const auto key = simulation_keys[simulation_key_index];
+    simulation_key_index = (simulation_key_index + 1) % simulation_keys.length();
+    return key;
+}
+
+/*!
+ * @brief update_monsters() を繰り返し呼び、1回あたりの時間を計る
+ * @param player_ptr プレイヤーへの参照ポインタ
+ * @param mode 感知判定の進め方
+ * @return 1回あたりの時間 (マイクロ秒)
+ */
+double time_update_monsters(PlayerType *player_ptr, UpdateMonstersMode mode)
+{
+    const auto start_ns = Profiler::now_ns();
+    for (auto i = 0; i < CROWD_ITERATIONS; i++) {
+        update_monsters(player_ptr, true, mode);
+    }
+
+    return (Profiler::now_ns() - start_ns) / 1000.0 / CROWD_ITERATIONS;
+}
+
+/*!
+ * @brief 最後のフロアにモンスターを段階的に詰め込み、update_monsters() の直列と並列の速度を報告する
+ * @param player_ptr プレイヤーへの参照ポインタ
+ * @details
+ * 元からいたモンスターを消してから、通常のフロア生成と同じ alloc_monster() でゲーム本体の乱数から配置するため、
+ * シード・ターン数・階層移動の間隔が同じなら同じ配置で計測できる.
+ * 並列の列は UpdateMonstersMode::PARALLEL で、数に関わらずスレッドプールを使った時の時間である.
+ * 他のプロセスによる揺らぎを減らすため、直列と並列を交互に計測してそれぞれ最速の回を報告する.
+ */
+void benchmark_crowded_floor(PlayerType *player_ptr)
+{
+    auto *floor_ptr = player_ptr->current_floor_ptr;
+    const auto max_size = simulation_options.crowd_size;
+    wipe_monsters_list(player_ptr);
+    printf("  update_monsters() on dlvl %d, %d threads in the pool (incl. caller), best us/call of %dx%d calls:\n", floor_ptr->dun_level, WorkerPool::get_instance().get_thread_num(), CROWD_ROUNDS, CROWD_ITERATIONS);
+    printf("  %10s %10s %10s %7s\n", "monsters", "serial", "pool", "ratio");
+    for (auto size = CROWD_MIN_SIZE;; size *= 2) {
+        const auto target = std::min(size, max_size);
+        for (auto attempts = target * 10; (floor_ptr->m_cnt < target) && (attempts > 0); attempts--) {
+            (void)alloc_monster(player_ptr, 0, PM_ALLOW_SLEEP, summon_specific);
+        }
+
+        update_monsters(player_ptr, true);
+        auto serial_us = std::numeric_limits<double>::max();
+        auto pool_us = std::numeric_limits<double>::max();
+        for (auto round = 0; round < CROWD_ROUNDS; round++) {
+            serial_us = std::min(serial_us, time_update_monsters(player_ptr, UpdateMonstersMode::SERIAL));
+            pool_us = std::min(pool_us, time_update_monsters(player_ptr, UpdateMonstersMode::PARALLEL));
+        }
+
+        printf("  %10d %10.1f %10.1f %7.2f\n", floor_ptr->m_cnt, serial_us, pool_us, pool_us > 0 ? serial_us / pool_us : 0.0);
+        if (target >= max_size) {
+            break;
+        }
+    }
+}
+
+/*!
+ * @brief 仮想端末の特殊処理フック
+ * @details 入力待ち要求にはシミュレーション用のキーを与え、それ以外の要求 (遅延、効果音等) は全て無視する
+ */
+errr term_xtra_headless(int n, int v)
+{
+    if ((n == TERM_XTRA_EVENT) && v) {
+        term_key_push(next_simulated_key());
+    }
+
+    return 0;
+}
+
+}
+
+/*!
+ * @brief シミュレーションモードを初期化し、画面出力を捨てる仮想端末をメイン端末にする
+ * @param options シミュレーションの設定
+ */
+void init_simulation(const SimulationOptions &options)
+{
+    init_time_ns = Profiler::now_ns();
+    simulation_options = options;
+    if (!options.keys.empty()) {
+        char buf[1024];
+        text_to_ascii(buf, options.keys, sizeof(buf));
+        simulation_keys = buf;
+    }
+
+    input_rng.set_state(options.seed);
+    term_init(&headless_term, HEADLESS_TERM_WIDTH, HEADLESS_TERM_HEIGHT, HEADLESS_KEY_QUEUE_SIZE);
+    headless_term.xtra_hook = term_xtra_headless;
+    headless_term.never_bored = true;
+    angband_terms[0] = &headless_term;
+    term_activate(&headless_term);
+    simulating = true;
+}
+
+/*!
+ * @brief シミュレーションモードで動作中かを返す
+ */
+bool is_simulating()
+{
+    return simulating;
+}
+
+/*!
+ * @brief ゲーム本体の乱数をシミュレーションのシードで初期化する
+ */
+void seed_simulation()
+{
+    w_ptr->rng.set_state(simulation_options.seed);
+}
+
+/*!
+ * @brief キャラクター作成画面を経ずに、シードから人間の戦士を作成する
+ * @param player_ptr プレイヤーへの参照ポインタ
+ * @details 能力値等の決め方はキャラクター作成ウィザードと同じ
+ */
+void roll_simulated_character(PlayerType *player_ptr)
+{
+    player_ptr->psex = SEX_MALE;
+    player_ptr->prace = PlayerRaceType::HUMAN;
+    player_ptr->pclass = PlayerClassType::WARRIOR;
+    player_ptr->ppersonality = PERSONALITY_ORDINARY;
+    sp_ptr = &sex_info[player_ptr->psex];
+    rp_ptr = &race_info[enum2i(player_ptr->prace)];
+    cp_ptr = &class_info[enum2i(player_ptr->pclass)];
+    mp_ptr = &class_magics_info[enum2i(player_ptr->pclass)];
+    ap_ptr = &personality_info[player_ptr->ppersonality];
+    PlayerClass(player_ptr).init_specific_data();
+
+    init_turn(player_ptr);
+    get_stats(player_ptr);
+    get_ahw(player_ptr);
+    get_history(player_ptr);
+    get_extra(player_ptr, true);
+    get_money(player_ptr);
+    player_ptr->chaos_patron = (int16_t)randint0(MAX_PATRON);
+    player_ptr->update |= (PU_BONUS | PU_HP);
+    update_creature(player_ptr);
+    player_ptr->chp = player_ptr->mhp;
+    player_ptr->csp = player_ptr->msp;
+    get_max_stats(player_ptr);
+    initialize_virtues(player_ptr);
+    init_dungeon_quests(player_ptr);
+}
+
+/*!
+ * @brief 計測を開始する
+ * @param player_ptr プレイヤーへの参照ポインタ
+ * @details 途中で死亡やセーブが起きないようにしてから、ゲームターンの上限を決める
+ */
+void begin_simulation(PlayerType *player_ptr)
+{
+    (void)player_ptr;
+    cheat_immortal = true;
+    autosave_l = false;
+    autosave_t = false;
+    start_turn = w_ptr->game_turn;
+    end_turn = start_turn + simulation_options.turns;
+    auto &profiler = Profiler::get_instance();
+    profiler.reset();
+    profiler.set_enabled(true);
+    start_time_ns = Profiler::now_ns();
+    floor_count = 0;
+    verified_floor_count = 0;
+    broken_floor_count = 0;
+    measuring = true;
+}
+
+/*!
+ * @brief フロアの生成・移動を1回数える
+ * @details プロファイラの有無に関わらずフロア生成の速度を報告できるよう、シミュレーション側で数える
+ */
+void count_simulated_floor()
+{
+    if (measuring) {
+        floor_count++;
+    }
+}
+
+/*!
+ * @brief 指定があれば、離れるフロアを保存して読み戻し、一致するかを検査する
+ * @param player_ptr プレイヤーへの参照ポインタ
+ * @details 一致しなければ、その場で標準エラー出力へ報告する
+ */
+void verify_simulated_floor_save(PlayerType *player_ptr)
+{
+    if (!measuring || !simulation_options.verify_floors) {
+        return;
+    }
+
+    verified_floor_count++;
+    if (verify_floor_round_trip(player_ptr)) {
+        return;
+    }
+
+    broken_floor_count++;
+    fprintf(stderr, "Floor (dlvl %d) did not round-trip through a saved floor file at game turn %d\n", player_ptr->current_floor_ptr->dun_level, w_ptr->game_turn);
+}
+
+/*!
+ * @brief 計測を終了し、結果を標準出力へ報告する
+ * @param player_ptr プレイヤーへの参照ポインタ
+ * @details
+ * 起動時間はゲームデータの読み込みからキャラクター作成、最初のフロア生成までを含む.
+ * 定義ファイル毎の読み込み時間は並列に読み込んだ各ファイルの所要時間で、合計は起動時間より長くなりうる.
+ * 処理区分毎の時間はプロファイラの集計値で、USE_PROFILER が無効なビルドでは報告しない
+ */
+void finish_simulation(PlayerType *player_ptr)
+{
+    const auto elapsed = (Profiler::now_ns() - start_time_ns) / 1e9;
+    measuring = false;
+    auto &profiler = Profiler::get_instance();
+    profiler.set_enabled(false);
+    clear_saved_floor_files(player_ptr);
+
+    const auto turns = static_cast<int64_t>(w_ptr->game_turn) - start_turn;
+    printf("Simulation finished (seed %u, %s input)\n", simulation_options.seed, simulation_keys.empty() ? "random" : "scripted");
+    printf("  startup    : %.3f s\n", (start_time_ns - init_time_ns) / 1e9);
+    for (const auto &load_time : get_info_load_times()) {
+        printf("    %-28s %7.3f s%s\n", load_time.filename.data(), load_time.time_ns / 1e9, load_time.is_cached ? " (cache)" : "");
+    }
+
+    printf("  game turns : %lld in %.3f s (%.1f turns/sec)\n", static_cast<long long>(turns), elapsed, elapsed > 0 ? turns / elapsed : 0.0);
+    printf("  key inputs : %d\n", key_count);
+    printf("  floors     : %d generated (%.2f floors/sec)\n", floor_count, elapsed > 0 ? floor_count / elapsed : 0.0);
+    if (simulation_options.verify_floors) {
+        printf("  saved floors: %d read back and compared, %d mismatched\n", verified_floor_count, broken_floor_count);
+    }
+
+    printf("  final state: clvl %d, dlvl %d, exp %d\n", player_ptr->lev, player_ptr->current_floor_ptr->dun_level, player_ptr->exp);
+    const auto &connectivity = get_floor_connectivity_stats();
+    printf("  connectivity: %d floors checked, %d repaired in place, %d permanent walls opened\n", connectivity.checked_floors, connectivity.repaired_floors, connectivity.opened_grids);
+    const auto &speculation = get_floor_speculation_stats();
+    printf("  speculation: %d floors built ahead, %d used, %d discarded\n", speculation.built_floors, speculation.used_floors, speculation.discarded_floors);
+#ifdef USE_PROFILER
+    const auto &totals = profiler.get_totals();
+    printf("  %-16s %10s %7s %10s\n", "section", "time (s)", "share", "calls");
+    for (auto i = 0; i < enum2i(ProfileSection::MAX); i++) {
+        const auto section_time = totals[i].time_ns / 1e9;
+        const auto name = Profiler::get_name(i2enum<ProfileSection>(i));
+        printf("  %-16s %10.3f %6.1f%% %10d\n", name.data(), section_time, elapsed > 0 ? section_time * 100 / elapsed : 0.0, totals[i].calls);
+    }
+#else
+    printf("  (per-section times are not available: configure with --enable-profiler)\n");
+#endif
+    if (simulation_options.crowd_size > 0) {
+        benchmark_crowded_floor(player_ptr);
+    }
+}
@@ -0,0 +1,31 @@
+﻿#pragma once
+
+/*
+ * @file game-simulator.h
+ * @brief 端末無しでゲームを自動進行させるシミュレーションモードのヘッダ
+ */
+
+#include "system/angband.h"
+#include <string>
+
+/*!
+ * @brief シミュレーションモードの設定
+ */
+struct SimulationOptions {
+    uint32_t seed = 0; //!< ゲーム本体及び入力の乱数シード
+    int32_t turns = 100000; //!< 進行させるゲームターン数
+    int floor_interval = 500; //!< 別の階層へ移動するまでのキー入力回数 (0なら自発的には移動しない)
+    std::string keys; //!< 繰り返し入力するキー列 (空ならランダムに入力する)
+    bool verify_floors = false; //!< フロアを保存する度に読み戻して一致するか検査するか
+    int crowd_size = 0; //!< 終了後にモンスターを詰め込んで update_monsters() を計測する上限数 (0なら計測しない)
+};
+
+class PlayerType;
+void init_simulation(const SimulationOptions &options);
+bool is_simulating();
+void seed_simulation();
+void roll_simulated_character(PlayerType *player_ptr);
+void begin_simulation(PlayerType *player_ptr);
+void count_simulated_floor();
+void verify_simulated_floor_save(PlayerType *player_ptr);
+void finish_simulation(PlayerType *player_ptr);
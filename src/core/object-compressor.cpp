@@ -33,6 +33,7 @@ static void compact_objects_aux(FloorType *floor_ptr, OBJECT_IDX i1, OBJECT_IDX
     // 要素番号i1のオブジェクトを要素番号i2に移動
     floor_ptr->o_list[i2] = floor_ptr->o_list[i1];
     o_ptr->wipe();
+    floor_ptr->o_slots.release(i1);
 }
 
 /*!
@@ -50,6 +51,9 @@ static void compact_objects_aux(FloorType *floor_ptr, OBJECT_IDX i1, OBJECT_IDX
  *\n
  * After "compacting" (if needed), we "reorder" the objects into a more\n
  * compact order, and we reset the allocation info, and the "live" array.\n
+ *\n
+ * 削除で空いた要素は空きリストから再利用されるため、ゲーム中は番号を詰め直さない.\n
+ * 詰め直すのはセーブファイルへ書き出す前 (size == 0) のみ.\n
  */
 void compact_objects(PlayerType *player_ptr, int size)
 {
@@ -104,6 +108,10 @@ void compact_objects(PlayerType *player_ptr, int size)
         }
     }
 
+    if (size > 0) {
+        return;
+    }
+
     for (OBJECT_IDX i = floor_ptr->o_max - 1; i >= 1; i--) {
         o_ptr = &floor_ptr->o_list[i];
         if (o_ptr->bi_id) {
@@ -113,4 +121,6 @@ void compact_objects(PlayerType *player_ptr, int size)
         compact_objects_aux(floor_ptr, floor_ptr->o_max - 1, i);
         floor_ptr->o_max--;
     }
+
+    floor_ptr->o_slots.clear_free_slots();
 }
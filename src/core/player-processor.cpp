@@ -4,11 +4,13 @@
 #include "core/disturbance.h"
 #include "core/player-redraw-types.h"
 #include "core/player-update-types.h"
+#include "core/profiler.h"
 #include "core/special-internal-keys.h"
 #include "core/speed-table.h"
 #include "core/stuff-handler.h"
 #include "core/window-redrawer.h"
 #include "floor/floor-save-util.h"
+#include "floor/floor-speculator.h"
 #include "floor/floor-util.h"
 #include "floor/geometry.h"
 #include "floor/wild.h"
@@ -116,6 +118,7 @@ bool continuous_action_running(PlayerType *player_ptr)
  */
 void process_player(PlayerType *player_ptr)
 {
+    ProfileScope profile_scope(ProfileSection::PLAYER);
     if (player_ptr->hack_mutation) {
         msg_print(_("何か変わった気がする！", "You feel different!"));
         (void)gain_mutation(player_ptr, 0);
@@ -320,6 +323,7 @@ void process_player(PlayerType *player_ptr)
             window_stuff(player_ptr);
 
             can_save = true;
+            speculate_next_floor(player_ptr);
             InputKeyRequestor(player_ptr, false).request_command();
             can_save = false;
             process_command(player_ptr);
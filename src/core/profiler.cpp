@@ -0,0 +1,234 @@
+﻿/*
+ * @file profiler.cpp
+ * @brief サブシステム毎の処理時間を計測するプロファイラ
+ */
+
+#include "core/profiler.h"
+#include "util/angband-files.h"
+#include "util/enum-converter.h"
+#include <algorithm>
+#include <chrono>
+
+namespace {
+constexpr std::array<std::string_view, enum2i(ProfileSection::MAX)> SECTION_NAMES = {
+    "game_turn",
+    "player",
+    "monsters",
+    "world",
+    "update_view",
+    "update_mon_lite",
+    "update_flow",
+    "redraw_stuff",
+    "window_stuff",
+    "floor_change",
+};
+}
+
+Profiler &Profiler::get_instance()
+{
+    static Profiler instance;
+    return instance;
+}
+
+/*!
+ * @brief 処理区分の名前を返す
+ * @param section 処理区分
+ * @return CSVの列名にも使う英小文字の名前
+ */
+std::string_view Profiler::get_name(ProfileSection section)
+{
+    return SECTION_NAMES[enum2i(section)];
+}
+
+/*!
+ * @brief 計測に用いる単調増加の時刻を返す
+ * @return 時刻 (ナノ秒)
+ */
+int64_t Profiler::now_ns()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/*!
+ * @brief 計測の有効/無効を切り替える
+ * @param enabled 有効にするならtrue
+ * @details USE_PROFILER が定義されていないビルドでは常に無効のままとする
+ */
+void Profiler::set_enabled(bool enabled)
+{
+#ifdef USE_PROFILER
+    if (enabled && !this->enabled) {
+        this->current = {};
+        this->turn_time_ns = 0;
+    }
+
+    this->enabled = enabled;
+#else
+    (void)enabled;
+#endif
+}
+
+/*!
+ * @brief これまでの計測値を全て破棄する
+ */
+void Profiler::reset()
+{
+    this->current = {};
+    this->totals = {};
+    this->history_head = 0;
+    this->history_count = 0;
+    this->turn_time_ns = 0;
+}
+
+/*!
+ * @brief 処理区分の計測を始める
+ */
+void Profiler::enter()
+{
+    this->depth++;
+}
+
+/*!
+ * @brief 処理区分の計測を終え、集計中のゲームターンに経過時間を積算する
+ * @param section 処理区分
+ * @param time_ns 一時停止していた時間を除いた経過時間 (ナノ秒)
+ * @details 最も外側の処理区分の時間はゲームターン全体の時間にも積算する
+ */
+void Profiler::leave(ProfileSection section, int64_t time_ns)
+{
+    auto &record = this->current[enum2i(section)];
+    record.time_ns += time_ns;
+    record.calls++;
+    if (--this->depth == 0) {
+        this->turn_time_ns += time_ns;
+    }
+}
+
+/*!
+ * @brief 計測を一時停止する
+ * @details 入れ子で呼ばれた場合は最も外側の一時停止だけを数える
+ */
+void Profiler::pause()
+{
+    if (this->pause_depth++ == 0) {
+        this->pause_start_ns = now_ns();
+    }
+}
+
+/*!
+ * @brief 一時停止した計測を再開する
+ */
+void Profiler::resume()
+{
+    if (--this->pause_depth == 0) {
+        this->paused_ns += now_ns() - this->pause_start_ns;
+    }
+}
+
+/*!
+ * @brief 一時停止していた時間の累計を返す
+ * @return 累計時間 (ナノ秒)。一時停止中の場合、その分は含まない
+ */
+int64_t Profiler::get_paused_ns() const
+{
+    return this->paused_ns;
+}
+
+/*!
+ * @brief 1ゲームターン分の集計を締め、リングバッファに記録する
+ * @param game_turn 締めるゲームターン
+ * @details
+ * 最も外側の処理区分にかかった時間の合計をゲームターン全体の時間とする.
+ * 処理区分の外にある時間やキー入力待ちの時間は含まない.
+ */
+void Profiler::end_turn(GAME_TURN game_turn)
+{
+    if (!this->enabled) {
+        return;
+    }
+
+    auto &turn_record = this->current[enum2i(ProfileSection::GAME_TURN)];
+    turn_record.time_ns = this->turn_time_ns;
+    turn_record.calls = 1;
+    this->turn_time_ns = 0;
+    for (auto i = 0; i < enum2i(ProfileSection::MAX); i++) {
+        this->totals[i].time_ns += this->current[i].time_ns;
+        this->totals[i].calls += this->current[i].calls;
+    }
+
+    this->history[this->history_head] = this->current;
+    this->history_turns[this->history_head] = game_turn;
+    this->history_head = (this->history_head + 1) % HISTORY_SIZE;
+    this->history_count = std::min(this->history_count + 1, HISTORY_SIZE);
+    this->current = {};
+}
+
+/*!
+ * @brief 計測開始からの合計を返す
+ */
+const ProfileRecords &Profiler::get_totals() const
+{
+    return this->totals;
+}
+
+/*!
+ * @brief 直近のゲームターンの計測値を合計する
+ * @param turns 合計するゲームターン数 (記録されている数を超えた分は無視する)
+ * @return 処理区分毎の合計
+ */
+ProfileRecords Profiler::get_recent(int turns) const
+{
+    ProfileRecords records{};
+    const auto count = std::min(turns, this->history_count);
+    for (auto n = 1; n <= count; n++) {
+        const auto &turn_records = this->history[(this->history_head - n + HISTORY_SIZE) % HISTORY_SIZE];
+        for (auto i = 0; i < enum2i(ProfileSection::MAX); i++) {
+            records[i].time_ns += turn_records[i].time_ns;
+            records[i].calls += turn_records[i].calls;
+        }
+    }
+
+    return records;
+}
+
+/*!
+ * @brief リングバッファに記録されているゲームターン数を返す
+ */
+int Profiler::get_recorded_turns() const
+{
+    return this->history_count;
+}
+
+/*!
+ * @brief リングバッファの内容を古い順にCSV形式で書き出す
+ * @param path 書き出すファイルのパス
+ * @return 書き出せたらtrue
+ * @details 1行が1ゲームターンで、処理区分毎に経過時間(マイクロ秒)と呼び出し回数の列を持つ
+ */
+bool Profiler::dump_csv(const std::string &path) const
+{
+    auto *fff = angband_fopen(path.data(), "w");
+    if (fff == nullptr) {
+        return false;
+    }
+
+    fprintf(fff, "turn");
+    for (const auto &name : SECTION_NAMES) {
+        fprintf(fff, ",%s_us,%s_calls", name.data(), name.data());
+    }
+
+    fprintf(fff, "\n");
+    for (auto n = this->history_count; n > 0; n--) {
+        const auto index = (this->history_head - n + HISTORY_SIZE) % HISTORY_SIZE;
+        fprintf(fff, "%d", this->history_turns[index]);
+        for (const auto &record : this->history[index]) {
+            fprintf(fff, ",%.1f,%d", record.time_ns / 1000.0, record.calls);
+        }
+
+        fprintf(fff, "\n");
+    }
+
+    const auto is_error = ferror(fff) != 0;
+    angband_fclose(fff);
+    return !is_error;
+}
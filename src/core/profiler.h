@@ -0,0 +1,180 @@
+﻿#pragma once
+
+/*
+ * @file profiler.h
+ * @brief サブシステム毎の処理時間を計測するプロファイラのヘッダ
+ * @details
+ * USE_PROFILER が定義されていない時、ProfileScope と ProfilePause は何もしない空のクラスとなる.
+ * 定義されている時も、計測を有効にするまでは時刻の取得を行わない.
+ */
+
+#include "system/angband.h"
+#include <array>
+#include <string>
+#include <string_view>
+
+/*!
+ * @brief 計測対象の処理区分
+ */
+enum class ProfileSection : int {
+    GAME_TURN = 0, //!< 1ゲームターン全体 (最も外側の処理区分の合計)
+    PLAYER = 1, //!< プレイヤーの行動 (process_player)
+    MONSTERS = 2, //!< モンスターの行動 (process_monsters)
+    WORLD = 3, //!< ゲームターン毎の世界の処理 (process_world)
+    UPDATE_VIEW = 4, //!< プレイヤーの視界の更新 (update_view)
+    UPDATE_MON_LITE = 5, //!< モンスターの光源の更新 (update_mon_lite)
+    UPDATE_FLOW = 6, //!< モンスターの経路の更新 (update_flow)
+    REDRAW_STUFF = 7, //!< メイン画面の再描画 (redraw_stuff)
+    WINDOW_STUFF = 8, //!< サブウィンドウの再描画 (window_stuff)
+    FLOOR_CHANGE = 9, //!< フロアの生成と移動 (change_floor)
+    MAX,
+};
+
+/*!
+ * @brief 処理区分1つ分の計測値
+ */
+struct ProfileRecord {
+    int64_t time_ns = 0; //!< 経過時間の合計 (ナノ秒)
+    int calls = 0; //!< 呼び出し回数
+};
+
+using ProfileRecords = std::array<ProfileRecord, static_cast<int>(ProfileSection::MAX)>;
+
+/*!
+ * @brief 処理区分毎の経過時間を、ゲームターン単位のリングバッファに集計する
+ * @details
+ * 処理区分は入れ子になりうるので、各区分の時間は内側の区分の時間を含む.
+ * キー入力待ちの間は一時停止し、その時間はどの区分にも含めない.
+ */
+class Profiler final {
+public:
+    static constexpr int HISTORY_SIZE = 1000; //!< 保持するゲームターン数
+
+    static Profiler &get_instance();
+    static std::string_view get_name(ProfileSection section);
+    static int64_t now_ns();
+
+    bool is_enabled() const
+    {
+        return this->enabled;
+    }
+
+    void set_enabled(bool enabled);
+    void reset();
+    void enter();
+    void leave(ProfileSection section, int64_t time_ns);
+    void pause();
+    void resume();
+    int64_t get_paused_ns() const;
+    void end_turn(GAME_TURN game_turn);
+    const ProfileRecords &get_totals() const;
+    ProfileRecords get_recent(int turns) const;
+    int get_recorded_turns() const;
+    bool dump_csv(const std::string &path) const;
+
+    Profiler(const Profiler &) = delete;
+    Profiler(Profiler &&) = delete;
+    Profiler &operator=(const Profiler &) = delete;
+    Profiler &operator=(Profiler &&) = delete;
+
+private:
+    Profiler() = default;
+    ~Profiler() = default;
+
+    bool enabled = false;
+    int depth = 0; //!< 計測中の処理区分の入れ子の深さ
+    int pause_depth = 0; //!< 一時停止の入れ子の深さ
+    int64_t pause_start_ns = 0; //!< 一時停止した時刻
+    int64_t paused_ns = 0; //!< 一時停止していた時間の累計
+    int64_t turn_time_ns = 0; //!< 集計中のゲームターンで最も外側の処理区分にかかった時間の合計
+    ProfileRecords current{}; //!< 集計中のゲームターンの計測値
+    ProfileRecords totals{}; //!< 計測開始からの合計
+    std::array<ProfileRecords, HISTORY_SIZE> history{}; //!< 直近のゲームターン毎の計測値
+    std::array<GAME_TURN, HISTORY_SIZE> history_turns{}; //!< historyの各要素のゲームターン
+    int history_head = 0; //!< 次に書き込むhistoryの位置
+    int history_count = 0;
+};
+
+/*!
+ * @brief スコープに入ってから出るまでの時間を処理区分に積算する
+ * @details 途中で一時停止していた時間は除く
+ */
+class ProfileScope final {
+public:
+#ifdef USE_PROFILER
+    ProfileScope(ProfileSection section)
+        : section(section)
+    {
+        auto &profiler = Profiler::get_instance();
+        if (!profiler.is_enabled()) {
+            return;
+        }
+
+        profiler.enter();
+        this->start_ns = Profiler::now_ns();
+        this->start_paused_ns = profiler.get_paused_ns();
+    }
+
+    ~ProfileScope()
+    {
+        if (this->start_ns < 0) {
+            return;
+        }
+
+        auto &profiler = Profiler::get_instance();
+        const auto paused_ns = profiler.get_paused_ns() - this->start_paused_ns;
+        profiler.leave(this->section, Profiler::now_ns() - this->start_ns - paused_ns);
+    }
+#else
+    ProfileScope(ProfileSection section)
+    {
+        (void)section;
+    }
+#endif
+
+    ProfileScope(const ProfileScope &) = delete;
+    ProfileScope &operator=(const ProfileScope &) = delete;
+
+#ifdef USE_PROFILER
+private:
+    ProfileSection section;
+    int64_t start_ns = -1;
+    int64_t start_paused_ns = 0;
+#endif
+};
+
+/*!
+ * @brief スコープの間、計測を一時停止する
+ * @details キー入力待ち等、ゲームの処理ではない時間を処理区分から除くために使う
+ */
+class ProfilePause final {
+public:
+#ifdef USE_PROFILER
+    ProfilePause()
+        : paused(Profiler::get_instance().is_enabled())
+    {
+        if (this->paused) {
+            Profiler::get_instance().pause();
+        }
+    }
+
+    ~ProfilePause()
+    {
+        if (this->paused) {
+            Profiler::get_instance().resume();
+        }
+    }
+#else
+    ProfilePause()
+    {
+    }
+#endif
+
+    ProfilePause(const ProfilePause &) = delete;
+    ProfilePause &operator=(const ProfilePause &) = delete;
+
+#ifdef USE_PROFILER
+private:
+    bool paused;
+#endif
+};
@@ -5,6 +5,7 @@
  */
 #include "core/window-redrawer.h"
 #include "core/player-redraw-types.h"
+#include "core/profiler.h"
 #include "core/stuff-handler.h"
 #include "floor/floor-util.h"
 #include "game-option/option-flags.h"
@@ -70,6 +71,8 @@ void redraw_stuff(PlayerType *player_ptr)
         return;
     }
 
+    ProfileScope profile_scope(ProfileSection::REDRAW_STUFF);
+
     if (!w_ptr->character_generated) {
         return;
     }
@@ -234,6 +237,8 @@ void window_stuff(PlayerType *player_ptr)
         return;
     }
 
+    ProfileScope profile_scope(ProfileSection::WINDOW_STUFF);
+
     BIT_FLAGS mask = 0L;
     for (auto i = 0U; i < angband_terms.size(); ++i) {
         if (angband_terms[i] && !angband_terms[i]->never_fresh) {
@@ -6,6 +6,7 @@
 #include "core/player-processor.h"
 #include "core/player-redraw-types.h"
 #include "core/player-update-types.h"
+#include "core/profiler.h"
 #include "core/stuff-handler.h"
 #include "core/turn-compensator.h"
 #include "core/window-redrawer.h"
@@ -173,18 +174,10 @@ void process_dungeon(PlayerType *player_ptr, bool load_game)
             compact_monsters(player_ptr, 64);
         }
 
-        if ((floor_ptr->m_cnt + 32 < floor_ptr->m_max) && !player_ptr->phase_out) {
-            compact_monsters(player_ptr, 0);
-        }
-
         if (floor_ptr->o_cnt + 32 > w_ptr->max_o_idx) {
             compact_objects(player_ptr, 64);
         }
 
-        if (floor_ptr->o_cnt + 32 < floor_ptr->o_max) {
-            compact_objects(player_ptr, 0);
-        }
-
         process_player(player_ptr);
         process_upkeep_with_speed(player_ptr);
         handle_stuff(player_ptr);
@@ -223,6 +216,7 @@ void process_dungeon(PlayerType *player_ptr, bool load_game)
         }
 
         w_ptr->game_turn++;
+        Profiler::get_instance().end_turn(w_ptr->game_turn);
         if (w_ptr->dungeon_turn < w_ptr->dungeon_turn_limit) {
             if (!player_ptr->wild_mode || wild_regen) {
                 w_ptr->dungeon_turn++;
@@ -34,6 +34,7 @@
 #include "system/monster-race-info.h"
 #include "system/player-type-definition.h"
 #include "target/projection-path-calculator.h"
+#include "term/animation-scheduler.h"
 #include "timed-effect/player-blindness.h"
 #include "timed-effect/player-hallucination.h"
 #include "timed-effect/timed-effects.h"
@@ -171,17 +172,15 @@ ProjectResult project(PlayerType *player_ptr, const MONSTER_IDX who, POSITION ra
                 if (panel_contains(ny, nx) && player_has_los_bold(player_ptr, ny, nx)) {
                     print_bolt_pict(player_ptr, oy, ox, ny, nx, typ);
                     move_cursor_relative(ny, nx);
-                    term_fresh();
-                    term_xtra(TERM_XTRA_DELAY, delay_factor);
+                    AnimationScheduler::get_instance().present_frame(delay_factor);
                     lite_spot(player_ptr, ny, nx);
-                    term_fresh();
                     if (flag & (PROJECT_BEAM)) {
                         print_bolt_pict(player_ptr, ny, nx, ny, nx, typ);
                     }
 
                     visual = true;
                 } else if (visual) {
-                    term_xtra(TERM_XTRA_DELAY, delay_factor);
+                    AnimationScheduler::get_instance().present_frame(delay_factor);
                 }
             }
         }
@@ -191,6 +190,10 @@ ProjectResult project(PlayerType *player_ptr, const MONSTER_IDX who, POSITION ra
         k++;
     }
 
+    if (visual) {
+        AnimationScheduler::get_instance().finish();
+    }
+
     path_n = k;
     POSITION by = oy;
     POSITION bx = ox;
@@ -282,12 +285,13 @@ ProjectResult project(PlayerType *player_ptr, const MONSTER_IDX who, POSITION ra
             }
 
             move_cursor_relative(by, bx);
-            term_fresh();
             if (visual || drawn) {
-                term_xtra(TERM_XTRA_DELAY, delay_factor);
+                AnimationScheduler::get_instance().present_frame(delay_factor);
             }
         }
 
+        AnimationScheduler::get_instance().finish();
+
         if (drawn) {
             for (int i = 0; i < grids; i++) {
                 auto y = gy[i];
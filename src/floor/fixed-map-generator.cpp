@@ -73,7 +73,7 @@ static void drop_here(FloorType *floor_ptr, ItemEntity *j_ptr, POSITION y, POSIT
     o_ptr->ix = x;
     o_ptr->held_m_idx = 0;
     auto *g_ptr = &floor_ptr->grid_array[y][x];
-    g_ptr->o_idx_list.add(floor_ptr, o_idx);
+    floor_ptr->grid_array.o_idx_list(g_ptr).add(floor_ptr, o_idx);
 }
 
 static void generate_artifact(PlayerType *player_ptr, qtwg_type *qtwg_ptr, const FixedArtifactId artifact_index)
@@ -8,6 +8,7 @@
 #include "floor/floor-object.h"
 #include "floor/floor-save-util.h"
 #include "floor/floor-save.h"
+#include "floor/floor-speculator.h"
 #include "floor/floor-util.h"
 #include "floor/wild.h"
 #include "game-option/birth-options.h"
@@ -113,6 +114,7 @@ static MonsterRaceInfo &set_pet_params(PlayerType *player_ptr, const int current
     *m_ptr = party_mon[current_monster];
     m_ptr->fy = cy;
     m_ptr->fx = cx;
+    player_ptr->current_floor_ptr->m_spatial_index.place(m_idx, cy, cx);
     m_ptr->current_floor_ptr = player_ptr->current_floor_ptr;
     m_ptr->ml = true;
     m_ptr->mtimed[MTIMED_CSLEEP] = 0;
@@ -320,7 +322,10 @@ static void new_floor_allocation(PlayerType *player_ptr, saved_floor_type *sf_pt
 static void check_dead_end(PlayerType *player_ptr, saved_floor_type *sf_ptr)
 {
     if (sf_ptr->last_visit == 0) {
-        generate_floor(player_ptr);
+        if (!swap_in_speculative_floor(player_ptr)) {
+            generate_floor(player_ptr);
+        }
+
         return;
     }
 
@@ -416,6 +421,8 @@ void change_floor(PlayerType *player_ptr)
     panel_col_max = 0;
     player_ptr->ambush_flag = false;
     update_floor(player_ptr);
+    discard_speculative_floor();
+    player_ptr->current_floor_ptr->terrain_version++;
     place_pet(player_ptr);
     forget_travel_flow(player_ptr->current_floor_ptr);
     update_unique_artifact(player_ptr->current_floor_ptr, new_floor_id);
@@ -0,0 +1,345 @@
+﻿/*!
+ * @file floor-connectivity.cpp
+ * @brief フロアの連結性の判定と修復
+ * @details
+ * プレイヤーが通れない永久地形だけを壁とみなし、それ以外のグリッドの連結成分を素集合データ構造で求める.
+ * 永久壁は領域を分断する方向にしか働かず、素集合データ構造では分断を追跡できないため、
+ * 生成の途中ではなくフロアの生成後にまとめて連結成分を求める.
+ * 連結でない場合は、連結成分同士を最も少ない永久壁を通る経路で結び、その経路上の永久壁をダンジョンの通常の壁に変える.
+ * Vault や内部の部屋の永久壁は崩さない.
+ */
+
+#include "floor/floor-connectivity.h"
+#include "grid/feature.h"
+#include "grid/grid.h"
+#include "system/floor-type-definition.h"
+#include "system/grid-type-definition.h"
+#include "system/terrain-type-definition.h"
+#include "term/z-rand.h"
+#include "util/bit-flags-calculator.h"
+#include <deque>
+#include <limits>
+#include <numeric>
+#include <utility>
+#include <vector>
+
+namespace {
+FloorConnectivityStats connectivity_stats;
+
+// clang-format off
+constexpr int DY[8] = { -1, -1, -1,  0, 0,  1, 1, 1 };
+constexpr int DX[8] = { -1,  0,  1, -1, 1, -1, 0, 1 };
+// clang-format on
+
+/*!
+ * @brief 素集合データ構造 (union-find)
+ */
+class DisjointSet {
+public:
+    DisjointSet(int size)
+        : parents(size)
+        , sizes(size, 1)
+    {
+        std::iota(this->parents.begin(), this->parents.end(), 0);
+    }
+
+    int find(int x)
+    {
+        while (this->parents[x] != x) {
+            this->parents[x] = this->parents[this->parents[x]];
+            x = this->parents[x];
+        }
+
+        return x;
+    }
+
+    /*!
+     * @brief 2つの要素を含む集合を併合する
+     * @return 別々の集合だったならtrue
+     */
+    bool unite(int x, int y)
+    {
+        x = this->find(x);
+        y = this->find(y);
+        if (x == y) {
+            return false;
+        }
+
+        if (this->sizes[x] < this->sizes[y]) {
+            std::swap(x, y);
+        }
+
+        this->parents[y] = x;
+        this->sizes[x] += this->sizes[y];
+        return true;
+    }
+
+    int size(int x)
+    {
+        return this->sizes[this->find(x)];
+    }
+
+private:
+    std::vector<int> parents;
+    std::vector<int> sizes;
+};
+
+/*!
+ * @brief (y,x) がプレイヤーの通れない永久地形かどうかを返す
+ */
+bool is_permanent_blocker(const FloorType &floor, int y, int x)
+{
+    const auto &flags = terrains_info[floor.grid_array[y][x].feat].flags;
+    return flags.has(TerrainCharacteristics::PERMANENT) && flags.has_not(TerrainCharacteristics::MOVE);
+}
+
+/*!
+ * @brief (y,x) が連結のために崩してはならないグリッドかどうかを返す
+ * @details Vault及び内部の部屋の壁は、その構造を壊さないよう崩さない
+ */
+bool is_protected_grid(const FloorType &floor, int y, int x)
+{
+    return any_bits(floor.grid_array[y][x].info, CAVE_ICKY | CAVE_VAULT | CAVE_INNER);
+}
+
+/*!
+ * @brief 崩した永久壁の代わりに置く、ダンジョンの通常の壁を決める
+ * @details
+ * 部屋の外壁ならダンジョンの外壁を、それ以外ならダンジョンの岩盤を使う.
+ * それが永久地形なら永久でない地形に変え、変えられなければ花崗岩とする.
+ */
+FEAT_IDX decide_opening_feat(FloorType &floor, const grid_type &grid)
+{
+    auto feat = any_bits(grid.info, CAVE_OUTER) ? feat_wall_outer : feat_wall_type[randint0(100)];
+    if (permanent_wall(&terrains_info[feat])) {
+        feat = feat_state(&floor, feat, TerrainCharacteristics::UNPERM);
+    }
+
+    return terrains_info[feat].flags.has(TerrainCharacteristics::PERMANENT) ? feat_granite : feat;
+}
+
+/*!
+ * @brief フロアの連結成分を管理する
+ * @details 各グリッドの8近傍は互いに移動可能とし、永久地形のみを壁とみなす
+ */
+class FloorComponents {
+public:
+    FloorComponents(FloorType &floor)
+        : floor(floor)
+        , height(floor.height)
+        , width(floor.width)
+        , is_blocker(floor.height * floor.width)
+        , components(floor.height * floor.width)
+    {
+        for (auto y = 0; y < this->height; y++) {
+            for (auto x = 0; x < this->width; x++) {
+                const auto is_blocker = is_permanent_blocker(floor, y, x);
+                this->is_blocker[this->to_index(y, x)] = is_blocker;
+                this->count += is_blocker ? 0 : 1;
+            }
+        }
+
+        for (auto y = 0; y < this->height; y++) {
+            for (auto x = 0; x < this->width; x++) {
+                if (!this->is_blocker[this->to_index(y, x)]) {
+                    this->unite_neighbors(y, x);
+                }
+            }
+        }
+    }
+
+    int get_count() const
+    {
+        return this->count;
+    }
+
+    bool open_smallest_component();
+    int get_opened_grids() const
+    {
+        return this->opened_grids;
+    }
+
+private:
+    FloorType &floor;
+    int height;
+    int width;
+    std::vector<bool> is_blocker;
+    DisjointSet components;
+    int count = 0; //!< 連結成分数
+    int opened_grids = 0;
+
+    int to_index(int y, int x) const
+    {
+        return y * this->width + x;
+    }
+
+    bool is_edge(int y, int x) const
+    {
+        return (y == 0) || (x == 0) || (y == this->height - 1) || (x == this->width - 1);
+    }
+
+    void unite_neighbors(int y, int x);
+    int find_smallest_component();
+};
+
+/*!
+ * @brief グリッドを周囲の永久地形でないグリッドの連結成分と併合する
+ */
+void FloorComponents::unite_neighbors(int y, int x)
+{
+    const auto index = this->to_index(y, x);
+    for (auto d = 0; d < 8; d++) {
+        const auto ny = y + DY[d];
+        const auto nx = x + DX[d];
+        if ((ny < 0) || (ny >= this->height) || (nx < 0) || (nx >= this->width)) {
+            continue;
+        }
+
+        const auto next = this->to_index(ny, nx);
+        if (this->is_blocker[next]) {
+            continue;
+        }
+
+        if (this->components.unite(index, next)) {
+            this->count--;
+        }
+    }
+}
+
+/*!
+ * @brief 最も小さい連結成分の代表元を返す
+ */
+int FloorComponents::find_smallest_component()
+{
+    auto smallest = -1;
+    for (auto index = 0; index < this->height * this->width; index++) {
+        if (this->is_blocker[index]) {
+            continue;
+        }
+
+        const auto root = this->components.find(index);
+        if ((smallest < 0) || (this->components.size(root) < this->components.size(smallest))) {
+            smallest = root;
+        }
+    }
+
+    return smallest;
+}
+
+/*!
+ * @brief 最も小さい連結成分を、通る永久壁が最も少ない経路で他の連結成分と結ぶ
+ * @return 結べたらtrue
+ * @details 経路の探索は永久壁を通る時だけ費用1とする0-1 BFSで行い、フロア外周とVault及び内部の部屋の永久壁は通らない
+ */
+bool FloorComponents::open_smallest_component()
+{
+    const auto source = this->find_smallest_component();
+    const auto size = this->height * this->width;
+    std::vector<int> costs(size, std::numeric_limits<int>::max());
+    std::vector<int> previous(size, -1);
+    std::deque<int> queue;
+    for (auto index = 0; index < size; index++) {
+        if (!this->is_blocker[index] && (this->components.find(index) == source)) {
+            costs[index] = 0;
+            queue.push_back(index);
+        }
+    }
+
+    auto target = -1;
+    while (!queue.empty() && (target < 0)) {
+        const auto current = queue.front();
+        queue.pop_front();
+        const auto y = current / this->width;
+        const auto x = current % this->width;
+        for (auto d = 0; d < 8; d++) {
+            const auto ny = y + DY[d];
+            const auto nx = x + DX[d];
+            if ((ny < 0) || (ny >= this->height) || (nx < 0) || (nx >= this->width)) {
+                continue;
+            }
+
+            const auto next = this->to_index(ny, nx);
+            if (this->is_blocker[next] && (this->is_edge(ny, nx) || is_protected_grid(this->floor, ny, nx))) {
+                continue;
+            }
+
+            const auto cost = costs[current] + (this->is_blocker[next] ? 1 : 0);
+            if (cost >= costs[next]) {
+                continue;
+            }
+
+            costs[next] = cost;
+            previous[next] = current;
+            if (!this->is_blocker[next] && (this->components.find(next) != source)) {
+                target = next;
+                break;
+            }
+
+            if (this->is_blocker[next]) {
+                queue.push_back(next);
+            } else {
+                queue.push_front(next);
+            }
+        }
+    }
+
+    if (target < 0) {
+        return false;
+    }
+
+    for (auto index = previous[target]; (index >= 0) && (costs[index] > 0); index = previous[index]) {
+        if (!this->is_blocker[index]) {
+            continue;
+        }
+
+        const auto y = index / this->width;
+        const auto x = index % this->width;
+        auto &grid = this->floor.grid_array[y][x];
+        grid.feat = decide_opening_feat(this->floor, grid);
+        grid.mimic = 0;
+        this->is_blocker[index] = false;
+        this->count++;
+        this->opened_grids++;
+        this->unite_neighbors(y, x);
+    }
+
+    return true;
+}
+}
+
+/*!
+ * @brief フロアが連結でなければ、永久壁の一部をダンジョンの通常の壁に変えて連結にする
+ * @param floor_ptr フロアへの参照ポインタ
+ * @return 修復のために変えたグリッド数 (元々連結なら0)、修復できない場合は負の値
+ * @details 永久地形でないグリッドが1つも無いフロアは修復できないものとする
+ */
+int repair_floor_connectivity(FloorType *floor_ptr)
+{
+    connectivity_stats.checked_floors++;
+    FloorComponents components(*floor_ptr);
+    if (components.get_count() == 0) {
+        return -1;
+    }
+
+    while (components.get_count() > 1) {
+        if (!components.open_smallest_component()) {
+            return -1;
+        }
+    }
+
+    const auto opened_grids = components.get_opened_grids();
+    if (opened_grids > 0) {
+        connectivity_stats.repaired_floors++;
+        connectivity_stats.opened_grids += opened_grids;
+    }
+
+    return opened_grids;
+}
+
+/*!
+ * @brief これまでの連結性の修復の統計を返す
+ */
+const FloorConnectivityStats &get_floor_connectivity_stats()
+{
+    return connectivity_stats;
+}
@@ -0,0 +1,19 @@
+﻿#pragma once
+
+/*!
+ * @file floor-connectivity.h
+ * @brief フロアの連結性の判定と修復のヘッダ
+ */
+
+/*!
+ * @brief フロアの連結性の修復に関する統計
+ */
+struct FloorConnectivityStats {
+    int checked_floors = 0; //!< 連結性を判定したフロア数
+    int repaired_floors = 0; //!< 連結でなかったが修復できたため、再生成せずに済んだフロア数
+    int opened_grids = 0; //!< 修復のために永久壁から通常の壁へ変えたグリッド数
+};
+
+class FloorType;
+int repair_floor_connectivity(FloorType *floor_ptr);
+const FloorConnectivityStats &get_floor_connectivity_stats();
@@ -13,6 +13,7 @@
 #include "dungeon/dungeon-flag-types.h"
 #include "dungeon/quest.h"
 #include "floor/cave-generator.h"
+#include "floor/floor-connectivity.h"
 #include "floor/floor-events.h"
 #include "floor/floor-generator.h"
 #include "floor/floor-save.h" //!< @todo precalc_cur_num_of_pet() が依存している、違和感.
@@ -53,8 +54,6 @@
 #include "wizard/wizard-messages.h"
 #include "world/world.h"
 #include <algorithm>
-#include <array>
-#include <stack>
 
 /*!
  * @brief 闘技場用のアリーナ地形を作成する / Builds the on_defeat_arena_monster after it is entered -KMW-
@@ -364,6 +363,7 @@ void clear_cave(PlayerType *player_ptr)
     std::fill_n(floor_ptr->o_list.begin(), floor_ptr->o_max, ItemEntity{});
     floor_ptr->o_max = 1;
     floor_ptr->o_cnt = 0;
+    floor_ptr->o_slots.reset();
 
     for (auto &[r_idx, r_ref] : monraces_info) {
         r_ref.cur_num = 0;
@@ -372,6 +372,8 @@ void clear_cave(PlayerType *player_ptr)
     std::fill_n(floor_ptr->m_list.begin(), floor_ptr->m_max, MonsterEntity{});
     floor_ptr->m_max = 1;
     floor_ptr->m_cnt = 0;
+    floor_ptr->m_slots.reset();
+    floor_ptr->m_spatial_index.clear();
     for (int i = 0; i < MAX_MTIMED; i++) {
         floor_ptr->mproc_max[i] = 0;
     }
@@ -382,110 +384,23 @@ void clear_cave(PlayerType *player_ptr)
             auto *g_ptr = &floor_ptr->grid_array[y][x];
             g_ptr->info = 0;
             g_ptr->feat = 0;
-            g_ptr->o_idx_list.clear();
+            floor_ptr->grid_array.o_idx_list(g_ptr).clear();
             g_ptr->m_idx = 0;
             g_ptr->special = 0;
             g_ptr->mimic = 0;
-            memset(g_ptr->costs, 0, sizeof(g_ptr->costs));
-            memset(g_ptr->costs, 0, sizeof(g_ptr->dists));
-            g_ptr->when = 0;
         }
     }
 
+    floor_ptr->grid_array.clear_flow(0, 0, MAX_HGT - 1, MAX_WID - 1);
+    floor_ptr->grid_array.clear_when(0, 0, MAX_HGT - 1, MAX_WID - 1);
+
+    floor_ptr->reset_flow();
+
     floor_ptr->base_level = floor_ptr->dun_level;
     floor_ptr->monster_level = floor_ptr->base_level;
     floor_ptr->object_level = floor_ptr->base_level;
 }
 
-typedef bool (*IsWallFunc)(const FloorType *, int, int);
-
-// (y,x) がプレイヤーが通れない永久地形かどうかを返す。
-static bool is_permanent_blocker(const FloorType *const floor_ptr, const int y, const int x)
-{
-    const FEAT_IDX feat = floor_ptr->grid_array[y][x].feat;
-    const auto &flags = terrains_info[feat].flags;
-    return flags.has(TerrainCharacteristics::PERMANENT) && flags.has_not(TerrainCharacteristics::MOVE);
-}
-
-static void floor_is_connected_dfs(const FloorType *const floor_ptr, const IsWallFunc is_wall, const int y_start, const int x_start, bool *const visited)
-{
-    // clang-format off
-    static const int DY[8] = { -1, -1, -1,  0, 0,  1, 1, 1 };
-    static const int DX[8] = { -1,  0,  1, -1, 1, -1, 0, 1 };
-    // clang-format on
-
-    const int h = floor_ptr->height;
-    const int w = floor_ptr->width;
-    const int start = w * y_start + x_start;
-
-    // 深さ優先探索用のスタック。
-    // 最大フロアサイズが h=66, w=198 なので、スタックオーバーフロー防止のため再帰は使わない。
-    std::stack<int> stk;
-
-    stk.emplace(start);
-    visited[start] = true;
-
-    while (!stk.empty()) {
-        const int cur = stk.top();
-        stk.pop();
-        const int y = cur / w;
-        const int x = cur % w;
-
-        for (int i = 0; i < 8; ++i) {
-            const int y_nxt = y + DY[i];
-            const int x_nxt = x + DX[i];
-            if (y_nxt < 0 || h <= y_nxt || x_nxt < 0 || w <= x_nxt) {
-                continue;
-            }
-            const int nxt = w * y_nxt + x_nxt;
-            if (visited[nxt]) {
-                continue;
-            }
-            if (is_wall(floor_ptr, y_nxt, x_nxt)) {
-                continue;
-            }
-
-            stk.emplace(nxt);
-            visited[nxt] = true;
-        }
-    }
-}
-
-// 現在のフロアが連結かどうかを返す。
-// 各セルの8近傍は互いに移動可能とし、is_wall が真を返すセルのみを壁とみなす。
-//
-// 連結成分数が 0 の場合、偽を返す。
-static bool floor_is_connected(const FloorType *const floor_ptr, const IsWallFunc is_wall)
-{
-    static std::array<bool, MAX_HGT * MAX_WID> visited;
-
-    const int h = floor_ptr->height;
-    const int w = floor_ptr->width;
-
-    std::fill(begin(visited), end(visited), false);
-
-    int n_component = 0; // 連結成分数
-
-    for (int y = 0; y < h; ++y) {
-        for (int x = 0; x < w; ++x) {
-            const int idx = w * y + x;
-            if (visited[idx]) {
-                continue;
-            }
-            if (is_wall(floor_ptr, y, x)) {
-                continue;
-            }
-
-            if (++n_component >= 2) {
-                break;
-            }
-            floor_is_connected_dfs(floor_ptr, is_wall, y, x, visited.data());
-        }
-    }
-
-    return n_component == 1;
-}
-
 /*!
  * ダンジョンのランダムフロアを生成する / Generates a random dungeon level -RAK-
  * @parama player_ptr プレイヤーへの参照ポインタ
@@ -526,11 +441,14 @@ void generate_floor(PlayerType *player_ptr)
         }
 
         // ダンジョン内フロアが連結でない(永久壁で区切られた孤立部屋がある)場合、
-        // 狂戦士でのプレイに支障をきたしうるので再生成する。
+        // 狂戦士でのプレイに支障をきたしうるので、永久壁の一部を通常の壁に変えて連結にする。
+        // 修復できない場合は再生成する。
         // 地上、荒野マップ、クエストでは連結性判定は行わない。
-        // TODO: 本来はダンジョン生成アルゴリズム自身で連結性を保証するのが理想ではある。
         const bool check_conn = okay && floor_ptr->dun_level > 0 && !inside_quest(floor_ptr->quest_number);
-        if (check_conn && !floor_is_connected(floor_ptr, is_permanent_blocker)) {
+        const auto opened_grids = check_conn ? repair_floor_connectivity(floor_ptr) : 0;
+        if (opened_grids > 0) {
+            msg_format_wizard(player_ptr, CHEAT_DUNGEON, _("永久壁を%d箇所崩してフロアを連結にしました。", "Opened %d permanent walls to connect the floor."), opened_grids);
+        } else if (opened_grids < 0) {
             // 一定回数試しても連結にならないなら諦める。
             if (num >= 1000) {
                 plog("cannot generate connected floor. giving up...");
@@ -1,5 +1,6 @@
 ﻿#include "floor/floor-leaver.h"
 #include "cmd-building/cmd-building.h"
+#include "core/game-simulator.h"
 #include "floor/cave.h"
 #include "floor/floor-events.h"
 #include "floor/floor-mode-changer.h"
@@ -122,10 +123,10 @@ static void preserve_pet(PlayerType *player_ptr)
     check_riding_preservation(player_ptr);
     sweep_preserving_pet(player_ptr);
     record_pet_diary(player_ptr);
+    const auto &m_slots = player_ptr->current_floor_ptr->m_slots;
     for (MONSTER_IDX i = player_ptr->current_floor_ptr->m_max - 1; i >= 1; i--) {
         auto *m_ptr = &player_ptr->current_floor_ptr->m_list[i];
-        const auto parent_r_idx = player_ptr->current_floor_ptr->m_list[m_ptr->parent_m_idx].r_idx;
-        if ((m_ptr->parent_m_idx == 0) || MonsterRace(parent_r_idx).is_valid()) {
+        if ((m_ptr->parent_m_idx == 0) || ((m_ptr->parent_m_idx != i) && m_slots.is_current(m_ptr->parent_m_idx, m_ptr->parent_generation))) {
             continue;
         }
 
@@ -242,6 +243,7 @@ static void get_out_monster(PlayerType *player_ptr)
         floor_ptr->grid_array[ny][nx].m_idx = m_idx;
         m_ptr->fy = ny;
         m_ptr->fx = nx;
+        floor_ptr->m_spatial_index.place(m_idx, ny, nx);
         return;
     }
 }
@@ -448,4 +450,7 @@ void leave_floor(PlayerType *player_ptr)
     }
 
     exe_leave_floor(player_ptr, sf_ptr);
+    if (is_simulating()) {
+        verify_simulated_floor_save(player_ptr);
+    }
 }
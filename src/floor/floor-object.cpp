@@ -199,14 +199,15 @@ void delete_all_items_from_floor(PlayerType *player_ptr, POSITION y, POSITION x)
     }
 
     g_ptr = &floor_ptr->grid_array[y][x];
-    for (const auto this_o_idx : g_ptr->o_idx_list) {
+    for (const auto this_o_idx : floor_ptr->grid_array.o_idx_list(g_ptr)) {
         ItemEntity *o_ptr;
         o_ptr = &floor_ptr->o_list[this_o_idx];
         o_ptr->wipe();
         floor_ptr->o_cnt--;
+        floor_ptr->o_slots.release(this_o_idx);
     }
 
-    g_ptr->o_idx_list.clear();
+    floor_ptr->grid_array.o_idx_list(g_ptr).clear();
     lite_spot(player_ptr, y, x);
 }
 
@@ -279,6 +280,7 @@ void delete_object_idx(PlayerType *player_ptr, OBJECT_IDX o_idx)
 
     j_ptr->wipe();
     floor_ptr->o_cnt--;
+    floor_ptr->o_slots.release(o_idx);
 
     set_bits(player_ptr->window_flags, PW_FLOOR_ITEM_LIST | PW_FOUND_ITEM_LIST);
 }
@@ -307,7 +309,7 @@ ObjectIndexList &get_o_idx_list_contains(FloorType *floor_ptr, OBJECT_IDX o_idx)
     if (o_ptr->is_held_by_monster()) {
         return floor_ptr->m_list[o_ptr->held_m_idx].hold_o_idx_list;
     } else {
-        return floor_ptr->grid_array[o_ptr->iy][o_ptr->ix].o_idx_list;
+        return floor_ptr->grid_array.o_idx_list(o_ptr->iy, o_ptr->ix);
     }
 }
 
@@ -391,7 +393,7 @@ OBJECT_IDX drop_near(PlayerType *player_ptr, ItemEntity *j_ptr, PERCENTAGE chanc
             }
 
             k = 0;
-            for (const auto this_o_idx : g_ptr->o_idx_list) {
+            for (const auto this_o_idx : floor_ptr->grid_array.o_idx_list(g_ptr)) {
                 ItemEntity *o_ptr;
                 o_ptr = &floor_ptr->o_list[this_o_idx];
                 if (object_similar(o_ptr, j_ptr)) {
@@ -511,7 +513,7 @@ OBJECT_IDX drop_near(PlayerType *player_ptr, ItemEntity *j_ptr, PERCENTAGE chanc
     }
 
     g_ptr = &floor_ptr->grid_array[by][bx];
-    for (const auto this_o_idx : g_ptr->o_idx_list) {
+    for (const auto this_o_idx : floor_ptr->grid_array.o_idx_list(g_ptr)) {
         ItemEntity *o_ptr;
         o_ptr = &floor_ptr->o_list[this_o_idx];
         if (object_similar(o_ptr, j_ptr)) {
@@ -548,7 +550,7 @@ OBJECT_IDX drop_near(PlayerType *player_ptr, ItemEntity *j_ptr, PERCENTAGE chanc
         j_ptr->iy = by;
         j_ptr->ix = bx;
         j_ptr->held_m_idx = 0;
-        g_ptr->o_idx_list.add(floor_ptr, o_idx);
+        floor_ptr->grid_array.o_idx_list(g_ptr).add(floor_ptr, o_idx);
         done = true;
     }
 
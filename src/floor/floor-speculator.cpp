@@ -0,0 +1,429 @@
+﻿/*!
+ * @file floor-speculator.cpp
+ * @brief 次のフロアの先読み生成
+ * @details
+ * プレイヤーが入力を待っている間に、次に移動しそうな階層 (乗っている階段の先、または1つ下の階層) のフロアを作業用の FloorType へ生成しておき、
+ * 実際にその階層の新しいフロアを生成する時に差し替える.
+ * 先読みの生成にはワールドの乱数シードから導いた専用の乱数系列を使い、ゲーム本体の乱数の状態は変えない.
+ * フロア生成はモンスター種族の生存数・固定アーティファクトの生成済フラグ・プレイヤーの位置等、フロア外の状態も書き換えるため、
+ * 先読みの前後で控えて元に戻し、差し替える時に改めて反映する.
+ * 差し替える時点で、生成済のユニークモンスターが倒されたりペットになったりしていたり、固定アーティファクトが他で生成されていたりすれば、
+ * 先読みしたフロアは捨ててその場で生成する.
+ */
+
+#include "floor/floor-speculator.h"
+#include "dungeon/quest.h"
+#include "floor/floor-generator.h"
+#include "floor/floor-save.h"
+#include "game-option/cheat-options.h"
+#include "io/input-key-acceptor.h"
+#include "monster-race/monster-race.h"
+#include "monster-race/race-flags7.h"
+#include "monster-race/race-indice-types.h"
+#include "system/alloc-entries.h"
+#include "system/artifact-type-definition.h"
+#include "system/dungeon-info.h"
+#include "system/floor-type-definition.h"
+#include "system/grid-type-definition.h"
+#include "system/item-entity.h"
+#include "system/monster-entity.h"
+#include "system/monster-race-info.h"
+#include "system/player-type-definition.h"
+#include "system/terrain-type-definition.h"
+#include "target/target-checker.h"
+#include "term/z-term.h"
+#include "util/bit-flags-calculator.h"
+#include "window/main-window-util.h"
+#include "world/world.h"
+#include <array>
+#include <memory>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace {
+FloorSpeculationStats speculation_stats;
+
+/*!
+ * @brief 先読みしたフロア
+ */
+struct SpeculativeFloor {
+    std::unique_ptr<FloorType> floor; //!< 生成したフロア (無ければnullptr)
+    POSITION y = 0; //!< フロア内のプレイヤーの位置
+    POSITION x = 0;
+    std::vector<alloc_entry> alloc_races; //!< 生成を終えた時点のモンスター生成テーブル
+};
+
+SpeculativeFloor speculative_floor;
+std::unique_ptr<FloorType> spare_floor; //!< 次の先読みで使い回す作業用フロア
+
+/*!
+ * @brief フロア生成がフロア外で書き換える状態の控え
+ * @details
+ * 生成中のメッセージは w_ptr->is_speculating_floor で抑止する.
+ * モンスターがプレイヤーの視界に入った時の disturb() で変わりうる持続行動と入力の破棄要求も控える.
+ */
+class FloorGenerationSnapshot {
+public:
+    FloorGenerationSnapshot(PlayerType *player_ptr);
+    void restore(PlayerType *player_ptr) const;
+
+private:
+    FloorType *floor_ptr;
+    POSITION y;
+    POSITION x;
+    bool enter_dungeon;
+    std::vector<MONSTER_NUMBER> cur_nums;
+    std::vector<bool> generated_artifacts;
+    std::vector<alloc_entry> alloc_races;
+    std::array<POSITION, 4> panel;
+    BIT_FLAGS update;
+    BIT_FLAGS redraw;
+    BIT_FLAGS window_flags;
+    byte action;
+    IDX health_who;
+    MONSTER_IDX pet_t_m_idx;
+    MONSTER_IDX riding_t_m_idx;
+    MONSTER_IDX target_m_idx;
+    bool is_character_dungeon;
+    bool is_input_flushed;
+    Xoshiro128StarStar::state_type rng_state;
+};
+
+FloorGenerationSnapshot::FloorGenerationSnapshot(PlayerType *player_ptr)
+    : floor_ptr(player_ptr->current_floor_ptr)
+    , y(player_ptr->y)
+    , x(player_ptr->x)
+    , enter_dungeon(player_ptr->enter_dungeon)
+    , alloc_races(alloc_race_table)
+    , panel({ { panel_row_min, panel_row_max, panel_col_min, panel_col_max } })
+    , update(player_ptr->update)
+    , redraw(player_ptr->redraw)
+    , window_flags(player_ptr->window_flags)
+    , action(player_ptr->action)
+    , health_who(player_ptr->health_who)
+    , pet_t_m_idx(player_ptr->pet_t_m_idx)
+    , riding_t_m_idx(player_ptr->riding_t_m_idx)
+    , target_m_idx(target_who)
+    , is_character_dungeon(w_ptr->character_dungeon)
+    , is_input_flushed(inkey_xtra)
+    , rng_state(w_ptr->rng.get_state())
+{
+    this->cur_nums.reserve(monraces_info.size());
+    for (const auto &[r_idx, r_ref] : monraces_info) {
+        this->cur_nums.push_back(r_ref.cur_num);
+    }
+
+    this->generated_artifacts.reserve(artifacts_info.size());
+    for (const auto &[a_idx, a_ref] : artifacts_info) {
+        this->generated_artifacts.push_back(a_ref.is_generated);
+    }
+}
+
+void FloorGenerationSnapshot::restore(PlayerType *player_ptr) const
+{
+    player_ptr->current_floor_ptr = this->floor_ptr;
+    player_ptr->y = this->y;
+    player_ptr->x = this->x;
+    player_ptr->enter_dungeon = this->enter_dungeon;
+    auto cur_num = this->cur_nums.begin();
+    for (auto &[r_idx, r_ref] : monraces_info) {
+        r_ref.cur_num = *cur_num++;
+    }
+
+    auto is_generated = this->generated_artifacts.begin();
+    for (auto &[a_idx, a_ref] : artifacts_info) {
+        a_ref.is_generated = *is_generated++;
+    }
+
+    alloc_race_table = this->alloc_races;
+    alloc_race_table_generation++;
+    panel_row_min = this->panel[0];
+    panel_row_max = this->panel[1];
+    panel_col_min = this->panel[2];
+    panel_col_max = this->panel[3];
+    player_ptr->update = this->update;
+    player_ptr->redraw = this->redraw;
+    player_ptr->window_flags = this->window_flags;
+    player_ptr->action = this->action;
+    player_ptr->health_who = this->health_who;
+    player_ptr->pet_t_m_idx = this->pet_t_m_idx;
+    player_ptr->riding_t_m_idx = this->riding_t_m_idx;
+    target_who = this->target_m_idx;
+    w_ptr->character_dungeon = this->is_character_dungeon;
+    inkey_xtra = this->is_input_flushed;
+    w_ptr->rng.set_state(this->rng_state);
+}
+
+/*!
+ * @brief 次に生成することになるフロアの階層を予測する
+ * @param player_ptr プレイヤーへの参照ポインタ
+ * @return 予測した階層. 予測した先が保存済のフロア・地上・クエストの階層ならstd::nullopt
+ * @details
+ * 階段の上にいればその階段の先、いなければ最も多い下り階段での移動を予測する.
+ * 階層の増減は jump_floors() に合わせる
+ */
+std::optional<DEPTH> predict_next_depth(PlayerType *player_ptr)
+{
+    const auto &floor = *player_ptr->current_floor_ptr;
+    if (!floor.is_in_dungeon() || floor.inside_arena || inside_quest(floor.quest_number) || player_ptr->phase_out || player_ptr->wild_mode) {
+        return std::nullopt;
+    }
+
+    const auto &grid = floor.grid_array[player_ptr->y][player_ptr->x];
+    const auto &terrain = terrains_info[grid.feat];
+    const auto is_stairs = terrain.flags.has_any_of({ TerrainCharacteristics::LESS, TerrainCharacteristics::MORE });
+    if (is_stairs && (terrain.flags.has(TerrainCharacteristics::SPECIAL) || ((grid.special != 0) && (get_sf_ptr(grid.special) != nullptr)))) {
+        return std::nullopt;
+    }
+
+    const auto move_num = (is_stairs && terrain.flags.has(TerrainCharacteristics::SHAFT)) ? 2 : 1;
+    const auto &dungeon = dungeons_info[player_ptr->dungeon_idx];
+    DEPTH depth;
+    if (terrain.flags.has(TerrainCharacteristics::LESS)) {
+        depth = floor.dun_level - move_num;
+        if (depth < dungeon.mindepth) {
+            return std::nullopt;
+        }
+    } else {
+        depth = floor.dun_level + move_num;
+        if (depth > dungeon.maxdepth) {
+            return std::nullopt;
+        }
+    }
+
+    if (inside_quest(quest_number(player_ptr, depth))) {
+        return std::nullopt;
+    }
+
+    return depth;
+}
+
+/*!
+ * @brief 先読み用の乱数のシードを、ワールドの乱数シードと現在のゲームターンから導く
+ * @param dungeon_idx 生成するダンジョンのID
+ * @param depth 生成する階層
+ */
+uint32_t derive_speculation_seed(DUNGEON_IDX dungeon_idx, DEPTH depth)
+{
+    auto seed = w_ptr->seed_flavor ^ ((w_ptr->seed_town << 16) | (w_ptr->seed_town >> 16));
+    seed ^= static_cast<uint32_t>(w_ptr->game_turn) * 0x9E3779B9U;
+    seed ^= (static_cast<uint32_t>(dungeon_idx) << 8) ^ static_cast<uint32_t>(depth);
+    return seed;
+}
+
+/*!
+ * @brief 作業用のフロアを用意する
+ * @return 前回の作業用フロアがあればそれを、無ければ init_other() と同じ大きさで確保したフロア
+ */
+std::unique_ptr<FloorType> prepare_work_floor()
+{
+    if (spare_floor) {
+        return std::move(spare_floor);
+    }
+
+    auto floor = std::make_unique<FloorType>();
+    floor->o_list.assign(w_ptr->max_o_idx, {});
+    floor->m_list.assign(w_ptr->max_m_idx, {});
+    for (auto &list : floor->mproc_list) {
+        list.assign(w_ptr->max_m_idx, {});
+    }
+
+    floor->grid_array.resize(MAX_HGT, MAX_WID);
+    return floor;
+}
+
+/*!
+ * @brief 次のフロアを作業用のフロアへ生成する
+ * @param player_ptr プレイヤーへの参照ポインタ
+ * @param depth 生成する階層
+ */
+void build_speculative_floor(PlayerType *player_ptr, DEPTH depth)
+{
+    auto floor = prepare_work_floor();
+    floor->dungeon_idx = player_ptr->dungeon_idx;
+    floor->dun_level = depth;
+    floor->quest_number = QuestId::NONE;
+    floor->inside_arena = false;
+    floor->num_repro = 0;
+
+    const FloorGenerationSnapshot snapshot(player_ptr);
+    w_ptr->character_dungeon = false;
+    w_ptr->is_speculating_floor = true;
+    w_ptr->rng.set_state(derive_speculation_seed(floor->dungeon_idx, depth));
+    panel_row_min = 0;
+    panel_row_max = 0;
+    panel_col_min = 0;
+    panel_col_max = 0;
+    player_ptr->current_floor_ptr = floor.get();
+    generate_floor(player_ptr);
+    speculative_floor.y = player_ptr->y;
+    speculative_floor.x = player_ptr->x;
+    speculative_floor.alloc_races = alloc_race_table;
+    w_ptr->is_speculating_floor = false;
+    snapshot.restore(player_ptr);
+
+    speculative_floor.floor = std::move(floor);
+    speculation_stats.built_floors++;
+}
+
+/*!
+ * @brief 先読みしたフロアに、他で生成済の固定アーティファクトがあるかを返す
+ * @param floor 先読みしたフロア
+ */
+bool has_generated_artifact(const FloorType &floor)
+{
+    for (OBJECT_IDX i = 1; i < floor.o_max; i++) {
+        const auto &item = floor.o_list[i];
+        if (item.is_valid() && item.is_fixed_artifact() && artifacts_info.at(item.fixed_artifact_idx).is_generated) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/*!
+ * @brief 先読みしたフロアのモンスターをモンスター種族の生存数へ数え直す
+ * @param player_ptr プレイヤーへの参照ポインタ
+ * @param floor 先読みしたフロア
+ * @return 数え直した結果が、その場で生成した時に check_unique_placeable() が許す数に収まっていればtrue
+ * @details clear_cave() と同じく、伴っているペットを数えた上にフロアのモンスターを加える. 収まらなければ元の生存数に戻す
+ */
+bool recount_monster_population(PlayerType *player_ptr, const FloorType &floor)
+{
+    std::vector<MONSTER_NUMBER> cur_nums;
+    cur_nums.reserve(monraces_info.size());
+    for (auto &[r_idx, r_ref] : monraces_info) {
+        cur_nums.push_back(r_ref.cur_num);
+        r_ref.cur_num = 0;
+    }
+
+    precalc_cur_num_of_pet(player_ptr);
+    for (MONSTER_IDX i = 1; i < floor.m_max; i++) {
+        const auto &monster = floor.m_list[i];
+        if (monster.is_valid()) {
+            monster.get_real_r_ref().cur_num++;
+        }
+    }
+
+    auto is_placeable = (monraces_info[MonsterRaceId::BANORLUPART].cur_num == 0) || ((monraces_info[MonsterRaceId::BANOR].cur_num == 0) && (monraces_info[MonsterRaceId::LUPART].cur_num == 0));
+    for (const auto &[r_idx, r_ref] : monraces_info) {
+        const auto is_unique = r_ref.kind_flags.has(MonsterKindType::UNIQUE) || r_ref.population_flags.has(MonsterPopulationType::NAZGUL);
+        is_placeable &= !is_unique || (r_ref.cur_num <= r_ref.max_num);
+        is_placeable &= none_bits(r_ref.flags7, RF7_UNIQUE2) || (r_ref.cur_num <= 1);
+    }
+
+    if (is_placeable) {
+        return true;
+    }
+
+    auto cur_num = cur_nums.begin();
+    for (auto &[r_idx, r_ref] : monraces_info) {
+        r_ref.cur_num = *cur_num++;
+    }
+
+    return false;
+}
+}
+
+/*!
+ * @brief 入力待ちの間に、次に移動しそうな階層のフロアを先読みで生成する
+ * @param player_ptr プレイヤーへの参照ポインタ
+ * @details
+ * 既に同じ階層のフロアを先読みしてあるか、キー入力が溜まっていれば何もしない.
+ * 画面を更新してから生成するため、生成中もプレイヤーには直前の状態が見えている.
+ * 生成中のメッセージは表示されないため、ダンジョン生成等のメッセージを表示するチートオプションが有効な時は先読みしない.
+ */
+void speculate_next_floor(PlayerType *player_ptr)
+{
+    if (!w_ptr->character_dungeon || cheat_room || cheat_hear || cheat_peek || (inkey_next && *inkey_next)) {
+        return;
+    }
+
+    const auto depth = predict_next_depth(player_ptr);
+    if (!depth) {
+        return;
+    }
+
+    const auto &floor = speculative_floor.floor;
+    if (floor && (floor->dungeon_idx == player_ptr->dungeon_idx) && (floor->dun_level == *depth)) {
+        return;
+    }
+
+    char key;
+    if (term_inkey(&key, false, false) == 0) {
+        return;
+    }
+
+    discard_speculative_floor();
+    term_fresh();
+    build_speculative_floor(player_ptr, *depth);
+}
+
+/*!
+ * @brief 新しいフロアを生成する代わりに、先読みしたフロアへ差し替える
+ * @param player_ptr プレイヤーへの参照ポインタ
+ * @return 差し替えたらtrue. 先読みしたフロアが無いか使えなければ、先読みしたフロアを捨ててfalse
+ * @details generate_floor() と同じく、フロアの階層とクエスト番号は移動先のものに設定済であること
+ */
+bool swap_in_speculative_floor(PlayerType *player_ptr)
+{
+    if (!speculative_floor.floor) {
+        return false;
+    }
+
+    auto &floor = *player_ptr->current_floor_ptr;
+    auto &candidate = *speculative_floor.floor;
+    auto is_usable = (candidate.dungeon_idx == player_ptr->dungeon_idx) && (candidate.dun_level == floor.dun_level);
+    is_usable &= !floor.inside_arena && !inside_quest(floor.quest_number) && !player_ptr->phase_out && !player_ptr->wild_mode && !player_ptr->enter_dungeon;
+    is_usable = is_usable && !inside_quest(quest_number(player_ptr, floor.dun_level)) && !has_generated_artifact(candidate);
+    if (!is_usable || !recount_monster_population(player_ptr, candidate)) {
+        discard_speculative_floor();
+        return false;
+    }
+
+    for (OBJECT_IDX i = 1; i < candidate.o_max; i++) {
+        const auto &item = candidate.o_list[i];
+        if (item.is_valid() && item.is_fixed_artifact()) {
+            artifacts_info.at(item.fixed_artifact_idx).is_generated = true;
+        }
+    }
+
+    const auto terrain_version = floor.terrain_version;
+    const auto num_repro = floor.num_repro;
+    std::swap(floor, candidate);
+    floor.terrain_version = terrain_version;
+    floor.num_repro += num_repro;
+    floor.m_scheduler.invalidate();
+    player_ptr->y = speculative_floor.y;
+    player_ptr->x = speculative_floor.x;
+    alloc_race_table = std::move(speculative_floor.alloc_races);
+    alloc_race_table_generation++;
+    spare_floor = std::move(speculative_floor.floor);
+    speculation_stats.used_floors++;
+    return true;
+}
+
+/*!
+ * @brief 先読みしたフロアがあれば捨てる
+ * @details 作業用のフロアの領域は次の先読みで使い回す
+ */
+void discard_speculative_floor()
+{
+    if (!speculative_floor.floor) {
+        return;
+    }
+
+    spare_floor = std::move(speculative_floor.floor);
+    speculative_floor.alloc_races.clear();
+    speculation_stats.discarded_floors++;
+}
+
+/*!
+ * @brief これまでの先読み生成の統計を返す
+ */
+const FloorSpeculationStats &get_floor_speculation_stats()
+{
+    return speculation_stats;
+}
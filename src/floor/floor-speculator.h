@@ -0,0 +1,21 @@
+﻿#pragma once
+
+/*!
+ * @file floor-speculator.h
+ * @brief 次のフロアの先読み生成のヘッダ
+ */
+
+/*!
+ * @brief 次のフロアの先読み生成に関する統計
+ */
+struct FloorSpeculationStats {
+    int built_floors = 0; //!< 入力待ちの間に先読みで生成したフロア数
+    int used_floors = 0; //!< 階層移動の際に差し替えて使ったフロア数
+    int discarded_floors = 0; //!< 予測が外れたか、使えなくなったために捨てたフロア数
+};
+
+class PlayerType;
+void speculate_next_floor(PlayerType *player_ptr);
+bool swap_in_speculative_floor(PlayerType *player_ptr);
+void discard_speculative_floor();
+const FloorSpeculationStats &get_floor_speculation_stats();
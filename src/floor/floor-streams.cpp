@@ -355,10 +355,10 @@ void build_streamer(PlayerType *player_ptr, FEAT_IDX feat, int chance)
                 delete_monster(player_ptr, ty, tx);
             }
 
-            if (!g_ptr->o_idx_list.empty() && streamer_ptr->flags.has_not(TerrainCharacteristics::DROP)) {
+            if (!floor_ptr->grid_array.o_idx_list(g_ptr).empty() && streamer_ptr->flags.has_not(TerrainCharacteristics::DROP)) {
 
                 /* Scan all objects in the grid */
-                for (const auto this_o_idx : g_ptr->o_idx_list) {
+                for (const auto this_o_idx : floor_ptr->grid_array.o_idx_list(g_ptr)) {
                     auto *o_ptr = &floor_ptr->o_list[this_o_idx];
 
                     /* Hack -- Preserve unknown artifacts */
@@ -450,7 +450,7 @@ void place_trees(PlayerType *player_ptr, POSITION x, POSITION y)
             if (g_ptr->info & CAVE_ICKY) {
                 continue;
             }
-            if (!g_ptr->o_idx_list.empty()) {
+            if (!floor_ptr->grid_array.o_idx_list(g_ptr).empty()) {
                 continue;
             }
 
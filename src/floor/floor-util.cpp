@@ -65,8 +65,8 @@ void update_smell(FloorType *floor_ptr, PlayerType *player_ptr)
     if (++scent_when == 254) {
         for (POSITION y = 0; y < floor_ptr->height; y++) {
             for (POSITION x = 0; x < floor_ptr->width; x++) {
-                int w = floor_ptr->grid_array[y][x].when;
-                floor_ptr->grid_array[y][x].when = (w > 128) ? (w - 128) : 0;
+                auto &when = floor_ptr->grid_array.when(y, x);
+                when = (when > 128) ? (when - 128) : 0;
             }
         }
 
@@ -93,7 +93,7 @@ void update_smell(FloorType *floor_ptr, PlayerType *player_ptr)
                 continue;
             }
 
-            g_ptr->when = scent_when + scent_adjust[i][j];
+            floor_ptr->grid_array.when(y, x) = static_cast<byte>(scent_when + scent_adjust[i][j]);
         }
     }
 }
@@ -103,13 +103,9 @@ void update_smell(FloorType *floor_ptr, PlayerType *player_ptr)
  */
 void forget_flow(FloorType *floor_ptr)
 {
-    for (POSITION y = 0; y < floor_ptr->height; y++) {
-        for (POSITION x = 0; x < floor_ptr->width; x++) {
-            memset(&floor_ptr->grid_array[y][x].costs, 0, sizeof(floor_ptr->grid_array[y][x].costs));
-            memset(&floor_ptr->grid_array[y][x].dists, 0, sizeof(floor_ptr->grid_array[y][x].dists));
-            floor_ptr->grid_array[y][x].when = 0;
-        }
-    }
+    floor_ptr->grid_array.clear_flow(0, 0, floor_ptr->height - 1, floor_ptr->width - 1);
+    floor_ptr->grid_array.clear_when(0, 0, floor_ptr->height - 1, floor_ptr->width - 1);
+    floor_ptr->reset_flow();
 }
 
 /*!
@@ -144,6 +140,7 @@ void wipe_o_list(FloorType *floor_ptr)
 
     floor_ptr->o_max = 1;
     floor_ptr->o_cnt = 0;
+    floor_ptr->o_slots.reset();
 }
 
 /*
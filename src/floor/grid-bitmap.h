@@ -0,0 +1,110 @@
+﻿#pragma once
+
+#include "floor/floor-base-definitions.h"
+#include "system/h-type.h"
+#include <array>
+#include <bitset>
+#include <cstdint>
+
+/*!
+ * @brief フロア全体の各グリッドに1ビットを割り当てたビットマップ
+ * @details
+ * 1行をWORDS_PER_ROW個の64ビット語に詰め、配列全体をキャッシュラインの境界に揃える.
+ * 生成時に必要な領域を確保するため、利用中にヒープ確保は行わない.
+ */
+class GridBitmap {
+public:
+    using word_type = uint64_t;
+    static constexpr int WORD_BITS = 64;
+    static constexpr int WORDS_PER_ROW = (MAX_WID + WORD_BITS - 1) / WORD_BITS;
+
+    bool test(POSITION y, POSITION x) const
+    {
+        return (this->words[index(y, x)] & bit(x)) != 0;
+    }
+
+    void set(POSITION y, POSITION x)
+    {
+        this->words[index(y, x)] |= bit(x);
+    }
+
+    void reset(POSITION y, POSITION x)
+    {
+        this->words[index(y, x)] &= ~bit(x);
+    }
+
+    void clear()
+    {
+        this->words.fill(0);
+    }
+
+    /*!
+     * @brief 指定した行範囲だけを消去する
+     * @param y1 最初の行
+     * @param y2 最後の行 (この行も含む)
+     */
+    void clear_rows(POSITION y1, POSITION y2)
+    {
+        for (auto y = y1; y <= y2; y++) {
+            for (auto i = 0; i < WORDS_PER_ROW; i++) {
+                this->words[y * WORDS_PER_ROW + i] = 0;
+            }
+        }
+    }
+
+    word_type word(POSITION y, int i) const
+    {
+        return this->words[y * WORDS_PER_ROW + i];
+    }
+
+    /*!
+     * @brief 2つのビットマップの差分を語単位で走査する
+     * @param before 変化前のビットマップ
+     * @param after 変化後のビットマップ
+     * @param y1 走査する最初の行
+     * @param y2 走査する最後の行 (この行も含む)
+     * @param on_set 変化後に立ったビットの座標(y, x)を受け取る関数
+     * @param on_reset 変化後に落ちたビットの座標(y, x)を受け取る関数
+     */
+    template <typename SetFunc, typename ResetFunc>
+    static void for_each_difference(const GridBitmap &before, const GridBitmap &after, POSITION y1, POSITION y2, SetFunc on_set, ResetFunc on_reset)
+    {
+        for (auto y = y1; y <= y2; y++) {
+            for (auto i = 0; i < WORDS_PER_ROW; i++) {
+                const auto old_word = before.word(y, i);
+                const auto new_word = after.word(y, i);
+                const auto diff = old_word ^ new_word;
+                if (diff == 0) {
+                    continue;
+                }
+
+                for_each_bit(diff & new_word, y, i, on_set);
+                for_each_bit(diff & old_word, y, i, on_reset);
+            }
+        }
+    }
+
+private:
+    alignas(64) std::array<word_type, MAX_HGT * WORDS_PER_ROW> words{};
+
+    static int index(POSITION y, POSITION x)
+    {
+        return y * WORDS_PER_ROW + x / WORD_BITS;
+    }
+
+    static word_type bit(POSITION x)
+    {
+        return word_type(1) << (x % WORD_BITS);
+    }
+
+    template <typename Func>
+    static void for_each_bit(word_type bits, POSITION y, int i, Func func)
+    {
+        while (bits != 0) {
+            const auto lowest = bits & (~bits + 1);
+            const auto x = static_cast<POSITION>(i * WORD_BITS + std::bitset<WORD_BITS>(lowest - 1).count());
+            func(y, x);
+            bits &= bits - 1;
+        }
+    }
+};
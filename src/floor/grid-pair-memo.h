@@ -0,0 +1,90 @@
+﻿#pragma once
+
+#include "system/floor-type-definition.h"
+#include "system/h-type.h"
+#include "world/world.h"
+#include <array>
+#include <cstdint>
+
+/*!
+ * @brief 2点間の地形判定 (視線・射線等) の結果を、ゲームターンと地形の版数が変わるまで覚えておく表
+ * @tparam SIZE 覚えておく結果の数 (2の冪)
+ * @details
+ * 始点・終点から位置を決める直接写像で、衝突した場合は上書きする.
+ * 射程のように結果を左右する値があれば、付加キーとして一緒に照合する.
+ * ダンジョンの生成中は地形の版数を上げずに地形を変えるため、生成が終わるまでは何も覚えない.
+ */
+template <int SIZE>
+class GridPairMemo {
+public:
+    static_assert((SIZE & (SIZE - 1)) == 0, "SIZE must be a power of 2");
+
+    /*!
+     * @brief 覚えている結果を探す
+     * @param floor 判定するフロア
+     * @param key 結果を左右する付加キー
+     * @return 見つかれば結果へのポインタ、無ければ (ダンジョンの生成中は常に) nullptr
+     */
+    const bool *find(const FloorType &floor, POSITION y1, POSITION x1, POSITION y2, POSITION x2, int key = 0)
+    {
+        if (!w_ptr->character_dungeon) {
+            return nullptr;
+        }
+
+        this->update_stamp(floor);
+        const auto &entry = this->entries[get_index(y1, x1, y2, x2)];
+        const auto is_hit = (entry.stamp == this->stamp) && (entry.y1 == y1) && (entry.x1 == x1) && (entry.y2 == y2) && (entry.x2 == x2) && (entry.key == key);
+        return is_hit ? &entry.result : nullptr;
+    }
+
+    /*!
+     * @brief 結果を覚える
+     * @details 直前の find() と同じフロアに対して呼ぶこと. ダンジョンの生成中は何もしない
+     */
+    void store(POSITION y1, POSITION x1, POSITION y2, POSITION x2, bool result, int key = 0)
+    {
+        if (!w_ptr->character_dungeon) {
+            return;
+        }
+
+        this->entries[get_index(y1, x1, y2, x2)] = { this->stamp, y1, x1, y2, x2, key, result };
+    }
+
+private:
+    struct Entry {
+        uint32_t stamp = 0;
+        POSITION y1 = 0;
+        POSITION x1 = 0;
+        POSITION y2 = 0;
+        POSITION x2 = 0;
+        int key = 0;
+        bool result = false;
+    };
+
+    std::array<Entry, SIZE> entries{};
+    uint32_t stamp = 0; //!< 有効な結果の印 (0は空きを表すので使わない)
+    const FloorType *floor_ptr = nullptr;
+    GAME_TURN game_turn = 0;
+    uint32_t terrain_version = 0;
+
+    /*!
+     * @brief フロア・ゲームターン・地形の版数のいずれかが変わっていたら、覚えている結果を全て無効にする
+     */
+    void update_stamp(const FloorType &floor)
+    {
+        if ((this->stamp != 0) && (this->floor_ptr == &floor) && (this->game_turn == w_ptr->game_turn) && (this->terrain_version == floor.terrain_version)) {
+            return;
+        }
+
+        this->stamp = (this->stamp == UINT32_MAX) ? 1 : this->stamp + 1;
+        this->floor_ptr = &floor;
+        this->game_turn = w_ptr->game_turn;
+        this->terrain_version = floor.terrain_version;
+    }
+
+    static int get_index(POSITION y1, POSITION x1, POSITION y2, POSITION x2)
+    {
+        const auto hash = ((static_cast<uint32_t>(y1) * 31 + x1) * 31 + y2) * 31 + x2;
+        return static_cast<int>(hash & (SIZE - 1));
+    }
+};
@@ -1,80 +1,48 @@
 ﻿#include "floor/line-of-sight.h"
 #include "floor/cave.h"
+#include "floor/grid-bitmap.h"
+#include "floor/grid-pair-memo.h"
 #include "system/floor-type-definition.h"
+#include "system/gamevalue.h"
+#include "system/grid-type-definition.h"
 #include "system/player-type-definition.h"
+#include "world/world.h"
+#include <algorithm>
+#include <vector>
+
+namespace {
+constexpr auto LOS_TABLE_RADIUS = MAX_PLAYER_SIGHT * 2; //!< 視線テーブルを用意する終点の相対座標の最大値
+constexpr auto LOS_MEMO_SIZE = 1024; //!< los() の結果を覚えておく数 (2の冪)
 
 /*!
- * @brief LOS(Line Of Sight / 視線が通っているか)の判定を行う。
- * @param player_ptr プレイヤーへの参照ポインタ
- * @param y1 始点のy座標
- * @param x1 始点のx座標
- * @param y2 終点のy座標
- * @param x2 終点のx座標
- * @return LOSが通っているならTRUEを返す。
- * @details
- * A simple, fast, integer-based line-of-sight algorithm.  By Joseph Hall,\n
- * 4116 Brewster Drive, Raleigh NC 27606.  Email to jnh@ecemwl.ncsu.edu.\n
- *\n
- * Returns TRUE if a line of sight can be traced from (x1,y1) to (x2,y2).\n
- *\n
- * The LOS begins at the center of the tile (x1,y1) and ends at the center of\n
- * the tile (x2,y2).  If los() is to return TRUE, all of the tiles this line\n
- * passes through must be floor tiles, except for (x1,y1) and (x2,y2).\n
- *\n
- * We assume that the "mathematical corner" of a non-floor tile does not\n
- * block line of sight.\n
- *\n
- * Because this function uses (short) ints for all calculations, overflow may\n
- * occur if dx and dy exceed 90.\n
- *\n
- * Once all the degenerate cases are eliminated, the values "qx", "qy", and\n
- * "m" are multiplied by a scale factor "f1 = abs(dx * dy * 2)", so that\n
- * we can use integer arithmetic.\n
- *\n
- * We travel from start to finish along the longer axis, starting at the border\n
- * between the first and second tiles, where the y offset = .5 * slope, taking\n
- * into account the scale factor.  See below.\n
- *\n
- * Also note that this function and the "move towards target" code do NOT\n
- * share the same properties.  Thus, you can see someone, target them, and\n
- * then fire a bolt at them, but the bolt may hit a wall, not them.  However\n,
- * by clever choice of target locations, you can sometimes throw a "curve".\n
- *\n
- * Note that "line of sight" is not "reflexive" in all cases.\n
- *\n
- * Use the "projectable()" routine to test "spell/missile line of sight".\n
- *\n
- * Use the "update_view()" function to determine player line-of-sight.\n
+ * @brief 視線が通るか判定するマスの、始点からの相対座標
  */
-bool los(PlayerType *player_ptr, POSITION y1, POSITION x1, POSITION y2, POSITION x2)
+struct LosStep {
+    int8_t dy;
+    int8_t dx;
+};
+
+/*!
+ * @brief 始点から相対座標 (dy, dx) の終点まで、視線が通過するマスを順に調べる
+ * @param dy 終点の相対Y座標
+ * @param dx 終点の相対X座標
+ * @param is_open 相対座標 (ty, tx) のマスが視線を通すかを返す関数
+ * @return 視線が通るならTRUE
+ * @details 判定の手順は los() の説明を参照のこと. 隣接マスまでの判定は呼び出し元で済ませておくこと.
+ */
+template <typename Func>
+bool trace_los(POSITION dy, POSITION dx, Func is_open)
 {
-    POSITION dy = y2 - y1;
-    POSITION dx = x2 - x1;
-    POSITION ay = std::abs(dy);
-    POSITION ax = std::abs(dx);
-    if ((ax < 2) && (ay < 2)) {
-        return true;
-    }
+    const auto ay = std::abs(dy);
+    const auto ax = std::abs(dx);
+    POSITION tx, ty;
 
     /* Directly South/North */
-    auto *floor_ptr = player_ptr->current_floor_ptr;
-    POSITION tx, ty;
     if (!dx) {
-        /* South -- check for walls */
-        if (dy > 0) {
-            for (ty = y1 + 1; ty < y2; ty++) {
-                if (!cave_los_bold(floor_ptr, ty, x1)) {
-                    return false;
-                }
-            }
-        }
-
-        /* North -- check for walls */
-        else {
-            for (ty = y1 - 1; ty > y2; ty--) {
-                if (!cave_los_bold(floor_ptr, ty, x1)) {
-                    return false;
-                }
+        const auto sy = (dy < 0) ? -1 : 1;
+        for (ty = sy; ty != dy; ty += sy) {
+            if (!is_open(ty, 0)) {
+                return false;
             }
         }
 
@@ -84,21 +52,10 @@ bool los(PlayerType *player_ptr, POSITION y1, POSITION x1, POSITION y2, POSITION
 
     /* Directly East/West */
     if (!dy) {
-        /* East -- check for walls */
-        if (dx > 0) {
-            for (tx = x1 + 1; tx < x2; tx++) {
-                if (!cave_los_bold(floor_ptr, y1, tx)) {
-                    return false;
-                }
-            }
-        }
-
-        /* West -- check for walls */
-        else {
-            for (tx = x1 - 1; tx > x2; tx--) {
-                if (!cave_los_bold(floor_ptr, y1, tx)) {
-                    return false;
-                }
+        const auto sx = (dx < 0) ? -1 : 1;
+        for (tx = sx; tx != dx; tx += sx) {
+            if (!is_open(0, tx)) {
+                return false;
             }
         }
 
@@ -110,13 +67,13 @@ bool los(PlayerType *player_ptr, POSITION y1, POSITION x1, POSITION y2, POSITION
 
     if (ax == 1) {
         if (ay == 2) {
-            if (cave_los_bold(floor_ptr, y1 + sy, x1)) {
+            if (is_open(sy, 0)) {
                 return true;
             }
         }
     } else if (ay == 1) {
         if (ax == 2) {
-            if (cave_los_bold(floor_ptr, y1, x1 + sx)) {
+            if (is_open(0, sx)) {
                 return true;
             }
         }
@@ -129,18 +86,18 @@ bool los(PlayerType *player_ptr, POSITION y1, POSITION x1, POSITION y2, POSITION
     if (ax >= ay) {
         qy = ay * ay;
         m = qy << 1;
-        tx = x1 + sx;
+        tx = sx;
         if (qy == f2) {
-            ty = y1 + sy;
+            ty = sy;
             qy -= f1;
         } else {
-            ty = y1;
+            ty = 0;
         }
 
         /* Note (below) the case (qy == f2), where */
         /* the LOS exactly meets the corner of a tile. */
-        while (x2 - tx) {
-            if (!cave_los_bold(floor_ptr, ty, tx)) {
+        while (dx - tx) {
+            if (!is_open(ty, tx)) {
                 return false;
             }
 
@@ -153,7 +110,7 @@ bool los(PlayerType *player_ptr, POSITION y1, POSITION x1, POSITION y2, POSITION
 
             if (qy > f2) {
                 ty += sy;
-                if (!cave_los_bold(floor_ptr, ty, tx)) {
+                if (!is_open(ty, tx)) {
                     return false;
                 }
                 qy -= f1;
@@ -172,18 +129,18 @@ bool los(PlayerType *player_ptr, POSITION y1, POSITION x1, POSITION y2, POSITION
     /* Travel vertically */
     POSITION qx = ax * ax;
     m = qx << 1;
-    ty = y1 + sy;
+    ty = sy;
     if (qx == f2) {
-        tx = x1 + sx;
+        tx = sx;
         qx -= f1;
     } else {
-        tx = x1;
+        tx = 0;
     }
 
     /* Note (below) the case (qx == f2), where */
     /* the LOS exactly meets the corner of a tile. */
-    while (y2 - ty) {
-        if (!cave_los_bold(floor_ptr, ty, tx)) {
+    while (dy - ty) {
+        if (!is_open(ty, tx)) {
             return false;
         }
 
@@ -196,7 +153,7 @@ bool los(PlayerType *player_ptr, POSITION y1, POSITION x1, POSITION y2, POSITION
 
         if (qx > f2) {
             tx += sx;
-            if (!cave_los_bold(floor_ptr, ty, tx)) {
+            if (!is_open(ty, tx)) {
                 return false;
             }
             qx -= f1;
@@ -211,3 +168,154 @@ bool los(PlayerType *player_ptr, POSITION y1, POSITION x1, POSITION y2, POSITION
 
     return true;
 }
+
+/*!
+ * @brief 終点の相対座標に対応する視線テーブルを返す
+ * @param ay 終点の相対Y座標の絶対値
+ * @param ax 終点の相対X座標の絶対値
+ * @return 視線が通るために、全て視線を通さなければならないマスの一覧 (第1象限の相対座標)
+ * @details
+ * 全てのマスが視線を通すとして trace_los() を辿り、判定したマスを記録する.
+ * 判定は象限について対称なので、第1象限の分だけを初回呼び出し時にまとめて作る.
+ * 桂馬跳びの位置は最初の1マスが通れば視線が通り、通らなければその時点で遮られるため、記録されるのはその1マスだけになる.
+ */
+const std::vector<LosStep> &get_los_ray(int ay, int ax)
+{
+    static std::vector<std::vector<LosStep>> rays;
+    if (rays.empty()) {
+        rays.resize((LOS_TABLE_RADIUS + 1) * (LOS_TABLE_RADIUS + 1));
+        for (auto y = 0; y <= LOS_TABLE_RADIUS; y++) {
+            for (auto x = 0; x <= LOS_TABLE_RADIUS; x++) {
+                if ((y < 2) && (x < 2)) {
+                    continue;
+                }
+
+                auto &ray = rays[y * (LOS_TABLE_RADIUS + 1) + x];
+                trace_los(y, x, [&ray](POSITION ty, POSITION tx) {
+                    ray.push_back({ static_cast<int8_t>(ty), static_cast<int8_t>(tx) });
+                    return true;
+                });
+            }
+        }
+    }
+
+    return rays[ay * (LOS_TABLE_RADIUS + 1) + ax];
+}
+
+/*!
+ * @brief 視線を遮るマスのビットマップ
+ * @details フロアか地形の版数が変わった時にだけ作り直す
+ */
+class LosBlockers {
+public:
+    const GridBitmap &get(const FloorType &floor)
+    {
+        if (this->is_valid && (this->floor_ptr == &floor) && (this->terrain_version == floor.terrain_version)) {
+            return this->bitmap;
+        }
+
+        this->bitmap.clear();
+        for (POSITION y = 0; y < floor.height; y++) {
+            for (POSITION x = 0; x < floor.width; x++) {
+                if (!feat_supports_los(floor.grid_array[y][x].feat)) {
+                    this->bitmap.set(y, x);
+                }
+            }
+        }
+
+        this->is_valid = true;
+        this->floor_ptr = &floor;
+        this->terrain_version = floor.terrain_version;
+        return this->bitmap;
+    }
+
+private:
+    GridBitmap bitmap;
+    bool is_valid = false;
+    const FloorType *floor_ptr = nullptr;
+    uint32_t terrain_version = 0;
+};
+
+LosBlockers los_blockers;
+GridPairMemo<LOS_MEMO_SIZE> los_memo;
+}
+
+/*!
+ * @brief LOS(Line Of Sight / 視線が通っているか)の判定を行う。
+ * @param player_ptr プレイヤーへの参照ポインタ
+ * @param y1 始点のy座標
+ * @param x1 始点のx座標
+ * @param y2 終点のy座標
+ * @param x2 終点のx座標
+ * @return LOSが通っているならTRUEを返す。
+ * @details
+ * A simple, fast, integer-based line-of-sight algorithm.  By Joseph Hall,\n
+ * 4116 Brewster Drive, Raleigh NC 27606.  Email to jnh@ecemwl.ncsu.edu.\n
+ *\n
+ * Returns TRUE if a line of sight can be traced from (x1,y1) to (x2,y2).\n
+ *\n
+ * The LOS begins at the center of the tile (x1,y1) and ends at the center of\n
+ * the tile (x2,y2).  If los() is to return TRUE, all of the tiles this line\n
+ * passes through must be floor tiles, except for (x1,y1) and (x2,y2).\n
+ *\n
+ * We assume that the "mathematical corner" of a non-floor tile does not\n
+ * block line of sight.\n
+ *\n
+ * Because this function uses (short) ints for all calculations, overflow may\n
+ * occur if dx and dy exceed 90.\n
+ *\n
+ * Once all the degenerate cases are eliminated, the values "qx", "qy", and\n
+ * "m" are multiplied by a scale factor "f1 = abs(dx * dy * 2)", so that\n
+ * we can use integer arithmetic.\n
+ *\n
+ * We travel from start to finish along the longer axis, starting at the border\n
+ * between the first and second tiles, where the y offset = .5 * slope, taking\n
+ * into account the scale factor.  See below.\n
+ *\n
+ * Also note that this function and the "move towards target" code do NOT\n
+ * share the same properties.  Thus, you can see someone, target them, and\n
+ * then fire a bolt at them, but the bolt may hit a wall, not them.  However\n,
+ * by clever choice of target locations, you can sometimes throw a "curve".\n
+ *\n
+ * Note that "line of sight" is not "reflexive" in all cases.\n
+ *\n
+ * Use the "projectable()" routine to test "spell/missile line of sight".\n
+ *\n
+ * Use the "update_view()" function to determine player line-of-sight.\n
+ *\n
+ * ダンジョン生成後は、事前に計算した視線テーブルと視線を遮るマスのビットマップで判定し、\n
+ * 同じゲームターンかつ地形が変わっていない間は結果を覚えておいて使い回す.\n
+ */
+bool los(PlayerType *player_ptr, POSITION y1, POSITION x1, POSITION y2, POSITION x2)
+{
+    const auto dy = y2 - y1;
+    const auto dx = x2 - x1;
+    const auto ay = std::abs(dy);
+    const auto ax = std::abs(dx);
+    if ((ax < 2) && (ay < 2)) {
+        return true;
+    }
+
+    auto *floor_ptr = player_ptr->current_floor_ptr;
+    if (!w_ptr->character_dungeon) {
+        return trace_los(dy, dx, [floor_ptr, y1, x1](POSITION ty, POSITION tx) { return cave_los_bold(floor_ptr, y1 + ty, x1 + tx); });
+    }
+
+    if (const auto *result = los_memo.find(*floor_ptr, y1, x1, y2, x2); result != nullptr) {
+        return *result;
+    }
+
+    bool is_los;
+    if ((ay <= LOS_TABLE_RADIUS) && (ax <= LOS_TABLE_RADIUS)) {
+        const auto &blockers = los_blockers.get(*floor_ptr);
+        const auto sy = (dy < 0) ? -1 : 1;
+        const auto sx = (dx < 0) ? -1 : 1;
+        const auto &ray = get_los_ray(ay, ax);
+        is_los = std::none_of(ray.begin(), ray.end(), [&blockers, y1, x1, sy, sx](const LosStep &step) { return blockers.test(y1 + step.dy * sy, x1 + step.dx * sx); });
+    } else {
+        is_los = trace_los(dy, dx, [floor_ptr, y1, x1](POSITION ty, POSITION tx) { return cave_los_bold(floor_ptr, y1 + ty, x1 + tx); });
+    }
+
+    los_memo.store(y1, x1, y2, x2, is_los);
+    return is_los;
+}
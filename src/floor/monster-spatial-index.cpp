@@ -0,0 +1,125 @@
+﻿#include "floor/monster-spatial-index.h"
+#include "floor/geometry.h"
+#include <algorithm>
+
+/*!
+ * @brief モンスターを索引へ加えるか、索引上の位置を移す
+ * @param m_idx モンスターID
+ * @param y 配置先のY座標
+ * @param x 配置先のX座標
+ */
+void MonsterSpatialIndex::place(MONSTER_IDX m_idx, POSITION y, POSITION x)
+{
+    if (m_idx <= 0) {
+        return;
+    }
+
+    if (static_cast<size_t>(m_idx) >= this->locations.size()) {
+        this->locations.resize(m_idx + 1);
+    }
+
+    const auto tile = get_tile(y, x);
+    auto &location = this->locations[m_idx];
+    if (location.tile != tile) {
+        this->remove(m_idx);
+        location.tile = tile;
+        location.slot = static_cast<int>(this->tiles[tile].size());
+        this->tiles[tile].push_back(m_idx);
+    }
+
+    location.y = y;
+    location.x = x;
+}
+
+/*!
+ * @brief モンスターを索引から除く
+ * @param m_idx モンスターID
+ * @details タイル内の末尾のモンスターを空いた場所へ詰める
+ */
+void MonsterSpatialIndex::remove(MONSTER_IDX m_idx)
+{
+    if ((m_idx <= 0) || (static_cast<size_t>(m_idx) >= this->locations.size())) {
+        return;
+    }
+
+    auto &location = this->locations[m_idx];
+    if (location.tile < 0) {
+        return;
+    }
+
+    auto &tile = this->tiles[location.tile];
+    const auto last_m_idx = tile.back();
+    tile[location.slot] = last_m_idx;
+    this->locations[last_m_idx].slot = location.slot;
+    tile.pop_back();
+    location.tile = -1;
+}
+
+/*!
+ * @brief 索引を空にする
+ * @details フロアの全モンスターを消去した時に呼ぶ
+ */
+void MonsterSpatialIndex::clear()
+{
+    for (auto &tile : this->tiles) {
+        tile.clear();
+    }
+
+    this->locations.clear();
+}
+
+/*!
+ * @brief 矩形内のモンスターを集める
+ * @param y1 矩形の上端のY座標
+ * @param x1 矩形の左端のX座標
+ * @param y2 矩形の下端のY座標
+ * @param x2 矩形の右端のX座標
+ * @param m_idxs モンスターIDを格納する配列 (モンスターIDの昇順に並べ替える)
+ */
+void MonsterSpatialIndex::collect_in_rect(POSITION y1, POSITION x1, POSITION y2, POSITION x2, std::vector<MONSTER_IDX> &m_idxs) const
+{
+    m_idxs.clear();
+    const auto tile_top = std::max(y1, 0) >> TILE_SHIFT;
+    const auto tile_bottom = std::min(y2, MAX_HGT - 1) >> TILE_SHIFT;
+    const auto tile_left = std::max(x1, 0) >> TILE_SHIFT;
+    const auto tile_right = std::min(x2, MAX_WID - 1) >> TILE_SHIFT;
+    for (auto ty = tile_top; ty <= tile_bottom; ty++) {
+        for (auto tx = tile_left; tx <= tile_right; tx++) {
+            for (const auto m_idx : this->tiles[ty * TILE_WID + tx]) {
+                const auto &location = this->locations[m_idx];
+                if ((location.y >= y1) && (location.y <= y2) && (location.x >= x1) && (location.x <= x2)) {
+                    m_idxs.push_back(m_idx);
+                }
+            }
+        }
+    }
+
+    std::sort(m_idxs.begin(), m_idxs.end());
+}
+
+/*!
+ * @brief 点からの距離が一定以下のモンスターを集める
+ * @param y 中心のY座標
+ * @param x 中心のX座標
+ * @param radius 距離の上限 (distance() による)
+ * @param m_idxs モンスターIDを格納する配列 (モンスターIDの昇順に並べ替える)
+ */
+void MonsterSpatialIndex::collect_in_radius(POSITION y, POSITION x, POSITION radius, std::vector<MONSTER_IDX> &m_idxs) const
+{
+    this->collect_in_rect(y - radius, x - radius, y + radius, x + radius, m_idxs);
+    const auto is_outside = [this, y, x, radius](MONSTER_IDX m_idx) {
+        const auto &location = this->locations[m_idx];
+        return distance(y, x, location.y, location.x) > radius;
+    };
+    m_idxs.erase(std::remove_if(m_idxs.begin(), m_idxs.end(), is_outside), m_idxs.end());
+}
+
+/*!
+ * @brief 座標の属するタイル番号を返す
+ */
+int MonsterSpatialIndex::get_tile(POSITION y, POSITION x)
+{
+    const auto ty = std::clamp(y, 0, MAX_HGT - 1) >> TILE_SHIFT;
+    const auto tx = std::clamp(x, 0, MAX_WID - 1) >> TILE_SHIFT;
+    return ty * TILE_WID + tx;
+}
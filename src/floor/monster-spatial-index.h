@@ -0,0 +1,43 @@
+﻿#pragma once
+
+#include "floor/floor-base-definitions.h"
+#include "system/angband.h"
+#include <array>
+#include <vector>
+
+/*!
+ * @brief フロアを粗いタイルに区切り、タイル毎にそこにいるモンスターを覚えておく空間索引
+ * @details
+ * 点の周囲や矩形内のモンスターを、フロアのモンスター数ではなく近くのモンスター数に比例した手間で探すために用いる.
+ * モンスターを配置・移動・削除する処理は、マスの m_idx と同じ箇所で索引も更新すること.
+ */
+class MonsterSpatialIndex {
+public:
+    MonsterSpatialIndex() = default;
+
+    void place(MONSTER_IDX m_idx, POSITION y, POSITION x);
+    void remove(MONSTER_IDX m_idx);
+    void clear();
+    void collect_in_rect(POSITION y1, POSITION x1, POSITION y2, POSITION x2, std::vector<MONSTER_IDX> &m_idxs) const;
+    void collect_in_radius(POSITION y, POSITION x, POSITION radius, std::vector<MONSTER_IDX> &m_idxs) const;
+
+private:
+    static constexpr auto TILE_SHIFT = 3; //!< タイルの一辺 (8マス) の2進桁数
+    static constexpr auto TILE_HGT = (MAX_HGT >> TILE_SHIFT) + 1;
+    static constexpr auto TILE_WID = (MAX_WID >> TILE_SHIFT) + 1;
+
+    /*!
+     * @brief モンスター毎の索引上の位置
+     */
+    struct Location {
+        int tile = -1; //!< タイル番号 (索引に無ければ-1)
+        int slot = 0; //!< タイル内の並び順
+        POSITION y = 0;
+        POSITION x = 0;
+    };
+
+    std::array<std::vector<MONSTER_IDX>, TILE_HGT * TILE_WID> tiles{};
+    std::vector<Location> locations;
+
+    static int get_tile(POSITION y, POSITION x);
+};
@@ -37,7 +37,7 @@ ITEM_NUMBER scan_floor_items(PlayerType *player_ptr, OBJECT_IDX *items, POSITION
     }
 
     ITEM_NUMBER num = 0;
-    for (const auto this_o_idx : floor_ptr->grid_array[y][x].o_idx_list) {
+    for (const auto this_o_idx : floor_ptr->grid_array.o_idx_list(y, x)) {
         ItemEntity *o_ptr;
         o_ptr = &floor_ptr->o_list[this_o_idx];
         if ((mode & SCAN_FLOOR_ITEM_TESTER) && !item_tester.okay(o_ptr)) {
@@ -44,6 +44,7 @@
 #include "system/player-type-definition.h"
 #include "system/system-variables.h"
 #include "system/terrain-type-definition.h"
+#include "term/z-rand.h"
 #include "util/bit-flags-calculator.h"
 #include "view/display-messages.h"
 #include "window/main-window-util.h"
@@ -259,6 +260,7 @@ static void generate_wilderness_area(FloorType *floor_ptr, int terrain, uint32_t
 
     const auto state_backup = w_ptr->rng.get_state();
     w_ptr->rng.set_state(seed);
+    const auto mapping_backup = Rand_set_legacy_mapping(true);
     int table_size = sizeof(terrain_table[0]) / sizeof(int16_t);
     if (!corner) {
         for (POSITION y1 = 0; y1 < MAX_HGT; y1++) {
@@ -278,6 +280,7 @@ static void generate_wilderness_area(FloorType *floor_ptr, int terrain, uint32_t
         floor_ptr->grid_array[1][MAX_WID - 2].feat = terrain_table[terrain][floor_ptr->grid_array[1][MAX_WID - 2].feat];
         floor_ptr->grid_array[MAX_HGT - 2][MAX_WID - 2].feat = terrain_table[terrain][floor_ptr->grid_array[MAX_HGT - 2][MAX_WID - 2].feat];
         w_ptr->rng.set_state(state_backup);
+        Rand_set_legacy_mapping(mapping_backup);
         return;
     }
 
@@ -298,6 +301,7 @@ static void generate_wilderness_area(FloorType *floor_ptr, int terrain, uint32_t
     }
 
     w_ptr->rng.set_state(state_backup);
+    Rand_set_legacy_mapping(mapping_backup);
 }
 
 /*!
@@ -383,11 +387,13 @@ static void generate_area(PlayerType *player_ptr, POSITION y, POSITION x, bool i
 
     const auto state_backup = w_ptr->rng.get_state();
     w_ptr->rng.set_state(wilderness[y][x].seed);
+    const auto mapping_backup = Rand_set_legacy_mapping(true);
     int dy = rand_range(6, floor_ptr->height - 6);
     int dx = rand_range(6, floor_ptr->width - 6);
     floor_ptr->grid_array[dy][dx].feat = feat_entrance;
     floor_ptr->grid_array[dy][dx].special = wilderness[y][x].entrance;
     w_ptr->rng.set_state(state_backup);
+    Rand_set_legacy_mapping(mapping_backup);
 }
 
 /*!
@@ -15,6 +15,7 @@
  */
 
 #include "grid/grid.h"
+#include "core/profiler.h"
 #include "core/window-redrawer.h"
 #include "dungeon/dungeon-flag-types.h"
 #include "dungeon/quest.h"
@@ -354,7 +355,7 @@ void note_spot(PlayerType *player_ptr, POSITION y, POSITION x)
     }
 
     /* Hack -- memorize objects */
-    for (const auto this_o_idx : g_ptr->o_idx_list) {
+    for (const auto this_o_idx : player_ptr->current_floor_ptr->grid_array.o_idx_list(g_ptr)) {
         auto *o_ptr = &player_ptr->current_floor_ptr->o_list[this_o_idx];
 
         /* Memorize objects */
@@ -646,13 +647,27 @@ void lite_spot(PlayerType *player_ptr, POSITION y, POSITION x)
  * Oh, and outside of the "torch radius", only "lite" grids need to be scanned.
  */
 
-/*
- * Hack - speed up the update_flow algorithm by only doing
- * it everytime the player moves out of LOS of the last
- * "way-point".
+/*!
+ * @brief 前回の流れ場を消去する
+ * @param floor_ptr フロアへの参照ポインタ
+ * @details 書き込んだ範囲が分かっていればその矩形だけを消去する.
+ * 流れ場は起点から MONSTER_FLOW_DEPTH 歩以内にしか広がらないため、広いフロアでも消去は局所的に済む.
  */
-static POSITION flow_x = 0;
-static POSITION flow_y = 0;
+static void erase_flow(FloorType *floor_ptr)
+{
+    auto &state = floor_ptr->flow_state;
+    const auto top = state.whole_floor ? 0 : state.top;
+    const auto bottom = state.whole_floor ? floor_ptr->height - 1 : state.bottom;
+    const auto left = state.whole_floor ? 0 : state.left;
+    const auto right = state.whole_floor ? floor_ptr->width - 1 : state.right;
+    floor_ptr->grid_array.clear_flow(top, left, bottom, right);
+
+    state.whole_floor = false;
+    state.top = floor_ptr->height;
+    state.bottom = -1;
+    state.left = floor_ptr->width;
+    state.right = -1;
+}
 
 /*
  * Hack -- fill in the "cost" field of every grid that the player
@@ -666,34 +681,44 @@ static POSITION flow_y = 0;
  *
  * We do not need a priority queue because the cost from grid
  * to grid is always "one" and we process them in order.
+ *
+ * The previous field is kept in the floor together with its origin and
+ * the rectangle it was written to.  If neither the player nor any terrain
+ * inside that rectangle has changed, the field is reused as is; otherwise
+ * only that rectangle is erased before the field is rebuilt.
  */
 void update_flow(PlayerType *player_ptr)
 {
+    ProfileScope profile_scope(ProfileSection::UPDATE_FLOW);
     POSITION x, y;
     DIRECTION d;
     FloorType *f_ptr = player_ptr->current_floor_ptr;
+    auto &state = f_ptr->flow_state;
 
-    /* The last way-point is on the map */
-    if (player_ptr->running && in_bounds(f_ptr, flow_y, flow_x)) {
+    /* Hack - only update the flow when the player moves out of LOS of the last "way-point" while running */
+    if (player_ptr->running && in_bounds(f_ptr, state.origin_y, state.origin_x)) {
         /* The way point is in sight - do not update.  (Speedup) */
-        if (f_ptr->grid_array[flow_y][flow_x].info & CAVE_VIEW) {
+        if (f_ptr->grid_array[state.origin_y][state.origin_x].info & CAVE_VIEW) {
             return;
         }
     }
 
-    /* Erase all of the current flow information */
-    for (y = 0; y < f_ptr->height; y++) {
-        for (x = 0; x < f_ptr->width; x++) {
-            memset(&f_ptr->grid_array[y][x].costs, 0, sizeof(f_ptr->grid_array[y][x].costs));
-            memset(&f_ptr->grid_array[y][x].dists, 0, sizeof(f_ptr->grid_array[y][x].dists));
-        }
+    /* Nothing has changed since the last computation */
+    if (state.valid && (state.origin_y == player_ptr->y) && (state.origin_x == player_ptr->x)) {
+        return;
     }
 
+    /* Erase the previous flow information */
+    erase_flow(f_ptr);
+
     /* Save player position */
-    flow_y = player_ptr->y;
-    flow_x = player_ptr->x;
+    state.origin_y = player_ptr->y;
+    state.origin_x = player_ptr->x;
 
+    auto &grid_array = f_ptr->grid_array;
     for (int i = 0; i < FLOW_MAX; i++) {
+        const auto flow = i2enum<flow_type>(i);
+
         // 幅優先探索用のキュー。
         std::queue<Pos2D> que;
         que.emplace(player_ptr->y, player_ptr->x);
@@ -706,8 +731,8 @@ void update_flow(PlayerType *player_ptr)
 
             /* Add the "children" */
             for (d = 0; d < 8; d++) {
-                byte m = player_ptr->current_floor_ptr->grid_array[ty][tx].costs[i] + 1;
-                byte n = player_ptr->current_floor_ptr->grid_array[ty][tx].dists[i] + 1;
+                byte m = grid_array.cost(flow, ty, tx) + 1;
+                byte n = grid_array.dist(flow, ty, tx) + 1;
 
                 /* Child location */
                 y = ty + ddy_ddd[d];
@@ -718,20 +743,22 @@ void update_flow(PlayerType *player_ptr)
                     continue;
                 }
 
-                auto *g_ptr = &player_ptr->current_floor_ptr->grid_array[y][x];
+                auto *g_ptr = &grid_array[y][x];
+                auto &cost = grid_array.cost(flow, y, x);
+                auto &dist = grid_array.dist(flow, y, x);
 
                 if (is_closed_door(player_ptr, g_ptr->feat)) {
                     m += 3;
                 }
 
                 /* Ignore "pre-stamped" entries */
-                if (g_ptr->dists[i] != 0 && g_ptr->dists[i] <= n && g_ptr->costs[i] <= m) {
+                if (dist != 0 && dist <= n && cost <= m) {
                     continue;
                 }
 
                 /* Ignore "walls", "holes" and "rubble" */
                 bool can_move = false;
-                switch (i) {
+                switch (flow) {
                 case FLOW_CAN_FLY:
                     can_move = g_ptr->cave_has_flag(TerrainCharacteristics::MOVE) || g_ptr->cave_has_flag(TerrainCharacteristics::CAN_FLY);
                     break;
@@ -745,13 +772,19 @@ void update_flow(PlayerType *player_ptr)
                 }
 
                 /* Save the flow cost */
-                if (g_ptr->costs[i] == 0 || g_ptr->costs[i] > m) {
-                    g_ptr->costs[i] = m;
+                if (cost == 0 || cost > m) {
+                    cost = m;
                 }
-                if (g_ptr->dists[i] == 0 || g_ptr->dists[i] > n) {
-                    g_ptr->dists[i] = n;
+                if (dist == 0 || dist > n) {
+                    dist = n;
                 }
 
+                /* Remember the written area */
+                state.top = std::min(state.top, y);
+                state.bottom = std::max(state.bottom, y);
+                state.left = std::min(state.left, x);
+                state.right = std::max(state.right, x);
+
                 /* Hack -- limit flow depth */
                 if (n == MONSTER_FLOW_DEPTH) {
                     continue;
@@ -762,6 +795,8 @@ void update_flow(PlayerType *player_ptr)
             }
         }
     }
+
+    state.valid = true;
 }
 
 /*
@@ -1098,6 +1133,7 @@ void place_bold(PlayerType *player_ptr, POSITION y, POSITION x, grid_bold_type g
 void set_cave_feat(FloorType *floor_ptr, POSITION y, POSITION x, FEAT_IDX feature_idx)
 {
     floor_ptr->grid_array[y][x].feat = feature_idx;
+    floor_ptr->notice_terrain_change(y, x);
 }
 
 /*!
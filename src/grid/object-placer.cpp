@@ -29,7 +29,7 @@ void place_gold(PlayerType *player_ptr, POSITION y, POSITION x)
     if (!cave_drop_bold(floor_ptr, y, x)) {
         return;
     }
-    if (!g_ptr->o_idx_list.empty()) {
+    if (!floor_ptr->grid_array.o_idx_list(g_ptr).empty()) {
         return;
     }
 
@@ -52,7 +52,7 @@ void place_gold(PlayerType *player_ptr, POSITION y, POSITION x)
 
     o_ptr->iy = y;
     o_ptr->ix = x;
-    g_ptr->o_idx_list.add(floor_ptr, o_idx);
+    floor_ptr->grid_array.o_idx_list(g_ptr).add(floor_ptr, o_idx);
 
     note_spot(player_ptr, y, x);
     lite_spot(player_ptr, y, x);
@@ -77,7 +77,7 @@ void place_object(PlayerType *player_ptr, POSITION y, POSITION x, BIT_FLAGS mode
     auto *g_ptr = &floor_ptr->grid_array[y][x];
     ItemEntity forge;
     ItemEntity *q_ptr;
-    if (!in_bounds(floor_ptr, y, x) || !cave_drop_bold(floor_ptr, y, x) || !g_ptr->o_idx_list.empty()) {
+    if (!in_bounds(floor_ptr, y, x) || !cave_drop_bold(floor_ptr, y, x) || !floor_ptr->grid_array.o_idx_list(g_ptr).empty()) {
         return;
     }
 
@@ -102,7 +102,7 @@ void place_object(PlayerType *player_ptr, POSITION y, POSITION x, BIT_FLAGS mode
 
     o_ptr->iy = y;
     o_ptr->ix = x;
-    g_ptr->o_idx_list.add(floor_ptr, o_idx);
+    floor_ptr->grid_array.o_idx_list(g_ptr).add(floor_ptr, o_idx);
 
     note_spot(player_ptr, y, x);
     lite_spot(player_ptr, y, x);
@@ -24,7 +24,7 @@ void place_random_stairs(PlayerType *player_ptr, POSITION y, POSITION x)
     grid_type *g_ptr;
     auto *floor_ptr = player_ptr->current_floor_ptr;
     g_ptr = &floor_ptr->grid_array[y][x];
-    if (!g_ptr->is_floor() || !g_ptr->o_idx_list.empty()) {
+    if (!g_ptr->is_floor() || !floor_ptr->grid_array.o_idx_list(g_ptr).empty()) {
         return;
     }
 
@@ -75,7 +75,7 @@ bool cave_valid_bold(FloorType *floor_ptr, POSITION y, POSITION x)
         return false;
     }
 
-    for (const auto this_o_idx : g_ptr->o_idx_list) {
+    for (const auto this_o_idx : floor_ptr->grid_array.o_idx_list(g_ptr)) {
         ItemEntity *o_ptr;
         o_ptr = &floor_ptr->o_list[this_o_idx];
         if (o_ptr->is_artifact()) {
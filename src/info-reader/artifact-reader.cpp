@@ -10,7 +10,6 @@
 #include "util/bit-flags-calculator.h"
 #include "util/enum-converter.h"
 #include "util/string-processor.h"
-#include "view/display-messages.h"
 
 /*!
  * @brief テキストトークンを走査してフラグを一つ得る(アーティファクト用) /
@@ -29,7 +28,7 @@ static bool grab_one_artifact_flag(ArtifactType *a_ptr, std::string_view what)
         return true;
     }
 
-    msg_format(_("未知の伝説のアイテム・フラグ '%s'。", "Unknown artifact flag '%s'."), what.data());
+    add_info_warning(_("未知の伝説のアイテム・フラグ '%s'。", "Unknown artifact flag '%s'."), what.data());
     return false;
 }
 
@@ -17,7 +17,6 @@
 #include "util/bit-flags-calculator.h"
 #include "util/enum-converter.h"
 #include "util/string-processor.h"
-#include "view/display-messages.h"
 
 /*!
  * @brief テキストトークンを走査してフラグを一つ得る(ベースアイテム用) /
@@ -36,7 +35,7 @@ static bool grab_one_baseitem_flag(BaseitemInfo *bii_ptr, std::string_view what)
         return true;
     }
 
-    msg_format(_("未知のアイテム・フラグ '%s'。", "Unknown object flag '%s'."), what.data());
+    add_info_warning(_("未知のアイテム・フラグ '%s'。", "Unknown object flag '%s'."), what.data());
     return false;
 }
 
@@ -12,7 +12,6 @@
 #include "term/gameterm.h"
 #include "util/bit-flags-calculator.h"
 #include "util/string-processor.h"
-#include "view/display-messages.h"
 
 /*! 地形タグ情報から地形IDを得られなかった場合にtrueを返す */
 static bool feat_tag_is_not_found = false;
@@ -30,7 +29,7 @@ static bool grab_one_feat_flag(TerrainType *f_ptr, std::string_view what)
         return true;
     }
 
-    msg_format(_("未知の地形フラグ '%s'。", "Unknown feature flag '%s'."), what.data());
+    add_info_warning(_("未知の地形フラグ '%s'。", "Unknown feature flag '%s'."), what.data());
     return false;
 }
 
@@ -49,7 +48,7 @@ static bool grab_one_feat_action(TerrainType *f_ptr, std::string_view what, int
         return true;
     }
 
-    msg_format(_("未知の地形アクション '%s'。", "Unknown feature action '%s'."), what.data());
+    add_info_warning(_("未知の地形アクション '%s'。", "Unknown feature action '%s'."), what.data());
     return false;
 }
 
@@ -455,7 +454,7 @@ static FEAT_IDX search_real_feat(std::string feat)
         }
     }
 
-    msg_format(_("未定義のタグ '%s'。", "%s is undefined."), feat.data());
+    add_info_warning(_("未定義のタグ '%s'。", "%s is undefined."), feat.data());
     return -1;
 }
 
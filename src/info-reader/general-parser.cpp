@@ -22,6 +22,19 @@
 
 dungeon_grid letter[255];
 
+/*!
+ * @brief 定義ファイルの1行を angband_header::checksum に加える
+ * @param checksum チェックサム
+ * @param line 行の文字列
+ */
+void add_info_checksum(byte &checksum, std::string_view line)
+{
+    for (size_t i = 0; i < line.size(); i++) {
+        checksum += static_cast<byte>(line[i]);
+        checksum ^= (1U << (i % 8));
+    }
+}
+
 /*!
  * @brief パース関数に基づいてデータファイルからデータを読み取る /
  * Initialize an "*_info" array, by parsing an ascii "template" file
@@ -52,11 +65,7 @@ errr init_info_txt(FILE *fp, char *buf, angband_header *head, Parser parse_info_
         }
 
         if (buf[0] != 'N' && buf[0] != 'D') {
-            int i;
-            for (i = 0; buf[i]; i++) {
-                head->checksum += (byte)buf[i];
-                head->checksum ^= (1U << (i % 8));
-            }
+            add_info_checksum(head->checksum, buf);
         }
 
         if ((err = parse_info_txt_line(buf, head)) != 0) {
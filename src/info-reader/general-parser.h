@@ -26,6 +26,7 @@ struct angband_header;
 class FloorType;
 
 using Parser = std::function<errr(std::string_view, angband_header *)>;
+void add_info_checksum(byte &checksum, std::string_view line);
 errr init_info_txt(FILE *fp, char *buf, angband_header *head, Parser parse_info_txt_line);
 parse_error_type parse_line_feature(FloorType *floor_ptr, char *buf);
 parse_error_type parse_line_building(char *buf);
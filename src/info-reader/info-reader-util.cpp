@@ -4,11 +4,30 @@
 #include "object-enchant/activation-info-table.h"
 #include "util/enum-converter.h"
 #include "util/string-processor.h"
-#include "view/display-messages.h"
+#include "term/z-form.h"
+#include <cstdarg>
 
 /* Help give useful error messages */
-int error_idx; /*!< データ読み込み/初期化時に汎用的にエラーコードを保存するグローバル変数 */
-int error_line; /*!< データ読み込み/初期化時に汎用的にエラー行数を保存するグローバル変数 */
+thread_local int error_idx; /*!< データ読み込み/初期化時に汎用的にエラーコードを保存するグローバル変数 */
+thread_local int error_line; /*!< データ読み込み/初期化時に汎用的にエラー行数を保存するグローバル変数 */
+thread_local std::vector<std::string> info_warnings; /*!< データ読み込み/初期化時の警告 */
+
+/*!
+ * @brief 定義ファイルの読み込み中の警告を記録する
+ * @param fmt 書式文字列
+ * @details
+ * 読み込みはワーカースレッドで行うため、メッセージ欄へは直接書き込まない.
+ * 記録した警告は init_info_tables() が読み込みを終えてからメインスレッドで表示する.
+ */
+void add_info_warning(std::string_view fmt, ...)
+{
+    va_list vp;
+    char buf[1024];
+    va_start(vp, fmt);
+    (void)vstrnfmt(buf, sizeof(buf), fmt.data(), vp);
+    va_end(vp);
+    info_warnings.emplace_back(buf);
+}
 
 /*!
  * @brief テキストトークンを走査してフラグを一つ得る(発動能力用) /
@@ -33,7 +52,7 @@ RandomArtActType grab_one_activation_flag(concptr what)
         return i2enum<RandomArtActType>(j);
     }
 
-    msg_format(_("未知の発動・フラグ '%s'。", "Unknown activation flag '%s'."), what);
+    add_info_warning(_("未知の発動・フラグ '%s'。", "Unknown activation flag '%s'."), what);
     return RandomArtActType::NONE;
 }
 
@@ -5,12 +5,16 @@
 #include <string>
 #include <string_view>
 #include <unordered_map>
+#include <vector>
 
 /*
  * Size of memory reserved for initialization of some arrays
  */
-extern int error_idx; //!< エラーが発生したinfo ID
-extern int error_line; //!< エラーが発生した行
+extern thread_local int error_idx; //!< エラーが発生したinfo ID (定義ファイルを並列に読み込むためスレッド毎に持つ)
+extern thread_local int error_line; //!< エラーが発生した行
+extern thread_local std::vector<std::string> info_warnings; //!< 読み込み中の警告 (読み込み後にメインスレッドで表示する)
+
+void add_info_warning(std::string_view fmt, ...);
 
 enum class RandomArtActType : short;
 RandomArtActType grab_one_activation_flag(concptr what);
@@ -7,9 +7,63 @@
 #include "player-ability/player-ability-types.h"
 #include "system/monster-race-info.h"
 #include "term/gameterm.h"
+#include "util/bit-flags-calculator.h"
 #include "util/enum-converter.h"
 #include "util/string-processor.h"
-#include "view/display-messages.h"
+#include <unordered_map>
+
+namespace {
+using MonsterFlagSetter = void (*)(MonsterRaceInfo &, uint32_t);
+
+/*!
+ * @brief フラグ名から引く、フラグの設定先と値
+ */
+struct MonsterFlagEntry {
+    MonsterFlagSetter set;
+    uint32_t value;
+};
+
+using MonsterFlagDictionary = std::unordered_map<std::string_view, MonsterFlagEntry>;
+
+template <typename Map>
+void register_flags(MonsterFlagDictionary &dict, const Map &names, MonsterFlagSetter set)
+{
+    for (const auto &[name, value] : names) {
+        dict.emplace(name, MonsterFlagEntry{ set, static_cast<uint32_t>(value) });
+    }
+}
+
+/*!
+ * @brief 基本フラグの全ての表を1つにまとめた辞書を返す
+ * @details
+ * フラグ1つ毎に十数個の表を順に引くと時間が掛かるため、初回に1つの表へまとめる.
+ * 複数の表に同じ名前がある場合は、先に登録した表を優先する.
+ */
+const MonsterFlagDictionary &get_basic_flag_dictionary()
+{
+    static const auto dict = [] {
+        MonsterFlagDictionary d;
+        register_flags(d, r_info_flags1, [](MonsterRaceInfo &r, uint32_t v) { set_bits(r.flags1, v); });
+        register_flags(d, r_info_flags2, [](MonsterRaceInfo &r, uint32_t v) { set_bits(r.flags2, v); });
+        register_flags(d, r_info_flags3, [](MonsterRaceInfo &r, uint32_t v) { set_bits(r.flags3, v); });
+        register_flags(d, r_info_flags7, [](MonsterRaceInfo &r, uint32_t v) { set_bits(r.flags7, v); });
+        register_flags(d, r_info_flags8, [](MonsterRaceInfo &r, uint32_t v) { set_bits(r.flags8, v); });
+        register_flags(d, r_info_flagsr, [](MonsterRaceInfo &r, uint32_t v) { r.resistance_flags.set(i2enum<MonsterResistanceType>(v)); });
+        register_flags(d, r_info_aura_flags, [](MonsterRaceInfo &r, uint32_t v) { r.aura_flags.set(i2enum<MonsterAuraType>(v)); });
+        register_flags(d, r_info_behavior_flags, [](MonsterRaceInfo &r, uint32_t v) { r.behavior_flags.set(i2enum<MonsterBehaviorType>(v)); });
+        register_flags(d, r_info_visual_flags, [](MonsterRaceInfo &r, uint32_t v) { r.visual_flags.set(i2enum<MonsterVisualType>(v)); });
+        register_flags(d, r_info_kind_flags, [](MonsterRaceInfo &r, uint32_t v) { r.kind_flags.set(i2enum<MonsterKindType>(v)); });
+        register_flags(d, r_info_drop_flags, [](MonsterRaceInfo &r, uint32_t v) { r.drop_flags.set(i2enum<MonsterDropType>(v)); });
+        register_flags(d, r_info_wilderness_flags, [](MonsterRaceInfo &r, uint32_t v) { r.wilderness_flags.set(i2enum<MonsterWildernessType>(v)); });
+        register_flags(d, r_info_feature_flags, [](MonsterRaceInfo &r, uint32_t v) { r.feature_flags.set(i2enum<MonsterFeatureType>(v)); });
+        register_flags(d, r_info_population_flags, [](MonsterRaceInfo &r, uint32_t v) { r.population_flags.set(i2enum<MonsterPopulationType>(v)); });
+        register_flags(d, r_info_speak_flags, [](MonsterRaceInfo &r, uint32_t v) { r.speak_flags.set(i2enum<MonsterSpeakType>(v)); });
+        register_flags(d, r_info_brightness_flags, [](MonsterRaceInfo &r, uint32_t v) { r.brightness_flags.set(i2enum<MonsterBrightnessType>(v)); });
+        return d;
+    }();
+    return dict;
+}
+}
 
 /*!
  * @brief テキストトークンを走査してフラグを一つ得る(モンスター用1) /
@@ -20,71 +74,13 @@
  */
 static bool grab_one_basic_flag(MonsterRaceInfo *r_ptr, std::string_view what)
 {
-    if (info_grab_one_flag(r_ptr->flags1, r_info_flags1, what)) {
+    const auto &dict = get_basic_flag_dictionary();
+    if (const auto it = dict.find(what); it != dict.end()) {
+        it->second.set(*r_ptr, it->second.value);
         return true;
     }
 
-    if (info_grab_one_flag(r_ptr->flags2, r_info_flags2, what)) {
-        return true;
-    }
-
-    if (info_grab_one_flag(r_ptr->flags3, r_info_flags3, what)) {
-        return true;
-    }
-
-    if (info_grab_one_flag(r_ptr->flags7, r_info_flags7, what)) {
-        return true;
-    }
-
-    if (info_grab_one_flag(r_ptr->flags8, r_info_flags8, what)) {
-        return true;
-    }
-
-    if (EnumClassFlagGroup<MonsterResistanceType>::grab_one_flag(r_ptr->resistance_flags, r_info_flagsr, what)) {
-        return true;
-    }
-
-    if (EnumClassFlagGroup<MonsterAuraType>::grab_one_flag(r_ptr->aura_flags, r_info_aura_flags, what)) {
-        return true;
-    }
-
-    if (EnumClassFlagGroup<MonsterBehaviorType>::grab_one_flag(r_ptr->behavior_flags, r_info_behavior_flags, what)) {
-        return true;
-    }
-
-    if (EnumClassFlagGroup<MonsterVisualType>::grab_one_flag(r_ptr->visual_flags, r_info_visual_flags, what)) {
-        return true;
-    }
-
-    if (EnumClassFlagGroup<MonsterKindType>::grab_one_flag(r_ptr->kind_flags, r_info_kind_flags, what)) {
-        return true;
-    }
-
-    if (EnumClassFlagGroup<MonsterDropType>::grab_one_flag(r_ptr->drop_flags, r_info_drop_flags, what)) {
-        return true;
-    }
-
-    if (EnumClassFlagGroup<MonsterWildernessType>::grab_one_flag(r_ptr->wilderness_flags, r_info_wilderness_flags, what)) {
-        return true;
-    }
-
-    if (EnumClassFlagGroup<MonsterFeatureType>::grab_one_flag(r_ptr->feature_flags, r_info_feature_flags, what)) {
-        return true;
-    }
-
-    if (EnumClassFlagGroup<MonsterPopulationType>::grab_one_flag(r_ptr->population_flags, r_info_population_flags, what)) {
-        return true;
-    }
-
-    if (EnumClassFlagGroup<MonsterSpeakType>::grab_one_flag(r_ptr->speak_flags, r_info_speak_flags, what)) {
-        return true;
-    }
-
-    if (EnumClassFlagGroup<MonsterBrightnessType>::grab_one_flag(r_ptr->brightness_flags, r_info_brightness_flags, what)) {
-        return true;
-    }
-
-    msg_format(_("未知のモンスター・フラグ '%s'。", "Unknown monster flag '%s'."), what.data());
+    add_info_warning(_("未知のモンスター・フラグ '%s'。", "Unknown monster flag '%s'."), what.data());
     return false;
 }
 
@@ -101,7 +97,7 @@ static bool grab_one_spell_flag(MonsterRaceInfo *r_ptr, std::string_view what)
         return true;
     }
 
-    msg_format(_("未知のモンスター・フラグ '%s'。", "Unknown monster flag '%s'."), what.data());
+    add_info_warning(_("未知のモンスター・フラグ '%s'。", "Unknown monster flag '%s'."), what.data());
     return false;
 }
 
@@ -273,10 +269,9 @@ errr parse_monraces_info(std::string_view buf, angband_header *)
 
         const auto &flags = str_split(tokens[1], '|', true, 10);
         for (const auto &f : flags) {
-
-            const auto &s_tokens = str_split(f, '_', false, 2);
-            if (s_tokens.size() == 2 && s_tokens[0] == "PERHP") {
-                info_set_value(r_ptr->cur_hp_per, s_tokens[1]);
+            constexpr std::string_view perhp_prefix = "PERHP_";
+            if (f.compare(0, perhp_prefix.length(), perhp_prefix) == 0) {
+                info_set_value(r_ptr->cur_hp_per, f.substr(perhp_prefix.length()));
                 continue;
             }
 
@@ -253,7 +253,7 @@ bool get_item(PlayerType *player_ptr, OBJECT_IDX *cp, concptr pmt, concptr str,
     }
 
     if (item_selection_ptr->floor) {
-        for (const auto this_o_idx : player_ptr->current_floor_ptr->grid_array[player_ptr->y][player_ptr->x].o_idx_list) {
+        for (const auto this_o_idx : player_ptr->current_floor_ptr->grid_array.o_idx_list(player_ptr->y, player_ptr->x)) {
             ItemEntity *o_ptr;
             o_ptr = &player_ptr->current_floor_ptr->o_list[this_o_idx];
             if ((item_tester.okay(o_ptr) || (item_selection_ptr->mode & USE_FULL)) && o_ptr->marked.has(OmType::FOUND)) {
@@ -499,7 +499,7 @@ bool get_item(PlayerType *player_ptr, OBJECT_IDX *cp, concptr pmt, concptr str,
         }
         case '-': {
             if (item_selection_ptr->allow_floor) {
-                for (const auto this_o_idx : player_ptr->current_floor_ptr->grid_array[player_ptr->y][player_ptr->x].o_idx_list) {
+                for (const auto this_o_idx : player_ptr->current_floor_ptr->grid_array.o_idx_list(player_ptr->y, player_ptr->x)) {
                     ItemEntity *o_ptr;
                     o_ptr = &player_ptr->current_floor_ptr->o_list[this_o_idx];
                     if (!item_tester.okay(o_ptr) && !(item_selection_ptr->mode & USE_FULL)) {
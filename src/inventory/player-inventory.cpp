@@ -90,7 +90,7 @@ void py_pickup_floor(PlayerType *player_ptr, bool pickup)
     int floor_num = 0;
     OBJECT_IDX floor_o_idx = 0;
     int can_pickup = 0;
-    auto &o_idx_list = player_ptr->current_floor_ptr->grid_array[player_ptr->y][player_ptr->x].o_idx_list;
+    auto &o_idx_list = player_ptr->current_floor_ptr->grid_array.o_idx_list(player_ptr->y, player_ptr->x);
     for (auto it = o_idx_list.begin(); it != o_idx_list.end();) {
         const OBJECT_IDX this_o_idx = *it++;
         o_ptr = &player_ptr->current_floor_ptr->o_list[this_o_idx];
@@ -258,7 +258,8 @@ void carry(PlayerType *player_ptr, bool pickup)
         return;
     }
 
-    for (auto it = g_ptr->o_idx_list.begin(); it != g_ptr->o_idx_list.end();) {
+    auto &o_idx_list = player_ptr->current_floor_ptr->grid_array.o_idx_list(g_ptr);
+    for (auto it = o_idx_list.begin(); it != o_idx_list.end();) {
         const OBJECT_IDX this_o_idx = *it++;
         ItemEntity *o_ptr;
         o_ptr = &player_ptr->current_floor_ptr->o_list[this_o_idx];
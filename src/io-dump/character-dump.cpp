@@ -121,8 +121,7 @@ static void dump_aux_quest(PlayerType *player_ptr, FILE *fff)
     for (const auto &[q_idx, q_ref] : quest_list) {
         quest_numbers.push_back(q_idx);
     }
-    int dummy;
-    ang_sort(player_ptr, quest_numbers.data(), &dummy, quest_numbers.size(), ang_sort_comp_quest_num, ang_sort_swap_quest_num);
+    ang_sort(quest_numbers, ang_sort_comp_quest_num);
 
     fputc('\n', fff);
     do_cmd_knowledge_quests_completed(player_ptr, fff, quest_numbers);
@@ -302,7 +301,7 @@ static void dump_aux_arena(PlayerType *player_ptr, FILE *fff)
  * @brief 撃破モンスターの情報をファイルにダンプする
  * @param fff ファイルポインタ
  */
-static void dump_aux_monsters(PlayerType *player_ptr, FILE *fff)
+static void dump_aux_monsters(FILE *fff)
 {
     fprintf(fff, _("\n  [倒したモンスター]\n\n", "\n  [Defeated Monsters]\n\n"));
 
@@ -361,7 +360,7 @@ static void dump_aux_monsters(PlayerType *player_ptr, FILE *fff)
 #endif
 
     /* Sort the array by dungeon depth of monsters */
-    ang_sort(player_ptr, who.data(), &why, uniq_total, ang_sort_comp_hook, ang_sort_swap_hook);
+    ang_sort(who, [why](auto r_idx1, auto r_idx2) { return ang_sort_comp_hook(r_idx1, r_idx2, why); });
     fprintf(fff, _("\n《上位%d体のユニーク・モンスター》\n", "\n< Unique monsters top %d >\n"), std::min(uniq_total, 10));
 
     char buf[80];
@@ -599,7 +598,7 @@ void make_character_dump(PlayerType *player_ptr, FILE *fff)
     dump_aux_recall(fff);
     dump_aux_quest(player_ptr, fff);
     dump_aux_arena(player_ptr, fff);
-    dump_aux_monsters(player_ptr, fff);
+    dump_aux_monsters(fff);
     dump_aux_virtues(player_ptr, fff);
     dump_aux_race_history(player_ptr, fff);
     dump_aux_realm_history(player_ptr, fff);
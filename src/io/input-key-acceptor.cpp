@@ -1,5 +1,6 @@
 ﻿#include "io/input-key-acceptor.h"
 #include "cmd-io/macro-util.h"
+#include "core/profiler.h"
 #include "core/stuff-handler.h"
 #include "core/window-redrawer.h"
 #include "game-option/input-options.h"
@@ -211,6 +212,7 @@ char inkey(bool do_all_term_refresh)
         return ch;
     }
 
+    ProfilePause profile_pause;
     inkey_next = nullptr;
     if (inkey_xtra) {
         parse_macro = false;
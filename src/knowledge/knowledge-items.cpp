@@ -64,7 +64,7 @@ void do_cmd_knowledge_artifacts(PlayerType *player_ptr)
     for (POSITION y = 0; y < player_ptr->current_floor_ptr->height; y++) {
         for (POSITION x = 0; x < player_ptr->current_floor_ptr->width; x++) {
             auto *g_ptr = &player_ptr->current_floor_ptr->grid_array[y][x];
-            for (const auto this_o_idx : g_ptr->o_idx_list) {
+            for (const auto this_o_idx : player_ptr->current_floor_ptr->grid_array.o_idx_list(g_ptr)) {
                 ItemEntity *o_ptr;
                 o_ptr = &player_ptr->current_floor_ptr->o_list[this_o_idx];
                 if (!o_ptr->is_fixed_artifact()) {
@@ -97,7 +97,7 @@ void do_cmd_knowledge_artifacts(PlayerType *player_ptr)
     std::vector<FixedArtifactId> whats(known_list.begin(), known_list.end());
 
     uint16_t why = 3;
-    ang_sort(player_ptr, whats.data(), &why, whats.size(), ang_sort_art_comp, ang_sort_art_swap);
+    ang_sort(whats, [why](auto id1, auto id2) { return ang_sort_art_comp(id1, id2, why); });
     for (auto a_idx : whats) {
         const auto &a_ref = artifacts_info.at(a_idx);
         GAME_TEXT base_name[MAX_NLEN];
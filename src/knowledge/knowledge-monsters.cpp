@@ -99,8 +99,7 @@ static std::vector<MonsterRaceId> collect_monsters(PlayerType *player_ptr, IDX g
         }
     }
 
-    int dummy_why;
-    ang_sort(player_ptr, r_idx_list.data(), &dummy_why, r_idx_list.size(), ang_sort_comp_monster_level, ang_sort_swap_hook);
+    ang_sort(r_idx_list, ang_sort_comp_monster_level);
     return r_idx_list;
 }
 
@@ -194,7 +193,7 @@ void do_cmd_knowledge_kill_count(PlayerType *player_ptr)
 
     uint16_t why = 2;
     char buf[80];
-    ang_sort(player_ptr, who.data(), &why, who.size(), ang_sort_comp_hook, ang_sort_swap_hook);
+    ang_sort(who, [why](auto r_idx1, auto r_idx2) { return ang_sort_comp_hook(r_idx1, r_idx2, why); });
     for (auto r_idx : who) {
         auto *r_ptr = &monraces_info[r_idx];
         if (r_ptr->kind_flags.has(MonsterKindType::UNIQUE)) {
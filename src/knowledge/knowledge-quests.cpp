@@ -329,8 +329,7 @@ void do_cmd_knowledge_quests(PlayerType *player_ptr)
     for (const auto &[q_idx, q_ref] : quest_list) {
         quest_numbers.push_back(q_idx);
     }
-    int dummy;
-    ang_sort(player_ptr, quest_numbers.data(), &dummy, quest_numbers.size(), ang_sort_comp_quest_num, ang_sort_swap_quest_num);
+    ang_sort(quest_numbers, ang_sort_comp_quest_num);
 
     do_cmd_knowledge_quests_current(player_ptr, fff);
     fputc('\n', fff);
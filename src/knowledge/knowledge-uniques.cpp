@@ -175,7 +175,7 @@ void do_cmd_knowledge_uniques(PlayerType *player_ptr, bool is_alive)
         unique_list_ptr->who.push_back(r_ref.idx);
     }
 
-    ang_sort(player_ptr, unique_list_ptr->who.data(), &unique_list_ptr->why, unique_list_ptr->who.size(), ang_sort_comp_hook, ang_sort_swap_hook);
+    ang_sort(unique_list_ptr->who, [why = unique_list_ptr->why](auto r_idx1, auto r_idx2) { return ang_sort_comp_hook(r_idx1, r_idx2, why); });
     display_uniques(unique_list_ptr, fff);
     angband_fclose(fff);
     concptr title_desc = unique_list_ptr->is_alive ? _("まだ生きているユニーク・モンスター", "Alive Uniques") : _("もう撃破したユニーク・モンスター", "Dead Uniques");
@@ -195,6 +195,7 @@ errr rd_saved_floor(PlayerType *player_ptr, saved_floor_type *sf_ptr)
         monster_loader->rd_monster(m_ptr);
         auto *g_ptr = &floor_ptr->grid_array[m_ptr->fy][m_ptr->fx];
         g_ptr->m_idx = m_idx;
+        floor_ptr->m_spatial_index.place(m_idx, m_ptr->fy, m_ptr->fx);
         m_ptr->get_real_r_ref().cur_num++;
     }
 
@@ -275,6 +276,7 @@ bool load_floor(PlayerType *player_ptr, saved_floor_type *sf_ptr, BIT_FLAGS mode
     byte old_h_ver_extra = 0;
     uint32_t old_loading_savefile_version = 0;
     if (mode & SLF_SECOND) {
+        rewind_loading_savefile();
         old_fff = loading_savefile;
         old_xor_byte = load_xor_byte;
         old_v_check = v_check;
@@ -304,6 +306,7 @@ bool load_floor(PlayerType *player_ptr, saved_floor_type *sf_ptr, BIT_FLAGS mode
             is_save_successful = false;
         }
 
+        rewind_loading_savefile();
         angband_fclose(loading_savefile);
         safe_setuid_grab(player_ptr);
         if (!(mode & SLF_NO_KILL)) {
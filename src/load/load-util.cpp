@@ -1,6 +1,7 @@
 ﻿#include "load/load-util.h"
 #include "locale/japanese.h"
 #include "term/screen-processor.h"
+#include <array>
 
 FILE *loading_savefile;
 uint32_t loading_savefile_version;
@@ -17,6 +18,16 @@ uint32_t x_check = 0L; // Simple "checksum" on the encoded bytes.
  */
 byte kanji_code = 0;
 
+/*!
+ * @brief 読み込みバッファの大きさ
+ */
+constexpr auto LOAD_BUFFER_SIZE = 65536U;
+
+static std::array<byte, LOAD_BUFFER_SIZE> load_buffer; /* Raw bytes read ahead from the file */
+static size_t load_buffer_pos = 0;
+static size_t load_buffer_len = 0;
+static size_t load_buffer_file_len = 0; /* Number of bytes in the buffer actually read from the file */
+
 /*!
  * @brief ゲームスクリーンにメッセージを表示する / Hack -- Show information on the screen, one line at a time.
  * @param msg 表示文字列
@@ -43,15 +54,70 @@ void load_note(concptr msg)
  */
 byte sf_get(void)
 {
-    byte c = getc(loading_savefile) & 0xFF;
-    byte v = c ^ load_xor_byte;
-    load_xor_byte = c;
-
-    v_check += v;
-    x_check += load_xor_byte;
+    byte v;
+    sf_get(&v, 1);
     return v;
 }
 
+/*!
+ * @brief ロードファイルポインタから複数バイトをまとめて読み込み復号する
+ * @param values 復号したバイト列の格納先
+ * @param size 読み込むバイト数
+ * @details
+ * ファイルからはバッファ単位で読み込み、1バイトずつ読んだ場合と同じ XOR 連鎖とチェックサムを維持する.
+ * ファイル終端以降は getc() が EOF を返した場合と同じく 0xFF を読んだものとして扱う.
+ */
+void sf_get(byte *values, size_t size)
+{
+    while (size > 0) {
+        if (load_buffer_pos == load_buffer_len) {
+            load_buffer_pos = 0;
+            load_buffer_len = fread(load_buffer.data(), 1, LOAD_BUFFER_SIZE, loading_savefile);
+            load_buffer_file_len = load_buffer_len;
+            if (load_buffer_len == 0) {
+                load_buffer_len = std::min<size_t>(size, LOAD_BUFFER_SIZE);
+                std::fill_n(load_buffer.begin(), load_buffer_len, 0xFF);
+            }
+        }
+
+        const auto length = std::min(size, load_buffer_len - load_buffer_pos);
+        const auto *encoded = &load_buffer[load_buffer_pos];
+        auto xor_byte = load_xor_byte;
+        auto value_sum = v_check;
+        auto encoded_sum = x_check;
+        for (size_t i = 0; i < length; i++) {
+            values[i] = encoded[i] ^ xor_byte;
+            xor_byte = encoded[i];
+            value_sum += values[i];
+            encoded_sum += encoded[i];
+        }
+
+        load_xor_byte = xor_byte;
+        v_check = value_sum;
+        x_check = encoded_sum;
+        load_buffer_pos += length;
+        values += length;
+        size -= length;
+    }
+}
+
+/*!
+ * @brief 先読みしたまま未使用のバイトをファイルへ戻す
+ * @details ファイルの読み込み位置を実際に読み終えた位置に合わせ、バッファを空にする.
+ * ファイルを閉じる前や、入れ子の読み込みでファイルを切り替える前に必ず呼ぶこと.
+ */
+void rewind_loading_savefile()
+{
+    if ((load_buffer_file_len > load_buffer_pos) && (loading_savefile != nullptr)) {
+        const auto unread = static_cast<long>(load_buffer_file_len - load_buffer_pos);
+        (void)fseek(loading_savefile, -unread, SEEK_CUR);
+    }
+
+    load_buffer_pos = 0;
+    load_buffer_len = 0;
+    load_buffer_file_len = 0;
+}
+
 /*!
  * @brief ロードファイルポインタからbool値を読み込む
  */
@@ -73,8 +139,10 @@ byte rd_byte()
  */
 uint16_t rd_u16b()
 {
-    uint16_t val = sf_get();
-    val |= (static_cast<uint16_t>(sf_get()) << 8);
+    byte values[2];
+    sf_get(values, sizeof(values));
+    uint16_t val = values[0];
+    val |= (static_cast<uint16_t>(values[1]) << 8);
 
     return val;
 }
@@ -92,10 +160,12 @@ int16_t rd_s16b()
  */
 uint32_t rd_u32b()
 {
-    uint32_t val = sf_get();
-    val |= (static_cast<uint32_t>(sf_get()) << 8);
-    val |= (static_cast<uint32_t>(sf_get()) << 16);
-    val |= (static_cast<uint32_t>(sf_get()) << 24);
+    byte values[4];
+    sf_get(values, sizeof(values));
+    uint32_t val = values[0];
+    val |= (static_cast<uint32_t>(values[1]) << 8);
+    val |= (static_cast<uint32_t>(values[2]) << 16);
+    val |= (static_cast<uint32_t>(values[3]) << 24);
 
     return val;
 }
@@ -175,8 +245,11 @@ void rd_string(std::string &str, int max)
  */
 void strip_bytes(int n)
 {
-    while (n-- > 0) {
-        (void)rd_byte();
+    byte values[256];
+    while (n > 0) {
+        const auto length = std::min<int>(n, sizeof(values));
+        sf_get(values, length);
+        n -= length;
     }
 }
 
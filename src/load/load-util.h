@@ -15,6 +15,8 @@ extern byte kanji_code;
 
 void load_note(concptr msg);
 byte sf_get(void);
+void sf_get(byte *values, size_t size);
+void rewind_loading_savefile();
 bool rd_bool();
 byte rd_byte();
 uint16_t rd_u16b();
@@ -280,10 +280,12 @@ static errr rd_savefile(PlayerType *player_ptr)
             err = -1;
         }
 
+        rewind_loading_savefile();
         angband_fclose(loading_savefile);
         return err;
     } catch (SaveDataNotSupportedException const &e) {
         msg_print(e.what());
+        rewind_loading_savefile();
         angband_fclose(loading_savefile);
         return 1;
     }
@@ -766,6 +766,7 @@ errr rd_dungeon_old(PlayerType *player_ptr)
         monster_loader->rd_monster(m_ptr);
         auto *g_ptr = &floor_ptr->grid_array[m_ptr->fy][m_ptr->fx];
         g_ptr->m_idx = m_idx;
+        floor_ptr->m_spatial_index.place(m_idx, m_ptr->fy, m_ptr->fx);
         m_ptr->get_real_r_ref().cur_num++;
     }
 
@@ -522,8 +522,7 @@ void guess_convert_to_system_encoding(char *strbuf, int buflen)
     }
 
     if (is_utf8_str(strbuf)) {
-        std::vector<char> work(buflen);
-        angband_strcpy(work.data(), strbuf, buflen);
+        std::vector<char> work(strbuf, strbuf + strlen(strbuf) + 1);
         if (!utf8_to_sys(work.data(), strbuf, buflen)) {
             msg_print("警告:文字コードの変換に失敗しました");
             msg_print(nullptr);
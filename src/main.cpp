@@ -8,6 +8,7 @@
 
 #include "core/asking-player.h"
 #include "core/game-play.h"
+#include "core/game-simulator.h"
 #include "core/scores.h"
 #include "game-option/runtime-arguments.h"
 #include "io/files-util.h"
@@ -29,6 +30,7 @@
 #include "wizard/spoiler-util.h"
 #include "wizard/wizard-spoiler.h"
 #include <string>
+#include <string_view>
 
 /*
  * Available graphic modes
@@ -260,6 +262,14 @@ static void display_usage(const char *program)
     puts("  -d<def>  Define a 'lib' dir sub-path");
     puts("  --output-spoilers");
     puts("           Output auto generated spoilers and exit");
+    puts("  --simulate[=<turns>]");
+    puts("           Play <turns> game turns without a display and report the speed");
+    puts("  --simulate-seed=<seed>  Random seed of the simulation");
+    puts("  --simulate-keys=<keys>  Repeat <keys> instead of random input");
+    puts("  --simulate-floors=<n>   Jump to a random floor every <n> key inputs");
+    puts("  --simulate-verify-floors  Read back every saved floor and compare it");
+    puts("  --simulate-crowd=<n>    Then fill the floor with up to <n> monsters");
+    puts("                          and time update_monsters() serial vs. pool");
     puts("");
 
 #ifdef USE_X11
@@ -288,14 +298,68 @@ static void display_usage(const char *program)
     quit(nullptr);
 }
 
+static bool simulation_requested = false;
+static SimulationOptions simulation_options;
+
+/*
+ * @brief シミュレーションモードのコマンドライン引数を解釈する
+ * @param opt 先頭の"--"を除いたコマンドライン引数
+ * @return シミュレーションモードの引数だったか否か
+ */
+static bool parse_simulation_opt(std::string_view opt)
+{
+    const auto pos = opt.find('=');
+    const auto name = opt.substr(0, pos);
+    const auto value = (pos == std::string_view::npos) ? std::string() : std::string(opt.substr(pos + 1));
+    if (name == "simulate") {
+        simulation_requested = true;
+        if (!value.empty()) {
+            simulation_options.turns = atoi(value.data());
+        }
+
+        return true;
+    }
+
+    if (name == "simulate-seed") {
+        simulation_options.seed = static_cast<uint32_t>(strtoul(value.data(), nullptr, 10));
+        return true;
+    }
+
+    if (name == "simulate-keys") {
+        simulation_options.keys = value;
+        return true;
+    }
+
+    if (name == "simulate-floors") {
+        simulation_options.floor_interval = atoi(value.data());
+        return true;
+    }
+
+    if (name == "simulate-verify-floors") {
+        simulation_options.verify_floors = true;
+        return true;
+    }
+
+    if (name == "simulate-crowd") {
+        simulation_options.crowd_size = atoi(value.data());
+        return true;
+    }
+
+    return false;
+}
+
 /*
  * @brief 2文字以上のコマンドライン引数 (オプション)を実行する
  * @param opt コマンドライン引数
  * @return Usageを表示する必要があるか否か
- * @details v3.0.0 Alpha21時点では、スポイラー出力モードの判定及び実行を行う
+ * @details スポイラー出力モードの判定及び実行と、シミュレーションモードの設定を行う
  */
 static bool parse_long_opt(const char *opt)
 {
+    if (parse_simulation_opt(opt + 2)) {
+        return false;
+    }
+
     if (strcmp(opt + 2, "output-spoilers") != 0) {
         return true;
     }
@@ -516,6 +580,13 @@ int main(int argc, char *argv[])
     /* Install "quit" hook */
     quit_aux = quit_hook;
 
+    /* Use the display-less terminal for the simulation */
+    if (simulation_requested) {
+        init_simulation(simulation_options);
+        ANGBAND_SYS = "headless";
+        done = true;
+    }
+
 #ifdef USE_X11
     /* Attempt to use the "main-x11.c" support */
     if (!done && (!mstr || (streq(mstr, "x11")))) {
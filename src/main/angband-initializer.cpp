@@ -269,56 +269,18 @@ void init_angband(PlayerType *player_ptr, bool no_term)
         quit(_("その他の変数を初期化できません", "Cannot initialize misc. values"));
     }
 
-    init_note(_("[データの初期化中... (地形)]", "[Initializing arrays... (features)]"));
-    if (init_terrains_info()) {
-        quit(_("地形初期化不能", "Cannot initialize features"));
-    }
-
+    init_note(_("[データの初期化中... (定義ファイル)]", "[Initializing arrays... (definition files)]"));
+    init_info_tables();
     if (init_feat_variables()) {
         quit(_("地形初期化不能", "Cannot initialize features"));
     }
 
-    init_note(_("[データの初期化中... (アイテム)]", "[Initializing arrays... (objects)]"));
-    if (init_baseitems_info()) {
-        quit(_("アイテム初期化不能", "Cannot initialize objects"));
-    }
-
-    init_note(_("[データの初期化中... (伝説のアイテム)]", "[Initializing arrays... (artifacts)]"));
-    if (init_artifacts_info()) {
-        quit(_("伝説のアイテム初期化不能", "Cannot initialize artifacts"));
-    }
-
-    init_note(_("[データの初期化中... (名のあるアイテム)]", "[Initializing arrays... (ego-items)]"));
-    if (init_egos_info()) {
-        quit(_("名のあるアイテム初期化不能", "Cannot initialize ego-items"));
-    }
-
-    init_note(_("[データの初期化中... (モンスター)]", "[Initializing arrays... (monsters)]"));
-    if (init_monster_race_definitions()) {
-        quit(_("モンスター初期化不能", "Cannot initialize monsters"));
-    }
-
-    init_note(_("[データの初期化中... (ダンジョン)]", "[Initializing arrays... (dungeon)]"));
-    if (init_dungeons_info()) {
-        quit(_("ダンジョン初期化不能", "Cannot initialize dungeon"));
-    }
-
     for (const auto &d_ref : dungeons_info) {
         if (d_ref.idx > 0 && MonsterRace(d_ref.final_guardian).is_valid()) {
             monraces_info[d_ref.final_guardian].flags7 |= RF7_GUARDIAN;
         }
     }
 
-    init_note(_("[データの初期化中... (魔法)]", "[Initializing arrays... (magic)]"));
-    if (init_class_magics_info()) {
-        quit(_("魔法初期化不能", "Cannot initialize magic"));
-    }
-
-    init_note(_("[データの初期化中... (熟練度)]", "[Initializing arrays... (skill)]"));
-    if (init_class_skills_info()) {
-        quit(_("熟練度初期化不能", "Cannot initialize skill"));
-    }
-
     init_note(_("[配列を初期化しています... (荒野)]", "[Initializing arrays... (wilderness)]"));
     if (init_wilderness()) {
         quit(_("荒野を初期化できません", "Cannot initialize wilderness"));
@@ -332,9 +294,6 @@ void init_angband(PlayerType *player_ptr, bool no_term)
 
     init_note(_("[配列を初期化しています... (クエスト)]", "[Initializing arrays... (quests)]"));
     QuestList::get_instance().initialize();
-    if (init_vaults_info()) {
-        quit(_("vault 初期化不能", "Cannot initialize vaults"));
-    }
 
     init_note(_("[データの初期化中... (その他)]", "[Initializing arrays... (other)]"));
     init_other(player_ptr);
@@ -0,0 +1,533 @@
+﻿/*!
+ * @file info-cache.cpp
+ * @brief 定義ファイルの解析結果のバイナリキャッシュ処理
+ * @details
+ * lib/edit/ の定義ファイルを解析した結果の表を lib/data/ に書き出しておき、
+ * 次回の起動時にテキストが変わっていなければ、解析せずにキャッシュから表を復元する.
+ * キャッシュは同じ実行ファイルでしか読めない (構造体のメモリ表現をそのまま含む) ため、
+ * 版数・言語・構造体の大きさが一致しない時も読まずに解析し直す.
+ */
+
+#include "main/info-cache.h"
+#include "info-reader/general-parser.h"
+#include "io/files-util.h"
+#include "main/angband-headers.h"
+#include "monster-race/monster-race.h"
+#include "object-enchant/object-ego.h"
+#include "player-info/class-info.h"
+#include "player/player-skill.h"
+#include "room/rooms-vault.h"
+#include "system/angband-version.h"
+#include "system/artifact-type-definition.h"
+#include "system/baseitem-info.h"
+#include "system/dungeon-info.h"
+#include "system/monster-race-info.h"
+#include "system/terrain-type-definition.h"
+#include "util/angband-files.h"
+#ifndef WINDOWS
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+#include <array>
+#include <cstring>
+#include <map>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace {
+
+/*!
+ * @brief キャッシュの書式の版数
+ * @details キャッシュへ書き出す構造体のメンバを増減した時や transfer() を変えた時に上げること
+ */
+constexpr uint32_t INFO_CACHE_VERSION = 1;
+
+constexpr std::array<char, 4> INFO_CACHE_MAGIC = { { 'H', 'B', 'I', 'C' } };
+
+#ifdef JP
+constexpr byte INFO_CACHE_LANGUAGE = 1;
+#else
+constexpr byte INFO_CACHE_LANGUAGE = 0;
+#endif
+
+template <typename>
+struct is_std_vector : std::false_type {
+};
+
+template <typename T, typename Alloc>
+struct is_std_vector<std::vector<T, Alloc>> : std::true_type {
+};
+
+template <typename>
+struct is_std_map : std::false_type {
+};
+
+template <typename K, typename V, typename Compare, typename Alloc>
+struct is_std_map<std::map<K, V, Compare, Alloc>> : std::true_type {
+};
+
+template <typename>
+struct is_std_tuple : std::false_type {
+};
+
+template <typename... Ts>
+struct is_std_tuple<std::tuple<Ts...>> : std::true_type {
+};
+
+/*!
+ * @brief 表の要素の大きさから、キャッシュを書いた実行ファイルとの互換性を見る値を求める
+ * @tparam InfoType 表の型
+ */
+template <typename InfoType>
+constexpr uint32_t info_cache_layout()
+{
+    return static_cast<uint32_t>((sizeof(typename InfoType::value_type) << 16) | (sizeof(std::string) << 8) | sizeof(void *));
+}
+
+/*!
+ * @brief キャッシュへの書き出し
+ * @details 自明にコピーできる型はメモリ表現をそのまま、文字列とコンテナは要素数に続けて要素を、その他の構造体は transfer() でメンバ毎に書き出す
+ */
+class InfoCacheWriter {
+public:
+    std::vector<char> bytes;
+
+    template <typename... Args>
+    void operator()(Args &...args)
+    {
+        (this->put(args), ...);
+    }
+
+private:
+    void put_raw(const void *data, size_t size)
+    {
+        const auto *p = static_cast<const char *>(data);
+        this->bytes.insert(this->bytes.end(), p, p + size);
+    }
+
+    template <typename T>
+    void put(T &value);
+};
+
+/*!
+ * @brief キャッシュからの読み込み
+ * @details 書き出しと同じ順で読む. 途中でデータが尽きたら以降は何も読まず、is_valid が false になる
+ */
+class InfoCacheReader {
+public:
+    InfoCacheReader(const char *data, size_t size)
+        : p(data)
+        , end(data + size)
+    {
+    }
+
+    bool is_valid = true;
+
+    template <typename... Args>
+    void operator()(Args &...args)
+    {
+        (this->get(args), ...);
+    }
+
+    bool is_end() const
+    {
+        return this->p == this->end;
+    }
+
+private:
+    const char *p;
+    const char *end;
+
+    void get_raw(void *data, size_t size)
+    {
+        if (!this->is_valid || (static_cast<size_t>(this->end - this->p) < size)) {
+            this->is_valid = false;
+            return;
+        }
+
+        std::memcpy(data, this->p, size);
+        this->p += size;
+    }
+
+    template <typename T>
+    void get(T &value);
+};
+
+template <typename Archive>
+void transfer(Archive &ar, MonsterRaceInfo &r)
+{
+    ar(r.idx, r.name);
+#ifdef JP
+    ar(r.E_name);
+#endif
+    ar(r.text, r.hdice, r.hside, r.ac, r.sleep, r.aaf, r.speed, r.mexp, r.freq_spell);
+    ar(r.flags1, r.flags2, r.flags3, r.flags7, r.flags8);
+    ar(r.ability_flags, r.aura_flags, r.behavior_flags, r.visual_flags, r.kind_flags, r.resistance_flags, r.drop_flags, r.wilderness_flags);
+    ar(r.feature_flags, r.population_flags, r.speak_flags, r.brightness_flags);
+    ar(r.blow, r.reinforces, r.drop_artifacts, r.arena_ratio, r.next_r_idx, r.next_exp, r.level, r.rarity);
+    ar(r.d_attr, r.d_char, r.x_attr, r.x_char, r.max_num, r.cur_num, r.floor_id);
+    ar(r.r_sights, r.r_deaths, r.r_pkills, r.r_akills, r.r_tkills, r.r_wake, r.r_ignore, r.r_can_evolve, r.r_drop_gold, r.r_drop_item, r.r_cast_spell, r.r_blows);
+    ar(r.r_flags1, r.r_flags2, r.r_flags3, r.r_ability_flags, r.r_aura_flags, r.r_behavior_flags, r.r_kind_flags, r.r_resistance_flags, r.r_drop_flags, r.r_feature_flags);
+    ar(r.defeat_level, r.defeat_time, r.cur_hp_per);
+}
+
+template <typename Archive>
+void transfer(Archive &ar, BaseitemInfo &bi)
+{
+    ar(bi.idx, bi.name, bi.text, bi.flavor_name, bi.bi_key, bi.pval, bi.to_h, bi.to_d, bi.to_a, bi.ac, bi.dd, bi.ds, bi.weight, bi.cost);
+    ar(bi.flags, bi.gen_flags, bi.level, bi.locale, bi.chance, bi.d_attr, bi.d_char, bi.easy_know, bi.act_idx, bi.x_attr, bi.x_char, bi.flavor, bi.aware, bi.tried);
+}
+
+template <typename Archive>
+void transfer(Archive &ar, ArtifactType &a)
+{
+    ar(a.name, a.text, a.bi_key, a.pval, a.to_h, a.to_d, a.to_a, a.ac, a.dd, a.ds, a.weight, a.cost);
+    ar(a.flags, a.gen_flags, a.level, a.rarity, a.is_generated, a.floor_id, a.act_idx);
+}
+
+template <typename Archive>
+void transfer(Archive &ar, ego_generate_type &xtra)
+{
+    ar(xtra.mul, xtra.dev, xtra.tr_flags, xtra.trg_flags);
+}
+
+template <typename Archive>
+void transfer(Archive &ar, ego_item_type &e)
+{
+    ar(e.idx, e.name, e.text, e.slot, e.rating, e.level, e.rarity, e.base_to_h, e.base_to_d, e.base_to_a, e.max_to_h, e.max_to_d, e.max_to_a);
+    ar(e.max_pval, e.cost, e.flags, e.gen_flags, e.xtra_flags, e.act_idx);
+}
+
+template <typename Archive>
+void transfer(Archive &ar, TerrainState &state)
+{
+    ar(state.action, state.result_tag, state.result);
+}
+
+template <typename Archive>
+void transfer(Archive &ar, TerrainType &f)
+{
+    ar(f.idx, f.name, f.text, f.tag, f.mimic_tag, f.destroyed_tag, f.mimic, f.destroyed, f.flags, f.priority, f.state, f.subtype, f.power);
+    ar(f.d_attr, f.d_char, f.x_attr, f.x_char);
+}
+
+template <typename Archive>
+void transfer(Archive &ar, dungeon_type &d)
+{
+    ar(d.idx, d.name, d.text, d.dy, d.dx, d.floor, d.fill, d.outer_wall, d.inner_wall, d.stream1, d.stream2);
+    ar(d.mindepth, d.maxdepth, d.min_plev, d.pit, d.nest, d.mode, d.min_m_alloc_level, d.max_m_alloc_chance, d.flags);
+    ar(d.mflags1, d.mflags2, d.mflags3, d.mflags7, d.mflags8);
+    ar(d.mon_ability_flags, d.mon_behavior_flags, d.mon_visual_flags, d.mon_kind_flags, d.mon_resistance_flags, d.mon_drop_flags);
+    ar(d.mon_wilderness_flags, d.mon_feature_flags, d.mon_population_flags, d.mon_speak_flags, d.mon_brightness_flags);
+    ar(d.r_chars, d.final_object, d.final_artifact, d.final_guardian, d.special_div, d.tunnel_percent, d.obj_great, d.obj_good);
+}
+
+template <typename Archive>
+void transfer(Archive &ar, skill_table &s)
+{
+    ar(s.w_start, s.w_max, s.s_start, s.s_max);
+}
+
+template <typename Archive>
+void transfer(Archive &ar, vault_type &v)
+{
+    ar(v.idx, v.name, v.text, v.typ, v.rat, v.hgt, v.wid);
+}
+
+template <typename T>
+void InfoCacheWriter::put(T &value)
+{
+    if constexpr (std::is_trivially_copyable_v<T>) {
+        this->put_raw(&value, sizeof(T));
+    } else if constexpr (std::is_array_v<T>) {
+        for (auto &element : value) {
+            this->put(element);
+        }
+    } else if constexpr (std::is_same_v<T, std::string>) {
+        auto size = static_cast<uint32_t>(value.size());
+        this->put(size);
+        this->put_raw(value.data(), value.size());
+    } else if constexpr (is_std_vector<T>::value || is_std_map<T>::value) {
+        auto size = static_cast<uint32_t>(value.size());
+        this->put(size);
+        for (auto &element : value) {
+            if constexpr (is_std_map<T>::value) {
+                auto key = element.first;
+                this->put(key);
+                this->put(element.second);
+            } else {
+                this->put(element);
+            }
+        }
+    } else if constexpr (is_std_tuple<T>::value) {
+        std::apply([this](auto &...elements) { (this->put(elements), ...); }, value);
+    } else {
+        transfer(*this, value);
+    }
+}
+
+template <typename T>
+void InfoCacheReader::get(T &value)
+{
+    if constexpr (std::is_trivially_copyable_v<T>) {
+        this->get_raw(&value, sizeof(T));
+    } else if constexpr (std::is_array_v<T>) {
+        for (auto &element : value) {
+            this->get(element);
+        }
+    } else if constexpr (std::is_same_v<T, std::string>) {
+        uint32_t size = 0;
+        this->get(size);
+        if (!this->is_valid || (static_cast<size_t>(this->end - this->p) < size)) {
+            this->is_valid = false;
+            return;
+        }
+
+        value.assign(this->p, size);
+        this->p += size;
+    } else if constexpr (is_std_vector<T>::value || is_std_map<T>::value) {
+        uint32_t size = 0;
+        this->get(size);
+        value.clear();
+        for (uint32_t i = 0; (i < size) && this->is_valid; i++) {
+            if constexpr (is_std_map<T>::value) {
+                typename T::key_type key{};
+                typename T::mapped_type element{};
+                this->get(key);
+                this->get(element);
+                value.emplace(key, std::move(element));
+            } else {
+                typename T::value_type element{};
+                this->get(element);
+                value.push_back(std::move(element));
+            }
+        }
+    } else if constexpr (is_std_tuple<T>::value) {
+        std::apply([this](auto &...elements) { (this->get(elements), ...); }, value);
+    } else {
+        transfer(*this, value);
+    }
+}
+
+/*!
+ * @brief キャッシュの先頭に置く照合用の情報を書き出す/読み込む
+ */
+template <typename Archive>
+void transfer_cache_header(Archive &ar, std::array<char, 4> &magic, uint32_t &version, uint32_t &layout, byte &language, InfoTextKey &key, uint16_t &info_num)
+{
+    ar(magic, version, layout, language, key.checksum, key.hash, info_num);
+}
+
+/*!
+ * @brief キャッシュファイルのパスを得る
+ * @param filename 定義ファイル名 (拡張子txt)
+ * @return lib/data/ 以下の、拡張子をrawに変えたパス
+ */
+std::string get_cache_path(std::string_view filename)
+{
+    std::string name(filename.substr(0, filename.rfind('.')));
+    name.append(_("_j.raw", ".raw"));
+    char buf[1024];
+    path_build(buf, sizeof(buf), ANGBAND_DIR_DATA, name.data());
+    return buf;
+}
+
+/*!
+ * @brief 読み込み専用でファイル全体をメモリに割り付ける
+ * @details Windows では割り付けの代わりに全体を読み込む
+ */
+class MappedFile {
+public:
+    explicit MappedFile(const std::string &path)
+    {
+#ifndef WINDOWS
+        const auto fd = open(path.data(), O_RDONLY);
+        if (fd < 0) {
+            return;
+        }
+
+        struct stat st;
+        if ((fstat(fd, &st) == 0) && (st.st_size > 0)) {
+            auto *mapped = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+            if (mapped != MAP_FAILED) {
+                this->data = static_cast<const char *>(mapped);
+                this->size = static_cast<size_t>(st.st_size);
+            }
+        }
+
+        close(fd);
+#else
+        auto *fp = angband_fopen(path.data(), "rb");
+        if (fp == nullptr) {
+            return;
+        }
+
+        char buf[4096];
+        size_t n;
+        while ((n = fread(buf, 1, sizeof(buf), fp)) > 0) {
+            this->buffer.insert(this->buffer.end(), buf, buf + n);
+        }
+
+        angband_fclose(fp);
+        this->data = this->buffer.data();
+        this->size = this->buffer.size();
+#endif
+    }
+
+    ~MappedFile()
+    {
+#ifndef WINDOWS
+        if (this->data != nullptr) {
+            munmap(const_cast<char *>(this->data), this->size);
+        }
+#endif
+    }
+
+    MappedFile(const MappedFile &) = delete;
+    MappedFile &operator=(const MappedFile &) = delete;
+
+    const char *data = nullptr;
+    size_t size = 0;
+
+private:
+#ifdef WINDOWS
+    std::vector<char> buffer;
+#endif
+};
+}
+
+/*!
+ * @brief 定義ファイルを最後まで読み、キャッシュとの照合に使う鍵を求める
+ * @param fp 定義ファイル
+ * @return 鍵
+ * @details チェックサムは init_info_txt() と同じ行から同じ手順で求め、ハッシュ値は全ての行から求める (FNV-1a)
+ */
+InfoTextKey read_info_text_key(FILE *fp)
+{
+    InfoTextKey key;
+    key.hash = 14695981039346656037ULL;
+    char buf[1024];
+    while (angband_fgets(fp, buf, sizeof(buf)) == 0) {
+        const std::string_view line(buf);
+        for (const auto c : line) {
+            key.hash = (key.hash ^ static_cast<byte>(c)) * 1099511628211ULL;
+        }
+
+        key.hash = (key.hash ^ '\n') * 1099511628211ULL;
+        if (line.empty() || (line[0] == '#') || (line.size() < 2) || (line[1] != ':')) {
+            continue;
+        }
+
+        if ((line[0] != 'V') && (line[0] != 'N') && (line[0] != 'D')) {
+            add_info_checksum(key.checksum, line);
+        }
+    }
+
+    return key;
+}
+
+/*!
+ * @brief 定義ファイルに対応するキャッシュがあれば、そこから表を復元する
+ * @param filename 定義ファイル名
+ * @param key 定義ファイルから求めた鍵
+ * @param head 定義ファイルのヘッダ構造体
+ * @param info 復元先の表
+ * @param warnings 解析した時の警告の復元先
+ * @return 復元できたらtrue. 見つからない・鍵が違う・壊れている時はfalseを返し、その時は表の内容を問わない
+ */
+template <typename InfoType>
+bool load_info_cache(std::string_view filename, const InfoTextKey &key, angband_header &head, InfoType &info, std::vector<std::string> &warnings)
+{
+    const MappedFile file(get_cache_path(filename));
+    if (file.data == nullptr) {
+        return false;
+    }
+
+    InfoCacheReader reader(file.data, file.size);
+    std::array<char, 4> magic{};
+    uint32_t version = 0;
+    uint32_t layout = 0;
+    byte language = 0;
+    InfoTextKey cached_key;
+    uint16_t info_num = 0;
+    transfer_cache_header(reader, magic, version, layout, language, cached_key, info_num);
+    if (!reader.is_valid || (magic != INFO_CACHE_MAGIC) || (version != INFO_CACHE_VERSION) || (layout != info_cache_layout<InfoType>())) {
+        return false;
+    }
+
+    if ((language != INFO_CACHE_LANGUAGE) || (cached_key.checksum != key.checksum) || (cached_key.hash != key.hash)) {
+        return false;
+    }
+
+    reader(warnings, info);
+    if (!reader.is_valid || !reader.is_end()) {
+        return false;
+    }
+
+    head.checksum = key.checksum;
+    head.info_num = info_num;
+    return true;
+}
+
+/*!
+ * @brief 解析を終えた表をキャッシュへ書き出す
+ * @param filename 定義ファイル名
+ * @param key 定義ファイルから求めた鍵
+ * @param head 解析を終えたヘッダ構造体
+ * @param info 解析を終えた表
+ * @param warnings 解析した時の警告
+ * @details 一時ファイルへ書いてから置き換える. lib/data/ に書けない時は何もしない
+ */
+template <typename InfoType>
+void save_info_cache(std::string_view filename, const InfoTextKey &key, const angband_header &head, InfoType &info, const std::vector<std::string> &warnings)
+{
+    InfoCacheWriter writer;
+    auto magic = INFO_CACHE_MAGIC;
+    auto version = INFO_CACHE_VERSION;
+    auto layout = info_cache_layout<InfoType>();
+    auto language = INFO_CACHE_LANGUAGE;
+    auto cached_key = key;
+    auto info_num = head.info_num;
+    auto cached_warnings = warnings;
+    transfer_cache_header(writer, magic, version, layout, language, cached_key, info_num);
+    writer(cached_warnings, info);
+
+    const auto path = get_cache_path(filename);
+    const auto tmp_path = path + ".tmp";
+    auto *fp = angband_fopen(tmp_path.data(), "wb");
+    if (fp == nullptr) {
+        return;
+    }
+
+    const auto is_written = fwrite(writer.bytes.data(), 1, writer.bytes.size(), fp) == writer.bytes.size();
+    angband_fclose(fp);
+    if (!is_written) {
+        (void)fd_kill(tmp_path.data());
+        return;
+    }
+
+    (void)fd_kill(path.data());
+    (void)fd_move(tmp_path.data(), path.data());
+}
+
+template bool load_info_cache(std::string_view, const InfoTextKey &, angband_header &, std::vector<BaseitemInfo> &, std::vector<std::string> &);
+template bool load_info_cache(std::string_view, const InfoTextKey &, angband_header &, std::vector<player_magic> &, std::vector<std::string> &);
+template bool load_info_cache(std::string_view, const InfoTextKey &, angband_header &, std::vector<skill_table> &, std::vector<std::string> &);
+template bool load_info_cache(std::string_view, const InfoTextKey &, angband_header &, std::vector<TerrainType> &, std::vector<std::string> &);
+template bool load_info_cache(std::string_view, const InfoTextKey &, angband_header &, std::vector<dungeon_type> &, std::vector<std::string> &);
+template bool load_info_cache(std::string_view, const InfoTextKey &, angband_header &, std::vector<vault_type> &, std::vector<std::string> &);
+template bool load_info_cache(std::string_view, const InfoTextKey &, angband_header &, std::map<FixedArtifactId, ArtifactType> &, std::vector<std::string> &);
+template bool load_info_cache(std::string_view, const InfoTextKey &, angband_header &, std::map<EgoType, ego_item_type> &, std::vector<std::string> &);
+template bool load_info_cache(std::string_view, const InfoTextKey &, angband_header &, std::map<MonsterRaceId, MonsterRaceInfo> &, std::vector<std::string> &);
+template void save_info_cache(std::string_view, const InfoTextKey &, const angband_header &, std::vector<BaseitemInfo> &, const std::vector<std::string> &);
+template void save_info_cache(std::string_view, const InfoTextKey &, const angband_header &, std::vector<player_magic> &, const std::vector<std::string> &);
+template void save_info_cache(std::string_view, const InfoTextKey &, const angband_header &, std::vector<skill_table> &, const std::vector<std::string> &);
+template void save_info_cache(std::string_view, const InfoTextKey &, const angband_header &, std::vector<TerrainType> &, const std::vector<std::string> &);
+template void save_info_cache(std::string_view, const InfoTextKey &, const angband_header &, std::vector<dungeon_type> &, const std::vector<std::string> &);
+template void save_info_cache(std::string_view, const InfoTextKey &, const angband_header &, std::vector<vault_type> &, const std::vector<std::string> &);
+template void save_info_cache(std::string_view, const InfoTextKey &, const angband_header &, std::map<FixedArtifactId, ArtifactType> &, const std::vector<std::string> &);
+template void save_info_cache(std::string_view, const InfoTextKey &, const angband_header &, std::map<EgoType, ego_item_type> &, const std::vector<std::string> &);
+template void save_info_cache(std::string_view, const InfoTextKey &, const angband_header &, std::map<MonsterRaceId, MonsterRaceInfo> &, const std::vector<std::string> &);
@@ -0,0 +1,28 @@
+﻿#pragma once
+/*!
+ * @file info-cache.h
+ * @brief 定義ファイルの解析結果のバイナリキャッシュ処理ヘッダ
+ */
+
+#include "system/angband.h"
+#include <cstdio>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/*!
+ * @brief キャッシュが定義ファイルのテキストに対応しているかを照合するための鍵
+ */
+struct InfoTextKey {
+    byte checksum{}; //!< init_info_txt() が求めるものと同じ angband_header::checksum
+    uint64_t hash{}; //!< 全行の内容のハッシュ値
+};
+
+struct angband_header;
+InfoTextKey read_info_text_key(FILE *fp);
+
+template <typename InfoType>
+bool load_info_cache(std::string_view filename, const InfoTextKey &key, angband_header &head, InfoType &info, std::vector<std::string> &warnings);
+
+template <typename InfoType>
+void save_info_cache(std::string_view filename, const InfoTextKey &key, const angband_header &head, InfoType &info, const std::vector<std::string> &warnings);
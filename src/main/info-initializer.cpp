@@ -19,6 +19,7 @@
 #include "io/files-util.h"
 #include "io/uid-checker.h"
 #include "main/angband-headers.h"
+#include "main/info-cache.h"
 #include "main/init-error-messages-table.h"
 #include "monster-race/monster-race.h"
 #include "object-enchant/object-ego.h"
@@ -39,7 +40,16 @@
 #ifndef WINDOWS
 #include <sys/types.h>
 #endif
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <string>
 #include <string_view>
+#include <thread>
+#include <vector>
 
 namespace {
 
@@ -62,6 +72,36 @@ struct is_vector<std::vector<T, Alloc>> : std::true_type {
 template <typename T>
 constexpr bool is_vector_v = is_vector<T>::value;
 
+/*!
+ * @brief 定義ファイル1つ分の読み込み結果
+ * @details 読み込みはワーカースレッドで行うため、警告とエラーの表示は全ての読み込みを終えてからメインスレッドで行う
+ */
+struct InfoLoadResult {
+    std::string_view filename;
+    bool is_opened = true; //!< ファイルを開けたか
+    errr err = 0;
+    int error_line = 0;
+    int error_idx = 0;
+    std::string buf; //!< エラーが発生した行
+    std::vector<std::string> warnings; //!< 未知のフラグ等の警告
+    int64_t time_ns = 0;
+    bool is_cached = false; //!< 解析せずにキャッシュから復元したか
+};
+
+/*!
+ * @brief 定義ファイル1つ分の読み込みタスク
+ */
+struct InfoLoadTask {
+    InfoLoadResult (*load)();
+    int depends_on; //!< 先に読み込みを終えている必要のあるタスクの添字 (無ければ-1)
+};
+
+std::vector<InfoLoadTime> info_load_times;
+
+int64_t now_ns()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
 }
 
 /*!
@@ -84,41 +124,56 @@ static void init_header(angband_header *head, IDX num = 0)
  * @param filename ファイル名(拡張子txt)
  * @param head 処理に用いるヘッダ構造体
  * @param info データ保管先の構造体ポインタ
- * @return エラーコード
+ * @return 読み込み結果
+ * @details
+ * テキストの内容から求めた鍵が lib/data/ のキャッシュと一致すれば、解析せずにキャッシュから表を復元する.
+ * 一致しなければ解析し、成功したらキャッシュを書き直す.
  * @note
  * Note that we let each entry have a unique "name" and "text" string,
  * even if the string happens to be empty (everyone has a unique '\0').
  */
 template <typename InfoType>
-static errr init_info(std::string_view filename, angband_header &head, InfoType &info, Parser parser, Retoucher retouch = nullptr)
+static InfoLoadResult init_info(std::string_view filename, angband_header &head, InfoType &info, Parser parser, Retoucher retouch = nullptr)
 {
+    InfoLoadResult result;
+    result.filename = filename;
+    const auto start_ns = now_ns();
     char buf[1024];
     path_build(buf, sizeof(buf), ANGBAND_DIR_EDIT, filename.data());
 
     auto *fp = angband_fopen(buf, "r");
     if (!fp) {
-        quit(format(_("'%s'ファイルをオープンできません。", "Cannot open '%s' file."), filename));
+        result.is_opened = false;
+        return result;
+    }
+
+    const auto key = read_info_text_key(fp);
+    if (load_info_cache(filename, key, head, info, result.warnings)) {
+        angband_fclose(fp);
+        result.is_cached = true;
+        result.time_ns = now_ns() - start_ns;
+        return result;
     }
 
+    rewind(fp);
+    info = InfoType{};
     constexpr auto info_is_vector = is_vector_v<InfoType>;
     if constexpr (info_is_vector) {
         using value_type = typename InfoType::value_type;
         info.assign(head.info_num, value_type{});
     }
 
+    info_warnings.clear();
+    result.warnings.clear();
     const auto err = init_info_txt(fp, buf, &head, parser);
     angband_fclose(fp);
     if (err) {
-        const auto oops = (((err > 0) && (err < PARSE_ERROR_MAX)) ? err_str[err] : _("未知の", "unknown"));
-#ifdef JP
-        msg_format("'%s'ファイルの %d 行目にエラー。", filename, error_line);
-#else
-        msg_format("Error %d at line %d of '%s'.", err, error_line, filename);
-#endif
-        msg_format(_("レコード %d は '%s' エラーがあります。", "Record %d contains a '%s' error."), error_idx, oops);
-        msg_format(_("構文 '%s'。", "Parsing '%s'."), buf);
-        msg_print(nullptr);
-        quit(format(_("'%s'ファイルにエラー", "Error in '%s' file."), filename));
+        result.warnings = std::move(info_warnings);
+        result.err = err;
+        result.error_line = error_line;
+        result.error_idx = error_idx;
+        result.buf = buf;
+        return result;
     }
 
     if constexpr (info_is_vector) {
@@ -130,14 +185,49 @@ static errr init_info(std::string_view filename, angband_header &head, InfoType
         (*retouch)(&head);
     }
 
-    return 0;
+    save_info_cache(filename, key, head, info, info_warnings);
+    result.warnings = std::move(info_warnings);
+    result.time_ns = now_ns() - start_ns;
+    return result;
+}
+
+/*!
+ * @brief 定義ファイルの読み込み中の警告を表示し、読み込みに失敗していたらエラーを表示して終了する
+ * @param result 読み込み結果
+ */
+static void check_info_result(const InfoLoadResult &result)
+{
+    const auto filename = result.filename;
+    if (!result.is_opened) {
+        quit(format(_("'%s'ファイルをオープンできません。", "Cannot open '%s' file."), filename.data()));
+    }
+
+    for (const auto &warning : result.warnings) {
+        msg_print(warning);
+    }
+
+    const auto err = result.err;
+    if (!err) {
+        return;
+    }
+
+    const auto oops = (((err > 0) && (err < PARSE_ERROR_MAX)) ? err_str[err] : _("未知の", "unknown"));
+#ifdef JP
+    msg_format("'%s'ファイルの %d 行目にエラー。", filename.data(), result.error_line);
+#else
+    msg_format("Error %d at line %d of '%s'.", err, result.error_line, filename.data());
+#endif
+    msg_format(_("レコード %d は '%s' エラーがあります。", "Record %d contains a '%s' error."), result.error_idx, oops);
+    msg_format(_("構文 '%s'。", "Parsing '%s'."), result.buf.data());
+    msg_print(nullptr);
+    quit(format(_("'%s'ファイルにエラー", "Error in '%s' file."), filename.data()));
 }
 
 /*!
  * @brief 固定アーティファクト情報読み込みのメインルーチン
- * @return エラーコード
+ * @return 読み込み結果
  */
-errr init_artifacts_info()
+static InfoLoadResult init_artifacts_info()
 {
     init_header(&artifacts_header);
     return init_info("ArtifactDefinitions.txt", artifacts_header, artifacts_info, parse_artifacts_info);
@@ -145,9 +235,9 @@ errr init_artifacts_info()
 
 /*!
  * @brief ベースアイテム情報読み込みのメインルーチン
- * @return エラーコード
+ * @return 読み込み結果
  */
-errr init_baseitems_info()
+static InfoLoadResult init_baseitems_info()
 {
     init_header(&baseitems_header);
     return init_info("BaseitemDefinitions.txt", baseitems_header, baseitems_info, parse_baseitems_info);
@@ -155,9 +245,9 @@ errr init_baseitems_info()
 
 /*!
  * @brief 職業魔法情報読み込みのメインルーチン
- * @return エラーコード
+ * @return 読み込み結果
  */
-errr init_class_magics_info()
+static InfoLoadResult init_class_magics_info()
 {
     init_header(&class_magics_header, PLAYER_CLASS_TYPE_MAX);
     auto *parser = parse_class_magics_info;
@@ -166,18 +256,19 @@ errr init_class_magics_info()
 
 /*!
  * @brief 職業技能情報読み込みのメインルーチン
- * @return エラーコード
+ * @return 読み込み結果
  */
-errr init_class_skills_info()
+static InfoLoadResult init_class_skills_info()
 {
     init_header(&class_skills_header, PLAYER_CLASS_TYPE_MAX);
     return init_info("ClassSkillDefinitions.txt", class_skills_header, class_skills_info, parse_class_skills_info);
 }
 /*!
  * @brief ダンジョン情報読み込みのメインルーチン
- * @return エラーコード
+ * @return 読み込み結果
+ * @details 地形タグを参照するため、地形情報を読み込んだ後に呼ぶこと
  */
-errr init_dungeons_info()
+static InfoLoadResult init_dungeons_info()
 {
     init_header(&dungeons_header);
     return init_info("DungeonDefinitions.txt", dungeons_header, dungeons_info, parse_dungeons_info);
@@ -185,9 +276,9 @@ errr init_dungeons_info()
 
 /*!
  * @brief エゴ情報読み込みのメインルーチン
- * @return エラーコード
+ * @return 読み込み結果
  */
-errr init_egos_info()
+static InfoLoadResult init_egos_info()
 {
     init_header(&egos_header);
     return init_info("EgoDefinitions.txt", egos_header, egos_info, parse_egos_info);
@@ -195,9 +286,9 @@ errr init_egos_info()
 
 /*!
  * @brief 地形情報読み込みのメインルーチン
- * @return エラーコード
+ * @return 読み込み結果
  */
-errr init_terrains_info()
+static InfoLoadResult init_terrains_info()
 {
     init_header(&terrains_header);
     auto *parser = parse_terrains_info;
@@ -207,9 +298,9 @@ errr init_terrains_info()
 
 /*!
  * @brief モンスター種族情報読み込みのメインルーチン
- * @return エラーコード
+ * @return 読み込み結果
  */
-errr init_monster_race_definitions()
+static InfoLoadResult init_monster_race_definitions()
 {
     init_header(&monraces_header);
     return init_info("MonsterRaceDefinitions.txt", monraces_header, monraces_info, parse_monraces_info);
@@ -217,17 +308,124 @@ errr init_monster_race_definitions()
 
 /*!
  * @brief Vault情報読み込みのメインルーチン
- * @return エラーコード
+ * @return 読み込み結果
  * @note
  * Note that we let each entry have a unique "name" and "text" string,
  * even if the string happens to be empty (everyone has a unique '\0').
  */
-errr init_vaults_info()
+static InfoLoadResult init_vaults_info()
 {
     init_header(&vaults_header);
     return init_info("VaultDefinitions.txt", vaults_header, vaults_info, parse_vaults_info);
 }
 
+/*!
+ * @brief 定義ファイルの読み込みタスク
+ * @details 空いたワーカーは依存先の読み込みを終えたタスクを先頭から取るので、時間の掛かるものと依存先を前に置く
+ */
+static const std::array<InfoLoadTask, 9> INFO_LOAD_TASKS = { {
+    { init_terrains_info, -1 },
+    { init_monster_race_definitions, -1 },
+    { init_class_skills_info, -1 },
+    { init_baseitems_info, -1 },
+    { init_artifacts_info, -1 },
+    { init_class_magics_info, -1 },
+    { init_egos_info, -1 },
+    { init_vaults_info, -1 },
+    { init_dungeons_info, 0 },
+} };
+
+/*!
+ * @brief lib/edit/ の定義ファイルをスレッドプールで並列に読み込む
+ * @details
+ * 各パーサは自分の表にのみ書き込むため、ダンジョン (地形タグを参照する) 以外は互いに独立して読み込める.
+ * 全ての読み込みを終えてから、警告とエラーの表示及び読み込み時間の記録をメインスレッドで行う.
+ * 表を跨ぐ参照 (ダンジョンの守護者等) の解決は、この後に呼び出し元で行う.
+ */
+void init_info_tables()
+{
+    constexpr auto task_num = static_cast<int>(INFO_LOAD_TASKS.size());
+    std::array<InfoLoadResult, INFO_LOAD_TASKS.size()> results;
+    std::array<bool, INFO_LOAD_TASKS.size()> started{};
+    std::array<bool, INFO_LOAD_TASKS.size()> finished{};
+    std::exception_ptr exception;
+    std::mutex mutex;
+    std::condition_variable cv;
+
+    auto worker = [&] {
+        std::unique_lock<std::mutex> lock(mutex);
+        while (true) {
+            auto next = -1;
+            auto remains = false;
+            for (auto i = 0; i < task_num; i++) {
+                if (started[i]) {
+                    continue;
+                }
+
+                remains = true;
+                const auto depends_on = INFO_LOAD_TASKS[i].depends_on;
+                if ((depends_on < 0) || finished[depends_on]) {
+                    next = i;
+                    break;
+                }
+            }
+
+            if (next < 0) {
+                if (!remains) {
+                    return;
+                }
+
+                cv.wait(lock);
+                continue;
+            }
+
+            started[next] = true;
+            lock.unlock();
+            try {
+                results[next] = INFO_LOAD_TASKS[next].load();
+            } catch (...) {
+                lock.lock();
+                exception = std::current_exception();
+                lock.unlock();
+            }
+
+            lock.lock();
+            finished[next] = true;
+            cv.notify_all();
+        }
+    };
+
+    const auto thread_num = std::clamp(static_cast<int>(std::thread::hardware_concurrency()), 1, task_num);
+    std::vector<std::thread> threads;
+    for (auto i = 1; i < thread_num; i++) {
+        threads.emplace_back(worker);
+    }
+
+    worker();
+    for (auto &thread : threads) {
+        thread.join();
+    }
+
+    if (exception) {
+        std::rethrow_exception(exception);
+    }
+
+    info_load_times.clear();
+    for (const auto &result : results) {
+        check_info_result(result);
+        info_load_times.push_back({ result.filename, result.time_ns, result.is_cached });
+    }
+}
+
+/*!
+ * @brief 定義ファイル毎の読み込み時間を返す
+ * @return 読み込み時間の一覧 (読み込みタスクの順)
+ */
+const std::vector<InfoLoadTime> &get_info_load_times()
+{
+    return info_load_times;
+}
+
 /*!
  * @brief 基本情報読み込みのメインルーチン
  * @param player_ptr プレイヤーへの参照ポインタ
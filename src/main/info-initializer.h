@@ -5,15 +5,19 @@
  */
 
 #include "system/angband.h"
+#include <string_view>
+#include <vector>
+
+/*!
+ * @brief 定義ファイル1つ分の読み込み時間
+ */
+struct InfoLoadTime {
+    std::string_view filename;
+    int64_t time_ns;
+    bool is_cached; //!< 解析せずにキャッシュから復元したか
+};
 
 class PlayerType;
-errr init_artifacts_info();
-errr init_baseitems_info();
-errr init_class_magics_info();
-errr init_class_skills_info();
-errr init_dungeons_info();
-errr init_egos_info();
-errr init_monster_race_definitions();
-errr init_terrains_info();
-errr init_vaults_info();
+void init_info_tables();
+const std::vector<InfoLoadTime> &get_info_load_times();
 errr init_misc(PlayerType *player_ptr);
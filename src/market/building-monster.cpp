@@ -150,7 +150,7 @@ bool research_mon(PlayerType *player_ptr)
     char query = 'y';
 
     if (why) {
-        ang_sort(player_ptr, who.data(), &why, who.size(), ang_sort_comp_hook, ang_sort_swap_hook);
+        ang_sort(who, [why](auto r_idx1, auto r_idx2) { return ang_sort_comp_hook(r_idx1, r_idx2, why); });
     }
 
     uint i;
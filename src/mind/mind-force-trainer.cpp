@@ -251,6 +251,7 @@ bool shock_power(PlayerType *player_ptr)
     player_ptr->current_floor_ptr->grid_array[ty][tx].m_idx = m_idx;
     m_ptr->fy = ty;
     m_ptr->fx = tx;
+    player_ptr->current_floor_ptr->m_spatial_index.place(m_idx, ty, tx);
 
     update_monster(player_ptr, m_idx, true);
     lite_spot(player_ptr, oy, ox);
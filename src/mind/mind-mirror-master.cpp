@@ -46,6 +46,7 @@
 #include "target/grid-selector.h"
 #include "target/projection-path-calculator.h"
 #include "target/target-getter.h"
+#include "term/animation-scheduler.h"
 #include "timed-effect/player-blindness.h"
 #include "timed-effect/timed-effects.h"
 #include "util/bit-flags-calculator.h"
@@ -129,14 +130,15 @@ bool binding_field(PlayerType *player_ptr, int dam)
                     if (!(player_ptr->effects()->blindness()->is_blind()) && panel_contains(y, x)) {
                         print_bolt_pict(player_ptr, y, x, y, x, AttributeType::MANA);
                         move_cursor_relative(y, x);
-                        term_fresh();
-                        term_xtra(TERM_XTRA_DELAY, delay_factor);
+                        AnimationScheduler::get_instance().present_frame(delay_factor);
                     }
                 }
             }
         }
     }
 
+    AnimationScheduler::get_instance().finish();
+
     for (y = y1; y <= y2; y++) {
         for (x = x1; x <= x2; x++) {
             if (centersign * ((point_x[0] - x) * (point_y[1] - y) - (point_y[0] - y) * (point_x[1] - x)) >= 0 && centersign * ((point_x[1] - x) * (point_y[2] - y) - (point_y[1] - y) * (point_x[2] - x)) >= 0 && centersign * ((point_x[2] - x) * (point_y[0] - y) - (point_y[2] - y) * (point_x[0] - x)) >= 0) {
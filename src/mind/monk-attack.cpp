@@ -18,6 +18,7 @@
 #include "monster-race/monster-race.h"
 #include "monster-race/race-flags1.h"
 #include "monster-race/race-flags3.h"
+#include "monster/monster-processor.h"
 #include "monster/monster-status-setter.h"
 #include "monster/monster-status.h"
 #include "player-attack/player-attack-util.h"
@@ -214,7 +215,9 @@ static void process_attack_vital_spot(PlayerType *player_ptr, player_attack_type
         const auto is_unique = r_ptr->kind_flags.has_not(MonsterKindType::UNIQUE);
         if (is_unique && (randint1(player_ptr->lev) > r_ptr->level) && (pa_ptr->m_ptr->mspeed > STANDARD_SPEED - 50)) {
             msg_format(_("%^sは足をひきずり始めた。", "You've hobbled %s."), pa_ptr->m_name);
+            settle_monster_energy(player_ptr, pa_ptr->m_idx);
             pa_ptr->m_ptr->mspeed -= 10;
+            reschedule_monster(player_ptr, pa_ptr->m_idx);
         }
     }
 }
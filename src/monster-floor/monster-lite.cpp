@@ -1,5 +1,6 @@
 ﻿#include "monster-floor/monster-lite.h"
 #include "core/player-update-types.h"
+#include "core/profiler.h"
 #include "dungeon/dungeon-flag-types.h"
 #include "floor/cave.h"
 #include "grid/feature-flag-types.h"
@@ -23,6 +24,14 @@
 #include "world/world.h"
 #include <vector>
 
+/*!
+ * @brief 光源を持つモンスターを探す範囲に、視界の限界距離から加える余裕
+ * @details
+ * 候補を絞るのは現在位置だが、採否は従来通り前回の update_monster() で記録した cdis で決める.
+ * 記録後にプレイヤーやモンスターが動いていても cdis が限界内のモンスターを落とさないよう、範囲を広げておく
+ */
+constexpr POSITION MON_LITE_QUERY_MARGIN = 8;
+
 /*!
  * @brief モンスターによる光量状態更新 / Add a square to the changes array
  * @param player_ptr プレイヤーへの参照ポインタ
@@ -148,6 +157,8 @@ static void update_monster_dark(
  */
 void update_mon_lite(PlayerType *player_ptr)
 {
+    ProfileScope profile_scope(ProfileSection::UPDATE_MON_LITE);
+
     // 座標たちを記録する配列。
     std::vector<Pos2D> points;
 
@@ -164,7 +175,10 @@ void update_mon_lite(PlayerType *player_ptr)
     if (!w_ptr->timewalk_m_idx) {
         MonsterEntity *m_ptr;
         MonsterRaceInfo *r_ptr;
-        for (int i = 1; i < floor_ptr->m_max; i++) {
+        std::vector<MONSTER_IDX> m_idxs;
+        const auto query_range = dis_lim + MON_LITE_QUERY_MARGIN;
+        floor_ptr->m_spatial_index.collect_in_rect(player_ptr->y - query_range, player_ptr->x - query_range, player_ptr->y + query_range, player_ptr->x + query_range, m_idxs);
+        for (const auto i : m_idxs) {
             m_ptr = &floor_ptr->m_list[i];
             r_ptr = &monraces_info[m_ptr->r_idx];
             if (!m_ptr->is_valid() || (m_ptr->cdis > dis_lim)) {
@@ -450,7 +450,7 @@ bool process_monster_movement(PlayerType *player_ptr, turn_flags *turn_flags_ptr
             }
         }
 
-        bool is_takable_or_killable = !g_ptr->o_idx_list.empty();
+        bool is_takable_or_killable = !player_ptr->current_floor_ptr->grid_array.o_idx_list(g_ptr).empty();
         is_takable_or_killable &= r_ptr->behavior_flags.has_any_of({ MonsterBehaviorType::TAKE_ITEM, MonsterBehaviorType::KILL_ITEM });
 
         bool is_pickup_items = (player_ptr->pet_extra_flags & PF_PICKUP_ITEMS) != 0;
@@ -187,7 +187,8 @@ void update_object_by_monster_movement(PlayerType *player_ptr, turn_flags *turn_
     g_ptr = &player_ptr->current_floor_ptr->grid_array[ny][nx];
 
     turn_flags_ptr->do_take = r_ptr->behavior_flags.has(MonsterBehaviorType::TAKE_ITEM);
-    for (auto it = g_ptr->o_idx_list.begin(); it != g_ptr->o_idx_list.end();) {
+    auto &o_idx_list = player_ptr->current_floor_ptr->grid_array.o_idx_list(g_ptr);
+    for (auto it = o_idx_list.begin(); it != o_idx_list.end();) {
         EnumClassFlagGroup<MonsterKindType> flg_monster_kind;
         EnumClassFlagGroup<MonsterResistanceType> flgr;
         GAME_TEXT m_name[MAX_NLEN], o_name[MAX_NLEN];
@@ -82,22 +82,16 @@ void delete_monster_idx(PlayerType *player_ptr, MONSTER_IDX i)
     }
 
     floor_ptr->grid_array[y][x].m_idx = 0;
+    floor_ptr->m_spatial_index.remove(i);
     for (auto it = m_ptr->hold_o_idx_list.begin(); it != m_ptr->hold_o_idx_list.end();) {
         const OBJECT_IDX this_o_idx = *it++;
         delete_object_idx(player_ptr, this_o_idx);
     }
 
-    // 召喚元のモンスターが消滅した時は、召喚されたモンスターのparent_m_idxが
-    // 召喚されたモンスター自身のm_idxを指すようにする
-    for (MONSTER_IDX child_m_idx = 1; child_m_idx < floor_ptr->m_max; child_m_idx++) {
-        MonsterEntity *child_m_ptr = &floor_ptr->m_list[child_m_idx];
-        if (MonsterRace(child_m_ptr->r_idx).is_valid() && child_m_ptr->parent_m_idx == i) {
-            child_m_ptr->parent_m_idx = child_m_idx;
-        }
-    }
-
+    // 要素の世代番号が進むため、召喚されたモンスターからは召喚元が消滅したと判定される
     *m_ptr = {};
     floor_ptr->m_cnt--;
+    floor_ptr->m_slots.release(i);
     lite_spot(player_ptr, y, x);
     if (r_ptr->brightness_flags.has_any_of(ld_mask)) {
         player_ptr->update |= (PU_MON_LITE);
@@ -155,6 +149,8 @@ void wipe_monsters_list(PlayerType *player_ptr)
 
     floor_ptr->m_max = 1;
     floor_ptr->m_cnt = 0;
+    floor_ptr->m_slots.reset();
+    floor_ptr->m_spatial_index.clear();
     for (int i = 0; i < MAX_MTIMED; i++) {
         floor_ptr->mproc_max[i] = 0;
     }
@@ -58,7 +58,7 @@ bool MonsterSweepGrid::get_movable_grid()
     auto y2 = this->player_ptr->y;
     auto x2 = this->player_ptr->x;
     this->will_run = this->mon_will_run();
-    const auto no_flow = m_ptr->mflag2.has(MonsterConstantFlagType::NOFLOW) && (floor_ptr->grid_array[m_ptr->fy][m_ptr->fx].get_cost(r_ptr) > 2);
+    const auto no_flow = m_ptr->mflag2.has(MonsterConstantFlagType::NOFLOW) && (floor_ptr->grid_array.get_cost(m_ptr->fy, m_ptr->fx, r_ptr) > 2);
     this->can_pass_wall = r_ptr->feature_flags.has(MonsterFeatureType::PASS_WALL) && ((this->m_idx != this->player_ptr->riding) || has_pass_wall(this->player_ptr));
     if (!this->will_run && m_ptr->target_y) {
         int t_m_idx = floor_ptr->grid_array[m_ptr->target_y][m_ptr->target_x].m_idx;
@@ -144,13 +144,13 @@ void MonsterSweepGrid::check_hiding_grid(POSITION *y, POSITION *x, POSITION *y2,
     }
 
     if ((!los(this->player_ptr, m_ptr->fy, m_ptr->fx, this->player_ptr->y, this->player_ptr->x) || !projectable(this->player_ptr, m_ptr->fy, m_ptr->fx, this->player_ptr->y, this->player_ptr->x))) {
-        if (floor_ptr->grid_array[m_ptr->fy][m_ptr->fx].get_distance(r_ptr) >= MAX_PLAYER_SIGHT / 2) {
+        if (floor_ptr->grid_array.get_distance(m_ptr->fy, m_ptr->fx, r_ptr) >= MAX_PLAYER_SIGHT / 2) {
             return;
         }
     }
 
     this->search_room_to_run(y, x);
-    if (this->done || (floor_ptr->grid_array[m_ptr->fy][m_ptr->fx].get_distance(r_ptr) >= 3)) {
+    if (this->done || (floor_ptr->grid_array.get_distance(m_ptr->fy, m_ptr->fx, r_ptr) >= 3)) {
         return;
     }
 
@@ -260,18 +260,20 @@ void MonsterSweepGrid::sweep_movable_grid(POSITION *yp, POSITION *xp, bool no_fl
 
     auto y1 = m_ptr->fy;
     auto x1 = m_ptr->fx;
-    auto *g_ptr = &floor_ptr->grid_array[y1][x1];
+    const auto &grid_array = floor_ptr->grid_array;
+    const auto cost = grid_array.get_cost(y1, x1, r_ptr);
     if (player_has_los_bold(this->player_ptr, y1, x1) && projectable(this->player_ptr, this->player_ptr->y, this->player_ptr->x, y1, x1)) {
-        if ((distance(y1, x1, this->player_ptr->y, this->player_ptr->x) == 1) || (r_ptr->freq_spell > 0) || (g_ptr->get_cost(r_ptr) > 5)) {
+        if ((distance(y1, x1, this->player_ptr->y, this->player_ptr->x) == 1) || (r_ptr->freq_spell > 0) || (cost > 5)) {
             return;
         }
     }
 
     auto use_scent = false;
-    if (g_ptr->get_cost(r_ptr)) {
+    const auto when = grid_array.when(y1, x1);
+    if (cost) {
         this->best = 999;
-    } else if (g_ptr->when) {
-        if (floor_ptr->grid_array[this->player_ptr->y][this->player_ptr->x].when - g_ptr->when > 127) {
+    } else if (when) {
+        if (grid_array.when(this->player_ptr->y, this->player_ptr->x) - when > 127) {
             return;
         }
 
@@ -324,7 +326,7 @@ bool MonsterSweepGrid::sweep_ranged_attack_grid(POSITION *yp, POSITION *xp)
         return false;
     }
 
-    auto now_cost = (int)floor_ptr->grid_array[y1][x1].get_cost(r_ptr);
+    auto now_cost = (int)floor_ptr->grid_array.get_cost(y1, x1, r_ptr);
     if (now_cost == 0) {
         now_cost = 999;
     }
@@ -344,8 +346,7 @@ bool MonsterSweepGrid::sweep_ranged_attack_grid(POSITION *yp, POSITION *xp)
             return false;
         }
 
-        auto *g_ptr = &floor_ptr->grid_array[y][x];
-        this->cost = (int)g_ptr->get_cost(r_ptr);
+        this->cost = (int)floor_ptr->grid_array.get_cost(y, x, r_ptr);
         if (!this->is_best_cost(y, x, now_cost)) {
             continue;
         }
@@ -420,7 +421,7 @@ bool MonsterSweepGrid::sweep_runnable_away_grid(POSITION *yp, POSITION *xp)
         }
 
         auto dis = distance(y, x, y1, x1);
-        auto s = 5000 / (dis + 3) - 500 / (floor_ptr->grid_array[y][x].get_distance(r_ptr) + 1);
+        auto s = 5000 / (dis + 3) - 500 / (floor_ptr->grid_array.get_distance(y, x, r_ptr) + 1);
         if (s < 0) {
             s = 0;
         }
@@ -453,9 +454,8 @@ void MonsterSweepGrid::determine_when_cost(POSITION *yp, POSITION *xp, POSITION
             continue;
         }
 
-        auto *g_ptr = &floor_ptr->grid_array[y][x];
         if (use_scent) {
-            int when = g_ptr->when;
+            int when = floor_ptr->grid_array.when(y, x);
             if (this->best > when) {
                 continue;
             }
@@ -463,7 +463,7 @@ void MonsterSweepGrid::determine_when_cost(POSITION *yp, POSITION *xp, POSITION
             this->best = when;
         } else {
             auto *r_ptr = &monraces_info[floor_ptr->m_list[this->m_idx].r_idx];
-            this->cost = r_ptr->behavior_flags.has_any_of({ MonsterBehaviorType::BASH_DOOR, MonsterBehaviorType::OPEN_DOOR }) ? g_ptr->get_distance(r_ptr) : g_ptr->get_cost(r_ptr);
+            this->cost = r_ptr->behavior_flags.has_any_of({ MonsterBehaviorType::BASH_DOOR, MonsterBehaviorType::OPEN_DOOR }) ? floor_ptr->grid_array.get_distance(y, x, r_ptr) : floor_ptr->grid_array.get_cost(y, x, r_ptr);
             if ((this->cost == 0) || (this->best < this->cost)) {
                 continue;
             }
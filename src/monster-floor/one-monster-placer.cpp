@@ -328,6 +328,7 @@ bool place_monster_one(PlayerType *player_ptr, MONSTER_IDX who, POSITION y, POSI
 
     m_ptr->fy = y;
     m_ptr->fx = x;
+    floor_ptr->m_spatial_index.place(g_ptr->m_idx, y, x);
     m_ptr->current_floor_ptr = floor_ptr;
 
     for (int cmi = 0; cmi < MAX_MTIMED; cmi++) {
@@ -342,6 +343,7 @@ bool place_monster_one(PlayerType *player_ptr, MONSTER_IDX who, POSITION y, POSI
     if (who > 0 && floor_ptr->m_list[who].is_pet()) {
         set_bits(mode, PM_FORCE_PET);
         m_ptr->parent_m_idx = who;
+        m_ptr->parent_generation = floor_ptr->m_slots.get_generation(who);
     } else {
         m_ptr->parent_m_idx = 0;
     }
@@ -39,6 +39,8 @@ static void compact_monsters_aux(PlayerType *player_ptr, MONSTER_IDX i1, MONSTER
     grid_type *g_ptr;
     g_ptr = &floor_ptr->grid_array[y][x];
     g_ptr->m_idx = i2;
+    floor_ptr->m_spatial_index.remove(i1);
+    floor_ptr->m_spatial_index.place(i2, y, x);
 
     for (const auto this_o_idx : m_ptr->hold_o_idx_list) {
         ItemEntity *o_ptr;
@@ -66,17 +68,20 @@ static void compact_monsters_aux(PlayerType *player_ptr, MONSTER_IDX i1, MONSTER
     }
 
     if (m_ptr->is_pet()) {
+        const auto generation = floor_ptr->m_slots.get_generation(i1);
         for (int i = 1; i < floor_ptr->m_max; i++) {
             MonsterEntity *m2_ptr = &floor_ptr->m_list[i];
 
-            if (m2_ptr->parent_m_idx == i1) {
+            if ((m2_ptr->parent_m_idx == i1) && (m2_ptr->parent_generation == generation)) {
                 m2_ptr->parent_m_idx = i2;
+                m2_ptr->parent_generation = floor_ptr->m_slots.get_generation(i2);
             }
         }
     }
 
     floor_ptr->m_list[i2] = floor_ptr->m_list[i1];
     floor_ptr->m_list[i1] = {};
+    floor_ptr->m_slots.release(i1);
 
     for (int i = 0; i < MAX_MTIMED; i++) {
         int mproc_idx = get_mproc_idx(floor_ptr, i1, i);
@@ -99,6 +104,10 @@ static void compact_monsters_aux(PlayerType *player_ptr, MONSTER_IDX i1, MONSTER
  *
  * After "compacting" (if needed), we "reorder" the monsters into a more
  * compact order, and we reset the allocation info, and the "live" array.
+ *
+ * 削除で空いた要素は空きリストから再利用されるため、ゲーム中は番号を詰め直さない.
+ * 詰め直すのはセーブファイルへ書き出す前 (size == 0) のみで、その際に召喚主の消滅した
+ * モンスターの parent_m_idx を自分自身に向け、世代番号を持たないセーブファイルでも判定できるようにする.
  */
 void compact_monsters(PlayerType *player_ptr, int size)
 {
@@ -151,6 +160,10 @@ void compact_monsters(PlayerType *player_ptr, int size)
         }
     }
 
+    if (size > 0) {
+        return;
+    }
+
     /* Excise dead monsters (backwards!) */
     for (MONSTER_IDX i = floor_ptr->m_max - 1; i >= 1; i--) {
         auto *m_ptr = &floor_ptr->m_list[i];
@@ -160,4 +173,13 @@ void compact_monsters(PlayerType *player_ptr, int size)
         compact_monsters_aux(player_ptr, floor_ptr->m_max - 1, i);
         floor_ptr->m_max--;
     }
+
+    floor_ptr->m_slots.clear_free_slots();
+    floor_ptr->m_scheduler.invalidate();
+    for (MONSTER_IDX i = 1; i < floor_ptr->m_max; i++) {
+        auto &monster = floor_ptr->m_list[i];
+        if ((monster.parent_m_idx != 0) && !floor_ptr->m_slots.is_current(monster.parent_m_idx, monster.parent_generation)) {
+            monster.parent_m_idx = i;
+        }
+    }
 }
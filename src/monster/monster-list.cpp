@@ -31,6 +31,7 @@
 #include "monster-race/race-indice-types.h"
 #include "monster/monster-describer.h"
 #include "monster/monster-info.h"
+#include "monster/monster-processor.h"
 #include "monster/monster-update.h"
 #include "monster/monster-util.h"
 #include "pet/pet-fall-off.h"
@@ -42,27 +43,192 @@
 #include "system/monster-entity.h"
 #include "system/monster-race-info.h"
 #include "system/player-type-definition.h"
-#include "util/probability-table.h"
+#include "util/alias-table.h"
 #include "view/display-messages.h"
 #include "world/world.h"
+#include <array>
 #include <iterator>
 
 #define HORDE_NOGOOD 0x01 /*!< (未実装フラグ)HORDE生成でGOODなモンスターの生成を禁止する？ */
 #define HORDE_NOEVIL 0x02 /*!< (未実装フラグ)HORDE生成でEVILなモンスターの生成を禁止する？ */
 
+/*!
+ * @brief get_mon_num() の抽選テーブルのキャッシュ
+ * @details 生成階の範囲と get_mon_num_prep() による重みが同じ間は同じテーブルを使い回す.
+ * 出現数に上限のある種族 (ユニーク等) は構築時に除外したかどうかを記録しておき、
+ * 使用時にはそれらだけを再判定して、どれかが変化していればテーブルを作り直す.
+ */
+struct MonsterAllocationCache {
+    bool is_valid = false;
+    DEPTH min_level = 0;
+    DEPTH max_level = 0;
+    bool ignore_population = false; //!< 出現数の上限を無視して構築したか
+    uint32_t generation = 0; //!< 構築時の alloc_race_table_generation
+    std::vector<std::pair<int, bool>> limited_entries; //!< 出現数に上限のある要素の位置と、構築時に除外したか
+    AliasTable<int> table;
+};
+
+static std::array<MonsterAllocationCache, 4> mon_num_caches;
+static size_t next_mon_num_cache = 0;
+
+/*!
+ * @brief 種族が出現数の上限を持つかを返す
+ * @param r_idx モンスター種族ID
+ * @param r_ref モンスター種族への参照
+ * @return ユニーク・ナズグル・UNIQUE2・バーノール＝ルパートならばtrue
+ */
+static bool has_population_limit(MonsterRaceId r_idx, const MonsterRaceInfo &r_ref)
+{
+    return r_ref.kind_flags.has(MonsterKindType::UNIQUE) || r_ref.population_flags.has(MonsterPopulationType::NAZGUL) || (r_ref.flags7 & RF7_UNIQUE2) || (r_idx == MonsterRaceId::BANORLUPART);
+}
+
+/*!
+ * @brief 種族が出現数の上限に達しているかを返す
+ * @param r_idx モンスター種族ID
+ * @param r_ref モンスター種族への参照
+ * @return これ以上生成できないならばtrue
+ */
+static bool is_population_exceeded(MonsterRaceId r_idx, const MonsterRaceInfo &r_ref)
+{
+    if ((r_ref.kind_flags.has(MonsterKindType::UNIQUE) || r_ref.population_flags.has(MonsterPopulationType::NAZGUL)) && (r_ref.cur_num >= r_ref.max_num)) {
+        return true;
+    }
+
+    if ((r_ref.flags7 & (RF7_UNIQUE2)) && (r_ref.cur_num >= 1)) {
+        return true;
+    }
+
+    if (r_idx == MonsterRaceId::BANORLUPART) {
+        if (monraces_info[MonsterRaceId::BANOR].cur_num > 0) {
+            return true;
+        }
+        if (monraces_info[MonsterRaceId::LUPART].cur_num > 0) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/*!
+ * @brief キャッシュした抽選テーブルが現在の状態でも使えるかを返す
+ * @param cache キャッシュへの参照
+ * @param min_level 最小生成階
+ * @param max_level 最大生成階
+ * @param ignore_population 出現数の上限を無視するか
+ * @return そのまま使えるならばtrue
+ */
+static bool is_mon_num_cache_fresh(const MonsterAllocationCache &cache, DEPTH min_level, DEPTH max_level, bool ignore_population)
+{
+    if (!cache.is_valid || (cache.generation != alloc_race_table_generation)) {
+        return false;
+    }
+
+    if ((cache.min_level != min_level) || (cache.max_level != max_level) || (cache.ignore_population != ignore_population)) {
+        return false;
+    }
+
+    for (const auto &[i, is_excluded] : cache.limited_entries) {
+        auto r_idx = i2enum<MonsterRaceId>(alloc_race_table[i].index);
+        if (is_population_exceeded(r_idx, monraces_info[r_idx]) != is_excluded) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/*!
+ * @brief 生成階の範囲に応じた抽選テーブルを取得する
+ * @param min_level 最小生成階
+ * @param max_level 最大生成階
+ * @param ignore_population 出現数の上限を無視するか
+ * @return 抽選テーブルへの参照 (alloc_race_table の要素位置をIDとする)
+ */
+static const AliasTable<int> &get_mon_num_table(DEPTH min_level, DEPTH max_level, bool ignore_population)
+{
+    for (const auto &cache : mon_num_caches) {
+        if (is_mon_num_cache_fresh(cache, min_level, max_level, ignore_population)) {
+            return cache.table;
+        }
+    }
+
+    auto &cache = mon_num_caches[next_mon_num_cache];
+    next_mon_num_cache = (next_mon_num_cache + 1) % mon_num_caches.size();
+    cache.is_valid = true;
+    cache.min_level = min_level;
+    cache.max_level = max_level;
+    cache.ignore_population = ignore_population;
+    cache.generation = alloc_race_table_generation;
+    cache.limited_entries.clear();
+    cache.table.clear();
+
+    /* Process probabilities */
+    for (auto i = 0U; i < alloc_race_table.size(); i++) {
+        const auto &entry = alloc_race_table[i];
+        if (entry.level < min_level) {
+            continue;
+        }
+        if (max_level < entry.level) {
+            break;
+        } // sorted by depth array,
+        if (entry.prob2 <= 0) {
+            continue;
+        }
+
+        auto r_idx = i2enum<MonsterRaceId>(entry.index);
+        const auto &r_ref = monraces_info[r_idx];
+        if (!ignore_population && has_population_limit(r_idx, r_ref)) {
+            const auto is_excluded = is_population_exceeded(r_idx, r_ref);
+            cache.limited_entries.emplace_back(i, is_excluded);
+            if (is_excluded) {
+                continue;
+            }
+        }
+
+        cache.table.entry_item(i, entry.prob2);
+    }
+
+    cache.table.build();
+    return cache.table;
+}
+
+/*!
+ * @brief 確保したモンスター配列の要素に、次のモンスター処理での行動予定を入れる
+ * @param floor_ptr 現在フロアへの参照ポインタ
+ * @param m_idx 確保した要素番号
+ * @details 現在のゲームターンのモンスター処理が始まった後に生まれたモンスターは、次のゲームターンから行動エネルギーを得る
+ */
+static void schedule_new_monster(FloorType *floor_ptr, MONSTER_IDX m_idx)
+{
+    const auto due_turn = floor_ptr->m_scheduler.get_next_turn(w_ptr->game_turn);
+    floor_ptr->m_scheduler.schedule(m_idx, floor_ptr->m_slots.get_generation(m_idx), due_turn, due_turn - 1);
+}
+
 /*!
  * @brief モンスター配列の空きを探す / Acquires and returns the index of a "free" monster.
  * @return 利用可能なモンスター配列の添字
  * @details
+ * 削除されたモンスターの要素を空きリストから優先して再利用し、無ければ配列の末尾を伸ばす.
  * This routine should almost never fail, but it *can* happen.
  */
 MONSTER_IDX m_pop(FloorType *floor_ptr)
 {
+    const auto recycled_idx = floor_ptr->m_slots.acquire([floor_ptr](MONSTER_IDX idx) {
+        return (idx < floor_ptr->m_max) && !floor_ptr->m_list[idx].is_valid();
+    });
+    if (recycled_idx > 0) {
+        floor_ptr->m_cnt++;
+        schedule_new_monster(floor_ptr, recycled_idx);
+        return recycled_idx;
+    }
+
     /* Normal allocation */
     if (floor_ptr->m_max < w_ptr->max_m_idx) {
         MONSTER_IDX i = floor_ptr->m_max;
         floor_ptr->m_max++;
         floor_ptr->m_cnt++;
+        schedule_new_monster(floor_ptr, i);
         return i;
     }
 
@@ -74,6 +240,7 @@ MONSTER_IDX m_pop(FloorType *floor_ptr)
             continue;
         }
         floor_ptr->m_cnt++;
+        schedule_new_monster(floor_ptr, i);
         return i;
     }
 
@@ -139,40 +306,7 @@ MonsterRaceId get_mon_num(PlayerType *player_ptr, DEPTH min_level, DEPTH max_lev
         }
     }
 
-    ProbabilityTable<int> prob_table;
-
-    /* Process probabilities */
-    for (auto i = 0U; i < alloc_race_table.size(); i++) {
-        const auto &entry = alloc_race_table[i];
-        if (entry.level < min_level) {
-            continue;
-        }
-        if (max_level < entry.level) {
-            break;
-        } // sorted by depth array,
-        auto r_idx = i2enum<MonsterRaceId>(entry.index);
-        auto r_ptr = &monraces_info[r_idx];
-        if (!(option & GMN_ARENA) && !chameleon_change_m_idx) {
-            if ((r_ptr->kind_flags.has(MonsterKindType::UNIQUE) || r_ptr->population_flags.has(MonsterPopulationType::NAZGUL)) && (r_ptr->cur_num >= r_ptr->max_num)) {
-                continue;
-            }
-
-            if ((r_ptr->flags7 & (RF7_UNIQUE2)) && (r_ptr->cur_num >= 1)) {
-                continue;
-            }
-
-            if (r_idx == MonsterRaceId::BANORLUPART) {
-                if (monraces_info[MonsterRaceId::BANOR].cur_num > 0) {
-                    continue;
-                }
-                if (monraces_info[MonsterRaceId::LUPART].cur_num > 0) {
-                    continue;
-                }
-            }
-        }
-
-        prob_table.entry_item(i, entry.prob2);
-    }
+    const auto &prob_table = get_mon_num_table(min_level, max_level, (option & GMN_ARENA) || chameleon_change_m_idx);
 
     if (cheat_hear) {
         msg_format(_("モンスター第3次候補数:%d(%d-%dF)%d ", "monster third selection:%d(%d-%dF)%d "), prob_table.item_count(), min_level, max_level,
@@ -195,7 +329,7 @@ MonsterRaceId get_mon_num(PlayerType *player_ptr, DEPTH min_level, DEPTH max_lev
     }
 
     std::vector<int> result;
-    ProbabilityTable<int>::lottery(std::back_inserter(result), prob_table, n);
+    std::generate_n(std::back_inserter(result), n, [&prob_table] { return prob_table.pick_one_at_random(); });
 
     auto it = std::max_element(result.begin(), result.end(), [](int a, int b) { return alloc_race_table[a].level < alloc_race_table[b].level; });
 
@@ -389,7 +523,9 @@ void choose_new_monster(PlayerType *player_ptr, MONSTER_IDX m_idx, bool born, Mo
         }
     }
 
+    settle_monster_energy(player_ptr, m_idx);
     m_ptr->mspeed = get_mspeed(floor_ptr, r_ptr);
+    reschedule_monster(player_ptr, m_idx);
 
     int oldmaxhp = m_ptr->max_maxhp;
     if (r_ptr->flags1 & RF1_FORCE_MAXHP) {
@@ -16,6 +16,7 @@
 #include "avatar/avatar.h"
 #include "cmd-io/cmd-dump.h"
 #include "core/player-update-types.h"
+#include "core/profiler.h"
 #include "core/speed-table.h"
 #include "floor/cave.h"
 #include "floor/geometry.h"
@@ -67,6 +68,8 @@
 #include "system/player-type-definition.h"
 #include "target/projection-path-calculator.h"
 #include "view/display-messages.h"
+#include "world/world.h"
+#include <algorithm>
 
 void decide_drop_from_monster(PlayerType *player_ptr, MONSTER_IDX m_idx, bool is_riding_mon);
 bool process_stealth(PlayerType *player_ptr, MONSTER_IDX m_idx);
@@ -265,8 +268,9 @@ bool vanish_summoned_children(PlayerType *player_ptr, MONSTER_IDX m_idx, bool se
         return false;
     }
 
-    // parent_m_idxが自分自身を指している場合は召喚主は消滅している
-    if (m_ptr->parent_m_idx != m_idx && MonsterRace(player_ptr->current_floor_ptr->m_list[m_ptr->parent_m_idx].r_idx).is_valid()) {
+    // parent_m_idxが自分自身を指している場合や、召喚主の要素が召喚後に解放されている場合は召喚主は消滅している
+    const auto &m_slots = player_ptr->current_floor_ptr->m_slots;
+    if ((m_ptr->parent_m_idx != m_idx) && m_slots.is_current(m_ptr->parent_m_idx, m_ptr->parent_generation)) {
         return false;
     }
 
@@ -550,6 +554,7 @@ bool process_monster_fear(PlayerType *player_ptr, turn_flags *turn_flags_ptr, MO
  * monsters while they are still being "born".  A monster is "fresh" only\n
  * during the game turn in which it is created, and we use the "hack_m_idx" to\n
  * determine if the monster is yet to be processed during the game turn.\n
+ * 行動予定は生まれたモンスターを処理中のゲームターンに入れないため、BORNフラグは処理時に消すだけでよい.\n
  *\n
  * Note the special "MFLAG_PREVENT_MAGIC" flag, which allows the player to get one\n
  * move before any "nasty" monsters get to use their spell attacks.\n
@@ -560,6 +565,7 @@ bool process_monster_fear(PlayerType *player_ptr, turn_flags *turn_flags_ptr, MO
  */
 void process_monsters(PlayerType *player_ptr)
 {
+    ProfileScope profile_scope(ProfileSection::MONSTERS);
     old_race_flags tmp_flags;
     old_race_flags *old_race_flags_ptr = init_old_race_flags(&tmp_flags);
     player_ptr->current_floor_ptr->monster_noise = false;
@@ -574,37 +580,149 @@ void process_monsters(PlayerType *player_ptr)
     update_player_window(player_ptr, old_race_flags_ptr);
 }
 
+/*!
+ * @brief 行動エネルギーが尽きるまでのゲームターン数を返す
+ * @param energy_need 残りの行動エネルギー
+ * @param energy 1ゲームターン毎に得る行動エネルギー
+ * @return ゲームターン数 (既に尽きていれば1)
+ */
+static GAME_TURN calc_turns_to_act(int energy_need, int energy)
+{
+    if (energy_need <= 0) {
+        return 1;
+    }
+
+    return (energy_need + energy - 1) / energy;
+}
+
+/*!
+ * @brief 精算済みのゲームターンから指定のゲームターンまでの行動エネルギーをまとめて得る
+ * @param m_ptr モンスターへの参照ポインタ
+ * @param energy 1ゲームターン毎に得る行動エネルギー
+ * @param settled_turn 行動エネルギーを精算済みのゲームターン
+ * @param turn 行動エネルギーを得る最後のゲームターン
+ */
+static void gain_energy(MonsterEntity *m_ptr, int energy, GAME_TURN settled_turn, GAME_TURN turn)
+{
+    if (turn <= settled_turn) {
+        return;
+    }
+
+    const auto energy_need = m_ptr->energy_need - energy * static_cast<int>(turn - settled_turn);
+    m_ptr->energy_need = static_cast<int16_t>(std::max(energy_need, 1 - energy));
+}
+
+/*!
+ * @brief モンスターの次の行動予定を入れる
+ * @param player_ptr プレイヤーへの参照ポインタ
+ * @param m_idx モンスターID
+ * @param settled_turn 行動エネルギーを精算済みのゲームターン
+ * @param energy_need 予定の計算に用いる残りの行動エネルギー
+ * @details プレイヤーが騎乗しているモンスターはプレイヤーの速度で動くため、毎ゲームターン処理する
+ */
+static void schedule_monster(PlayerType *player_ptr, MONSTER_IDX m_idx, GAME_TURN settled_turn, int energy_need)
+{
+    auto *floor_ptr = player_ptr->current_floor_ptr;
+    const auto &monster = floor_ptr->m_list[m_idx];
+    auto due_turn = floor_ptr->m_scheduler.get_earliest_turn(m_idx, w_ptr->game_turn);
+    if (player_ptr->riding != m_idx) {
+        due_turn = std::max(due_turn, settled_turn + calc_turns_to_act(energy_need, speed_to_energy(monster.get_temporary_speed())));
+    }
+
+    floor_ptr->m_scheduler.schedule(m_idx, floor_ptr->m_slots.get_generation(m_idx), due_turn, settled_turn);
+}
+
+/*!
+ * @brief 速度が変わる前に、これまでの行動エネルギーを元の速度で精算する
+ * @param player_ptr プレイヤーへの参照ポインタ
+ * @param m_idx モンスターID
+ * @details
+ * 毎ゲームターン処理していれば既に得ているはずのゲームターンまでを精算する.
+ * 速度を変えた後に reschedule_monster() で予定を入れ直すこと
+ */
+void settle_monster_energy(PlayerType *player_ptr, MONSTER_IDX m_idx)
+{
+    auto *floor_ptr = player_ptr->current_floor_ptr;
+    auto *m_ptr = &floor_ptr->m_list[m_idx];
+    if (!m_ptr->is_valid() || (player_ptr->riding == m_idx) || player_ptr->wild_mode) {
+        return;
+    }
+
+    auto &scheduler = floor_ptr->m_scheduler;
+    const auto credited_turn = scheduler.get_earliest_turn(m_idx, w_ptr->game_turn) - 1;
+    gain_energy(m_ptr, speed_to_energy(m_ptr->get_temporary_speed()), scheduler.get_settled_turn(m_idx), credited_turn);
+    scheduler.settle(m_idx, credited_turn);
+}
+
+/*!
+ * @brief 速度の変わったモンスターの行動予定を入れ直す
+ * @param player_ptr プレイヤーへの参照ポインタ
+ * @param m_idx モンスターID
+ * @details 速度を変える前に settle_monster_energy() で行動エネルギーを精算しておくこと
+ */
+void reschedule_monster(PlayerType *player_ptr, MONSTER_IDX m_idx)
+{
+    const auto &monster = player_ptr->current_floor_ptr->m_list[m_idx];
+    if (!monster.is_valid()) {
+        return;
+    }
+
+    schedule_monster(player_ptr, m_idx, player_ptr->current_floor_ptr->m_scheduler.get_settled_turn(m_idx), monster.energy_need);
+}
+
 /*!
  * @brief フロア内のモンスターについてターン終了時の処理を繰り返す
  * @param player_ptr プレイヤーへの参照ポインタ
+ * @details
+ * 行動予定のあるモンスターだけを、モンスターIDの降順に処理する.
+ * 行動エネルギーは前回の精算からの経過ゲームターン分をまとめて得る.
+ * 予定のターンにプレイヤーを感知していないモンスターはそのターンのエネルギーを得ず、次のゲームターンに再び判定する.
  */
 void sweep_monster_process(PlayerType *player_ptr)
 {
     auto *floor_ptr = player_ptr->current_floor_ptr;
-    for (MONSTER_IDX i = floor_ptr->m_max - 1; i >= 1; i--) {
-        MonsterEntity *m_ptr;
-        m_ptr = &floor_ptr->m_list[i];
+    auto &scheduler = floor_ptr->m_scheduler;
+    const auto turn = w_ptr->game_turn;
+    if (!scheduler.begin_turn(turn)) {
+        for (MONSTER_IDX i = floor_ptr->m_max - 1; i >= 1; i--) {
+            if (floor_ptr->m_list[i].is_valid()) {
+                scheduler.schedule(i, floor_ptr->m_slots.get_generation(i), turn, turn - 1);
+            }
+        }
+    }
 
+    scheduler.pop_due(turn);
+    MonsterScheduler::Entry entry;
+    while (scheduler.pop_next(turn, entry)) {
         if (player_ptr->leaving) {
+            scheduler.invalidate();
             return;
         }
 
-        if (!m_ptr->is_valid() || player_ptr->wild_mode) {
+        const auto i = entry.m_idx;
+        auto *m_ptr = &floor_ptr->m_list[i];
+        if (!floor_ptr->m_slots.is_current(i, entry.generation) || !m_ptr->is_valid()) {
             continue;
         }
 
-        if (m_ptr->mflag.has(MonsterTemporaryFlagType::BORN)) {
-            m_ptr->mflag.reset(MonsterTemporaryFlagType::BORN);
+        const auto settled_turn = scheduler.get_settled_turn(i);
+        if (player_ptr->wild_mode) {
+            schedule_monster(player_ptr, i, turn, 0);
             continue;
         }
 
+        m_ptr->mflag.reset(MonsterTemporaryFlagType::BORN);
+        const auto is_riding = player_ptr->riding == i;
+        const int energy = speed_to_energy(is_riding ? player_ptr->pspeed : m_ptr->get_temporary_speed());
         if ((m_ptr->cdis >= MAX_MONSTER_SENSING) || !decide_process_continue(player_ptr, m_ptr)) {
+            gain_energy(m_ptr, energy, settled_turn, turn - 1);
+            scheduler.schedule(i, entry.generation, turn + 1, turn);
             continue;
         }
 
-        byte speed = (player_ptr->riding == i) ? player_ptr->pspeed : m_ptr->get_temporary_speed();
-        m_ptr->energy_need -= speed_to_energy(speed);
+        gain_energy(m_ptr, energy, settled_turn, turn);
         if (m_ptr->energy_need > 0) {
+            schedule_monster(player_ptr, i, turn, m_ptr->energy_need);
             continue;
         }
 
@@ -616,10 +734,17 @@ void sweep_monster_process(PlayerType *player_ptr)
             m_ptr->mflag2.set(MonsterConstantFlagType::NOFLOW);
         }
 
+        if (floor_ptr->m_slots.is_current(i, entry.generation) && m_ptr->is_valid()) {
+            schedule_monster(player_ptr, i, turn, m_ptr->energy_need);
+        }
+
         if (!player_ptr->playing || player_ptr->is_dead || player_ptr->leaving) {
+            scheduler.invalidate();
             return;
         }
     }
+
+    scheduler.end_sweep();
 }
 
 /*!
@@ -5,3 +5,5 @@
 class PlayerType;
 void process_monsters(PlayerType *player_ptr);
 void process_monster(PlayerType *player_ptr, MONSTER_IDX m_idx);
+void settle_monster_energy(PlayerType *player_ptr, MONSTER_IDX m_idx);
+void reschedule_monster(PlayerType *player_ptr, MONSTER_IDX m_idx);
@@ -0,0 +1,181 @@
+﻿#include "monster/monster-scheduler.h"
+#include <algorithm>
+#include <limits>
+
+/*!
+ * @brief モンスターの行動予定を入れる
+ * @param m_idx モンスターID
+ * @param generation モンスター配列要素の現在の世代番号
+ * @param due_turn 予定ターン
+ * @param settled_turn 行動エネルギーを精算済みのゲームターン
+ * @details 同じモンスターに以前入れた予定は無効になる
+ */
+void MonsterScheduler::schedule(MONSTER_IDX m_idx, uint32_t generation, GAME_TURN due_turn, GAME_TURN settled_turn)
+{
+    if (m_idx <= 0) {
+        return;
+    }
+
+    if (static_cast<size_t>(m_idx) >= this->due_turns.size()) {
+        this->due_turns.resize(m_idx + 1, 0);
+        this->settled_turns.resize(m_idx + 1, 0);
+    }
+
+    this->due_turns[m_idx] = due_turn;
+    this->settled_turns[m_idx] = settled_turn;
+    const Entry entry{ m_idx, generation, due_turn };
+    if ((due_turn == this->last_turn) && (m_idx < this->cursor)) {
+        const auto is_less = [](const auto &a, const auto &b) { return a.m_idx < b.m_idx; };
+        this->due_entries.insert(std::upper_bound(this->due_entries.begin(), this->due_entries.end(), entry, is_less), entry);
+        return;
+    }
+
+    this->wheel[due_turn & (WHEEL_SIZE - 1)].push_back(entry);
+}
+
+/*!
+ * @brief モンスターの行動エネルギーを精算済みのゲームターンを進める
+ * @param m_idx モンスターID
+ * @param settled_turn 行動エネルギーを精算済みのゲームターン
+ * @details 予定ターンは変えない. 精算済みのゲームターンは巻き戻さない
+ */
+void MonsterScheduler::settle(MONSTER_IDX m_idx, GAME_TURN settled_turn)
+{
+    if ((m_idx <= 0) || (static_cast<size_t>(m_idx) >= this->settled_turns.size())) {
+        return;
+    }
+
+    this->settled_turns[m_idx] = std::max(this->settled_turns[m_idx], settled_turn);
+}
+
+/*!
+ * @brief モンスターの行動エネルギーを精算済みのゲームターンを返す
+ * @param m_idx モンスターID
+ * @return 精算済みのゲームターン
+ */
+GAME_TURN MonsterScheduler::get_settled_turn(MONSTER_IDX m_idx) const
+{
+    if ((m_idx <= 0) || (static_cast<size_t>(m_idx) >= this->settled_turns.size())) {
+        return 0;
+    }
+
+    return this->settled_turns[m_idx];
+}
+
+/*!
+ * @brief これから予定を入れるモンスターが最も早く処理されるゲームターンを返す
+ * @param turn 現在のゲームターン
+ * @return 現在のゲームターンの処理が始まっていれば次のゲームターン、まだなら現在のゲームターン
+ */
+GAME_TURN MonsterScheduler::get_next_turn(GAME_TURN turn) const
+{
+    return (this->last_turn == turn) ? turn + 1 : turn;
+}
+
+/*!
+ * @brief 既にいるモンスターが最も早く処理されるゲームターンを返す
+ * @param m_idx モンスターID
+ * @param turn 現在のゲームターン
+ * @return 現在のゲームターンでまだ順番が来ていなければ現在のゲームターン、順番が過ぎていれば次のゲームターン
+ * @details 戻り値の1つ前のゲームターンまでは、元の毎ターンの処理であれば行動エネルギーを得ている
+ */
+GAME_TURN MonsterScheduler::get_earliest_turn(MONSTER_IDX m_idx, GAME_TURN turn) const
+{
+    if (this->last_turn != turn) {
+        return turn;
+    }
+
+    return (m_idx < this->cursor) ? turn : turn + 1;
+}
+
+/*!
+ * @brief ゲームターンの処理を始める
+ * @param turn 処理するゲームターン
+ * @return 前回の処理から予定が途切れずに続いていればtrue
+ * @details
+ * 予定が無効にされていたり、ゲームターンが飛んだり巻き戻ったりした時は全ての予定を捨ててfalseを返す.
+ * その場合、呼び出し側は全モンスターの予定を入れ直すこと
+ */
+bool MonsterScheduler::begin_turn(GAME_TURN turn)
+{
+    const auto is_continuous = this->is_valid && ((turn == this->last_turn) || (turn == this->last_turn + 1));
+    if (!is_continuous) {
+        for (auto &bucket : this->wheel) {
+            bucket.clear();
+        }
+
+        this->is_valid = true;
+    }
+
+    this->last_turn = turn;
+    return is_continuous;
+}
+
+/*!
+ * @brief 指定のゲームターンに予定のあるモンスターを取り出し、処理待ちの列に並べる
+ * @param turn ゲームターン
+ * @details 取り出した予定は輪から消えるため、処理しきれなかった時は invalidate() すること
+ */
+void MonsterScheduler::pop_due(GAME_TURN turn)
+{
+    this->due_entries.clear();
+    auto &bucket = this->wheel[turn & (WHEEL_SIZE - 1)];
+    auto kept = bucket.begin();
+    for (const auto &entry : bucket) {
+        if (entry.turn > turn) {
+            *kept++ = entry;
+            continue;
+        }
+
+        if ((entry.turn == turn) && (this->due_turns[entry.m_idx] == turn)) {
+            this->due_entries.push_back(entry);
+        }
+    }
+
+    bucket.erase(kept, bucket.end());
+    std::sort(this->due_entries.begin(), this->due_entries.end(), [](const auto &a, const auto &b) { return a.m_idx < b.m_idx; });
+    this->cursor = std::numeric_limits<MONSTER_IDX>::max();
+}
+
+/*!
+ * @brief 処理待ちの列からモンスターIDの降順に次の予定を取り出す
+ * @param turn 処理中のゲームターン
+ * @param entry 取り出した予定
+ * @return 予定があればtrue
+ * @details 予定を入れ直されて無効になったものや、既に順番の過ぎたモンスターの予定は読み捨てる
+ */
+bool MonsterScheduler::pop_next(GAME_TURN turn, Entry &entry)
+{
+    while (!this->due_entries.empty()) {
+        entry = this->due_entries.back();
+        this->due_entries.pop_back();
+        if ((entry.m_idx >= this->cursor) || (this->due_turns[entry.m_idx] != turn)) {
+            continue;
+        }
+
+        this->cursor = entry.m_idx;
+        return true;
+    }
+
+    return false;
+}
+
+/*!
+ * @brief ゲームターンの処理を終える
+ * @details 以降に予定を入れ直したモンスターは、全て次のゲームターン以降に処理する
+ */
+void MonsterScheduler::end_sweep()
+{
+    this->due_entries.clear();
+    this->cursor = 0;
+}
+
+/*!
+ * @brief 全ての予定を無効にする
+ * @details モンスター配列を詰め直した時のように、モンスターIDがまとめて変わった時に呼ぶ
+ */
+void MonsterScheduler::invalidate()
+{
+    this->is_valid = false;
+    this->end_sweep();
+}
@@ -0,0 +1,50 @@
+﻿#pragma once
+
+#include "system/angband.h"
+#include <array>
+#include <cstdint>
+#include <vector>
+
+/*!
+ * @brief モンスターの行動予定をゲームターン毎の輪 (タイミングホイール) に並べる
+ * @details
+ * 各モンスターの energy_need が尽きる見込みのゲームターンに予定を入れ、そのターンに予定のあるモンスターだけを処理する.
+ * 予定を入れ直しても古い予定は消さず、取り出す時にモンスター毎の最新の予定ターンと照合して読み捨てる.
+ * 予定ターンは輪の大きさを超えてもよく、一周しても予定ターンに達していない予定は次の周回まで残す.
+ * 処理中のゲームターンに、まだ順番の来ていないモンスターの予定を入れ直した時は、そのターンの処理待ちの列に加える.
+ */
+class MonsterScheduler {
+public:
+    /*!
+     * @brief 行動予定
+     */
+    struct Entry {
+        MONSTER_IDX m_idx; //!< モンスターID
+        uint32_t generation; //!< 予定を入れた時のモンスター配列要素の世代番号
+        GAME_TURN turn; //!< 予定ターン
+    };
+
+    MonsterScheduler() = default;
+
+    void schedule(MONSTER_IDX m_idx, uint32_t generation, GAME_TURN due_turn, GAME_TURN settled_turn);
+    void settle(MONSTER_IDX m_idx, GAME_TURN settled_turn);
+    GAME_TURN get_settled_turn(MONSTER_IDX m_idx) const;
+    GAME_TURN get_next_turn(GAME_TURN turn) const;
+    GAME_TURN get_earliest_turn(MONSTER_IDX m_idx, GAME_TURN turn) const;
+    bool begin_turn(GAME_TURN turn);
+    void pop_due(GAME_TURN turn);
+    bool pop_next(GAME_TURN turn, Entry &entry);
+    void end_sweep();
+    void invalidate();
+
+private:
+    static constexpr auto WHEEL_SIZE = 256; //!< 輪の大きさ (2の冪)
+
+    std::array<std::vector<Entry>, WHEEL_SIZE> wheel{};
+    std::vector<GAME_TURN> due_turns; //!< モンスター毎の最新の予定ターン
+    std::vector<GAME_TURN> settled_turns; //!< モンスター毎の、行動エネルギーを精算済みのゲームターン
+    std::vector<Entry> due_entries; //!< 処理待ちの予定 (モンスターIDの昇順、末尾から処理する)
+    GAME_TURN last_turn = 0; //!< 最後に予定を取り出したゲームターン
+    MONSTER_IDX cursor = 0; //!< 処理中のモンスターID (これより小さいIDはまだ順番が来ていない). 処理中でなければ0
+    bool is_valid = false; //!< 全モンスターの予定が揃っているか
+};
@@ -168,11 +168,17 @@ bool set_monster_fast(PlayerType *player_ptr, MONSTER_IDX m_idx, int v)
         }
     }
 
+    if (notice) {
+        settle_monster_energy(player_ptr, m_idx);
+    }
+
     m_ptr->mtimed[MTIMED_FAST] = (int16_t)v;
     if (!notice) {
         return false;
     }
 
+    reschedule_monster(player_ptr, m_idx);
+
     if ((player_ptr->riding == m_idx) && !player_ptr->leaving) {
         player_ptr->update |= PU_BONUS;
     }
@@ -202,11 +208,17 @@ bool set_monster_slow(PlayerType *player_ptr, MONSTER_IDX m_idx, int v)
         }
     }
 
+    if (notice) {
+        settle_monster_energy(player_ptr, m_idx);
+    }
+
     m_ptr->mtimed[MTIMED_SLOW] = (int16_t)v;
     if (!notice) {
         return false;
     }
 
+    reschedule_monster(player_ptr, m_idx);
+
     if ((player_ptr->riding == m_idx) && !player_ptr->leaving) {
         player_ptr->update |= PU_BONUS;
     }
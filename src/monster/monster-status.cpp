@@ -16,6 +16,7 @@
 #include "monster/monster-describer.h"
 #include "monster/monster-info.h"
 #include "monster/monster-list.h"
+#include "monster/monster-processor.h"
 #include "monster/monster-status-setter.h" //!< @todo 相互依存. 後で何とかする.
 #include "monster/monster-update.h"
 #include "system/floor-type-definition.h"
@@ -472,7 +473,9 @@ void monster_gain_exp(PlayerType *player_ptr, MONSTER_IDX m_idx, MonsterRaceId s
     m_ptr->dealt_damage = 0;
 
     /* Extract the monster base speed */
+    settle_monster_energy(player_ptr, m_idx);
     m_ptr->mspeed = get_mspeed(floor_ptr, r_ptr);
+    reschedule_monster(player_ptr, m_idx);
 
     /* Sub-alignment of a monster */
     if (!m_ptr->is_pet() && r_ptr->kind_flags.has_none_of(alignment_mask)) {
@@ -47,7 +47,23 @@
 #include "timed-effect/player-hallucination.h"
 #include "timed-effect/timed-effects.h"
 #include "util/bit-flags-calculator.h"
+#include "util/worker-pool.h"
 #include "world/world.h"
+#include <algorithm>
+#include <vector>
+
+constexpr auto UPDATE_MONSTERS_CHUNK_SIZE = 128; //!< update_monsters() で1スレッドがまとめて判定するモンスターの数 (これ以下なら並列化しない. --simulate-crowd の計測結果で決める)
+
+/*!
+ * @brief モンスターの感知判定に用いるプレイヤー側の状態 (全モンスターで共通)
+ */
+struct um_player_type {
+    bool in_darkness;
+    bool is_hallucinated;
+    bool is_blind;
+    bool is_musou;
+    bool has_radar;
+};
 
 // Update Monster.
 struct um_type {
@@ -57,8 +73,12 @@ struct um_type {
     POSITION fx;
     bool flag;
     bool easy;
-    bool in_darkness;
     bool full;
+    POSITION distance; //!< プレイヤーとの距離 (full なら計算し直した値)
+    bool esp; //!< テレパシー類で感知したか
+    bool smart_stupid; //!< テレパシーで賢さの思い出を更新するか
+    BIT_FLAGS lore_flags2; //!< 思い出に記録するRF2フラグ
+    EnumClassFlagGroup<MonsterKindType> lore_kinds; //!< 思い出に記録する種族・徳フラグ
 };
 
 /*!
@@ -85,12 +105,14 @@ bool update_riding_monster(PlayerType *player_ptr, turn_flags *turn_flags_ptr, M
     if (g_ptr->m_idx) {
         y_ptr->fy = oy;
         y_ptr->fx = ox;
+        player_ptr->current_floor_ptr->m_spatial_index.place(g_ptr->m_idx, oy, ox);
         update_monster(player_ptr, g_ptr->m_idx, true);
     }
 
     g_ptr->m_idx = m_idx;
     m_ptr->fy = ny;
     m_ptr->fx = nx;
+    player_ptr->current_floor_ptr->m_spatial_index.place(m_idx, ny, nx);
     update_monster(player_ptr, m_idx, true);
 
     lite_spot(player_ptr, oy, ox);
@@ -179,6 +201,19 @@ void update_player_window(PlayerType *player_ptr, old_race_flags *old_race_flags
     }
 }
 
+static um_player_type initialize_um_player_type(PlayerType *player_ptr)
+{
+    um_player_type up;
+    up.in_darkness = dungeons_info[player_ptr->dungeon_idx].flags.has(DungeonFeatureType::DARKNESS) && !player_ptr->see_nocto;
+    up.is_hallucinated = player_ptr->effects()->hallucination()->is_hallucinated();
+    up.is_blind = player_ptr->effects()->blindness()->is_blind();
+    PlayerClass pc(player_ptr);
+    up.is_musou = pc.samurai_stance_is(SamuraiStanceType::MUSOU);
+    auto sniper_data = pc.get_specific_data<sniper_data_type>();
+    up.has_radar = sniper_data && (sniper_data->concent >= CONCENT_RADAR_THRESHOLD);
+    return up;
+}
+
 static um_type *initialize_um_type(PlayerType *player_ptr, um_type *um_ptr, MONSTER_IDX m_idx, bool full)
 {
     um_ptr->m_ptr = &player_ptr->current_floor_ptr->m_list[m_idx];
@@ -187,15 +222,19 @@ static um_type *initialize_um_type(PlayerType *player_ptr, um_type *um_ptr, MONS
     um_ptr->fx = um_ptr->m_ptr->fx;
     um_ptr->flag = false;
     um_ptr->easy = false;
-    um_ptr->in_darkness = dungeons_info[player_ptr->dungeon_idx].flags.has(DungeonFeatureType::DARKNESS) && !player_ptr->see_nocto;
     um_ptr->full = full;
+    um_ptr->distance = um_ptr->m_ptr->cdis;
+    um_ptr->esp = false;
+    um_ptr->smart_stupid = false;
+    um_ptr->lore_flags2 = 0;
+    um_ptr->lore_kinds.clear();
     return um_ptr;
 }
 
 static POSITION decide_updated_distance(PlayerType *player_ptr, um_type *um_ptr)
 {
     if (!um_ptr->full) {
-        return um_ptr->m_ptr->cdis;
+        return um_ptr->distance;
     }
 
     int dy = (player_ptr->y > um_ptr->fy) ? (player_ptr->y - um_ptr->fy) : (um_ptr->fy - player_ptr->y);
@@ -209,7 +248,7 @@ static POSITION decide_updated_distance(PlayerType *player_ptr, um_type *um_ptr)
         distance = 1;
     }
 
-    um_ptr->m_ptr->cdis = distance;
+    um_ptr->distance = distance;
     return distance;
 }
 
@@ -224,17 +263,25 @@ static void update_smart_stupid_flags(MonsterRaceInfo *r_ptr)
     }
 }
 
+/*!
+ * @brief テレパシー類でモンスターを感知した結果を記録する
+ * @param um_ptr モンスター情報アップデート構造体への参照ポインタ
+ */
+static void sense_by_telepathy(um_type *um_ptr)
+{
+    um_ptr->flag = true;
+    um_ptr->esp = true;
+}
+
 /*!
  * @brief WEIRD_MINDフラグ持ちのモンスターを1/10の確率でテレパシーに引っかける
- * @param player_ptr プレイヤーへの参照ポインタ
  * @param um_ptr モンスター情報アップデート構造体への参照ポインタ
  * @param m_idx モンスターID
  * @return WEIRD_MINDフラグがあるならTRUE
  */
-static bool update_weird_telepathy(PlayerType *player_ptr, um_type *um_ptr, MONSTER_IDX m_idx)
+static bool update_weird_telepathy(um_type *um_ptr, MONSTER_IDX m_idx)
 {
-    auto *m_ptr = um_ptr->m_ptr;
-    auto *r_ptr = &monraces_info[m_ptr->r_idx];
+    const auto *r_ptr = &monraces_info[um_ptr->m_ptr->r_idx];
     if ((r_ptr->flags2 & RF2_WEIRD_MIND) == 0) {
         return false;
     }
@@ -243,27 +290,17 @@ static bool update_weird_telepathy(PlayerType *player_ptr, um_type *um_ptr, MONS
         return true;
     }
 
-    um_ptr->flag = true;
-    m_ptr->mflag.set(MonsterTemporaryFlagType::ESP);
-    if (m_ptr->is_original_ap() && !player_ptr->effects()->hallucination()->is_hallucinated()) {
-        r_ptr->r_flags2 |= RF2_WEIRD_MIND;
-        update_smart_stupid_flags(r_ptr);
-    }
-
+    sense_by_telepathy(um_ptr);
+    um_ptr->smart_stupid = true;
+    um_ptr->lore_flags2 |= RF2_WEIRD_MIND;
     return true;
 }
 
-static void update_telepathy_sight(PlayerType *player_ptr, um_type *um_ptr, MONSTER_IDX m_idx)
+static void update_telepathy_sight(PlayerType *player_ptr, const um_player_type &up, um_type *um_ptr, MONSTER_IDX m_idx)
 {
-    auto *m_ptr = um_ptr->m_ptr;
-    auto *r_ptr = &monraces_info[m_ptr->r_idx];
-    if (PlayerClass(player_ptr).samurai_stance_is(SamuraiStanceType::MUSOU)) {
-        um_ptr->flag = true;
-        um_ptr->m_ptr->mflag.set(MonsterTemporaryFlagType::ESP);
-        if (um_ptr->m_ptr->is_original_ap() && !player_ptr->effects()->hallucination()->is_hallucinated()) {
-            update_smart_stupid_flags(r_ptr);
-        }
-
+    if (up.is_musou) {
+        sense_by_telepathy(um_ptr);
+        um_ptr->smart_stupid = true;
         return;
     }
 
@@ -271,126 +308,52 @@ static void update_telepathy_sight(PlayerType *player_ptr, um_type *um_ptr, MONS
         return;
     }
 
-    auto is_hallucinated = player_ptr->effects()->hallucination()->is_hallucinated();
+    const auto *r_ptr = &monraces_info[um_ptr->m_ptr->r_idx];
     if (r_ptr->flags2 & RF2_EMPTY_MIND) {
-        if (m_ptr->is_original_ap() && !is_hallucinated) {
-            r_ptr->r_flags2 |= RF2_EMPTY_MIND;
-        }
-
+        um_ptr->lore_flags2 |= RF2_EMPTY_MIND;
         return;
     }
 
-    if (update_weird_telepathy(player_ptr, um_ptr, m_idx)) {
+    if (update_weird_telepathy(um_ptr, m_idx)) {
         return;
     }
 
-    um_ptr->flag = true;
-    m_ptr->mflag.set(MonsterTemporaryFlagType::ESP);
-    if (m_ptr->is_original_ap() && !is_hallucinated) {
-        update_smart_stupid_flags(r_ptr);
-    }
+    sense_by_telepathy(um_ptr);
+    um_ptr->smart_stupid = true;
 }
 
-static void update_specific_race_telepathy(PlayerType *player_ptr, um_type *um_ptr)
+/*!
+ * @brief 種族・徳を対象とするテレパシーでモンスターを感知する
+ * @param um_ptr モンスター情報アップデート構造体への参照ポインタ
+ * @param has_esp プレイヤーがそのテレパシーを持っているか
+ * @param kind テレパシーの対象となる種族・徳
+ */
+static void update_race_telepathy(um_type *um_ptr, bool has_esp, MonsterKindType kind)
 {
-    auto *m_ptr = um_ptr->m_ptr;
-    auto *r_ptr = &monraces_info[m_ptr->r_idx];
-    auto is_hallucinated = player_ptr->effects()->hallucination()->is_hallucinated();
-    if ((player_ptr->esp_animal) && r_ptr->kind_flags.has(MonsterKindType::ANIMAL)) {
-        um_ptr->flag = true;
-        m_ptr->mflag.set(MonsterTemporaryFlagType::ESP);
-        if (m_ptr->is_original_ap() && !is_hallucinated) {
-            r_ptr->r_kind_flags.set(MonsterKindType::ANIMAL);
-        }
-    }
-
-    if ((player_ptr->esp_undead) && r_ptr->kind_flags.has(MonsterKindType::UNDEAD)) {
-        um_ptr->flag = true;
-        m_ptr->mflag.set(MonsterTemporaryFlagType::ESP);
-        if (m_ptr->is_original_ap() && !is_hallucinated) {
-            r_ptr->r_kind_flags.set(MonsterKindType::UNDEAD);
-        }
-    }
-
-    if ((player_ptr->esp_demon) && r_ptr->kind_flags.has(MonsterKindType::DEMON)) {
-        um_ptr->flag = true;
-        m_ptr->mflag.set(MonsterTemporaryFlagType::ESP);
-        if (m_ptr->is_original_ap() && !is_hallucinated) {
-            r_ptr->r_kind_flags.set(MonsterKindType::DEMON);
-        }
-    }
-
-    if ((player_ptr->esp_orc) && r_ptr->kind_flags.has(MonsterKindType::ORC)) {
-        um_ptr->flag = true;
-        m_ptr->mflag.set(MonsterTemporaryFlagType::ESP);
-        if (m_ptr->is_original_ap() && !is_hallucinated) {
-            r_ptr->r_kind_flags.set(MonsterKindType::ORC);
-        }
-    }
-
-    if ((player_ptr->esp_troll) && r_ptr->kind_flags.has(MonsterKindType::TROLL)) {
-        um_ptr->flag = true;
-        m_ptr->mflag.set(MonsterTemporaryFlagType::ESP);
-        if (m_ptr->is_original_ap() && !is_hallucinated) {
-            r_ptr->r_kind_flags.set(MonsterKindType::TROLL);
-        }
-    }
-
-    if ((player_ptr->esp_giant) && r_ptr->kind_flags.has(MonsterKindType::GIANT)) {
-        um_ptr->flag = true;
-        m_ptr->mflag.set(MonsterTemporaryFlagType::ESP);
-        if (m_ptr->is_original_ap() && !is_hallucinated) {
-            r_ptr->r_kind_flags.set(MonsterKindType::GIANT);
-        }
-    }
-
-    if ((player_ptr->esp_dragon) && r_ptr->kind_flags.has(MonsterKindType::DRAGON)) {
-        um_ptr->flag = true;
-        m_ptr->mflag.set(MonsterTemporaryFlagType::ESP);
-        if (m_ptr->is_original_ap() && !is_hallucinated) {
-            r_ptr->r_kind_flags.set(MonsterKindType::DRAGON);
-        }
-    }
-
-    if ((player_ptr->esp_human) && r_ptr->kind_flags.has(MonsterKindType::HUMAN)) {
-        um_ptr->flag = true;
-        m_ptr->mflag.set(MonsterTemporaryFlagType::ESP);
-        if (m_ptr->is_original_ap() && !is_hallucinated) {
-            r_ptr->r_kind_flags.set(MonsterKindType::HUMAN);
-        }
-    }
-
-    if ((player_ptr->esp_evil) && r_ptr->kind_flags.has(MonsterKindType::EVIL)) {
-        um_ptr->flag = true;
-        m_ptr->mflag.set(MonsterTemporaryFlagType::ESP);
-        if (m_ptr->is_original_ap() && !is_hallucinated) {
-            r_ptr->r_kind_flags.set(MonsterKindType::EVIL);
-        }
-    }
-
-    if ((player_ptr->esp_good) && r_ptr->kind_flags.has(MonsterKindType::GOOD)) {
-        um_ptr->flag = true;
-        m_ptr->mflag.set(MonsterTemporaryFlagType::ESP);
-        if (m_ptr->is_original_ap() && !is_hallucinated) {
-            r_ptr->r_kind_flags.set(MonsterKindType::GOOD);
-        }
+    if (!has_esp || monraces_info[um_ptr->m_ptr->r_idx].kind_flags.has_not(kind)) {
+        return;
     }
 
-    if ((player_ptr->esp_nonliving) && (r_ptr->kind_flags.has(MonsterKindType::NONLIVING) && r_ptr->kind_flags.has_none_of({ MonsterKindType::DEMON, MonsterKindType::UNDEAD }))) {
-        um_ptr->flag = true;
-        m_ptr->mflag.set(MonsterTemporaryFlagType::ESP);
-        if (m_ptr->is_original_ap() && !is_hallucinated) {
-            r_ptr->r_kind_flags.set(MonsterKindType::NONLIVING);
-        }
-    }
+    sense_by_telepathy(um_ptr);
+    um_ptr->lore_kinds.set(kind);
+}
 
-    if ((player_ptr->esp_unique) && r_ptr->kind_flags.has(MonsterKindType::UNIQUE)) {
-        um_ptr->flag = true;
-        m_ptr->mflag.set(MonsterTemporaryFlagType::ESP);
-        if (m_ptr->is_original_ap() && !is_hallucinated) {
-            r_ptr->r_kind_flags.set(MonsterKindType::UNIQUE);
-        }
-    }
+static void update_specific_race_telepathy(PlayerType *player_ptr, um_type *um_ptr)
+{
+    update_race_telepathy(um_ptr, player_ptr->esp_animal, MonsterKindType::ANIMAL);
+    update_race_telepathy(um_ptr, player_ptr->esp_undead, MonsterKindType::UNDEAD);
+    update_race_telepathy(um_ptr, player_ptr->esp_demon, MonsterKindType::DEMON);
+    update_race_telepathy(um_ptr, player_ptr->esp_orc, MonsterKindType::ORC);
+    update_race_telepathy(um_ptr, player_ptr->esp_troll, MonsterKindType::TROLL);
+    update_race_telepathy(um_ptr, player_ptr->esp_giant, MonsterKindType::GIANT);
+    update_race_telepathy(um_ptr, player_ptr->esp_dragon, MonsterKindType::DRAGON);
+    update_race_telepathy(um_ptr, player_ptr->esp_human, MonsterKindType::HUMAN);
+    update_race_telepathy(um_ptr, player_ptr->esp_evil, MonsterKindType::EVIL);
+    update_race_telepathy(um_ptr, player_ptr->esp_good, MonsterKindType::GOOD);
+    const auto &kind_flags = monraces_info[um_ptr->m_ptr->r_idx].kind_flags;
+    const auto is_nonliving = kind_flags.has_none_of({ MonsterKindType::DEMON, MonsterKindType::UNDEAD });
+    update_race_telepathy(um_ptr, player_ptr->esp_nonliving && is_nonliving, MonsterKindType::NONLIVING);
+    update_race_telepathy(um_ptr, player_ptr->esp_unique, MonsterKindType::UNIQUE);
 }
 
 static bool check_cold_blood(PlayerType *player_ptr, um_type *um_ptr, const POSITION distance)
@@ -432,47 +395,94 @@ static bool check_invisible(PlayerType *player_ptr, um_type *um_ptr)
 /*!
  * @brief テレパシー・赤外線視力・可視透明によってモンスターを感知できるかどうかの判定
  * @param player_ptr プレイヤーへの参照ポインタ
+ * @param up プレイヤー側の状態
  * @param um_ptr モンスター情報アップデート構造体への参照ポインタ
  */
-static void decide_sight_invisible_monster(PlayerType *player_ptr, um_type *um_ptr, MONSTER_IDX m_idx)
+static void decide_sight_invisible_monster(PlayerType *player_ptr, const um_player_type &up, um_type *um_ptr, MONSTER_IDX m_idx)
 {
     POSITION distance = decide_updated_distance(player_ptr, um_ptr);
-    auto *m_ptr = um_ptr->m_ptr;
-    auto *r_ptr = &monraces_info[m_ptr->r_idx];
-
-    m_ptr->mflag.reset(MonsterTemporaryFlagType::ESP);
-
-    if (distance > (um_ptr->in_darkness ? MAX_PLAYER_SIGHT / 2 : MAX_PLAYER_SIGHT)) {
+    if (distance > (up.in_darkness ? MAX_PLAYER_SIGHT / 2 : MAX_PLAYER_SIGHT)) {
         return;
     }
 
-    if (!um_ptr->in_darkness || (distance <= MAX_PLAYER_SIGHT / 4)) {
-        update_telepathy_sight(player_ptr, um_ptr, m_idx);
+    if (!up.in_darkness || (distance <= MAX_PLAYER_SIGHT / 4)) {
+        update_telepathy_sight(player_ptr, up, um_ptr, m_idx);
         update_specific_race_telepathy(player_ptr, um_ptr);
     }
 
-    if (!player_has_los_bold(player_ptr, um_ptr->fy, um_ptr->fx) || player_ptr->effects()->blindness()->is_blind()) {
+    if (!player_has_los_bold(player_ptr, um_ptr->fy, um_ptr->fx) || up.is_blind) {
         return;
     }
 
-    auto sniper_data = PlayerClass(player_ptr).get_specific_data<sniper_data_type>();
-    if (sniper_data && (sniper_data->concent >= CONCENT_RADAR_THRESHOLD)) {
+    if (up.has_radar) {
         um_ptr->easy = true;
         um_ptr->flag = true;
     }
 
     bool do_cold_blood = check_cold_blood(player_ptr, um_ptr, distance);
     bool do_invisible = check_invisible(player_ptr, um_ptr);
-    if (!um_ptr->flag || !m_ptr->is_original_ap() || player_ptr->effects()->hallucination()->is_hallucinated()) {
+    if (!um_ptr->flag) {
         return;
     }
 
     if (do_invisible) {
-        r_ptr->r_flags2 |= RF2_INVISIBLE;
+        um_ptr->lore_flags2 |= RF2_INVISIBLE;
     }
 
     if (do_cold_blood) {
-        r_ptr->r_flags2 |= RF2_COLD_BLOOD;
+        um_ptr->lore_flags2 |= RF2_COLD_BLOOD;
+    }
+}
+
+/*!
+ * @brief モンスターを感知できるかを判定する (判定フェーズ)
+ * @param player_ptr プレイヤーへの参照ポインタ
+ * @param up プレイヤー側の状態
+ * @param um_ptr 判定結果を格納するモンスター情報アップデート構造体への参照ポインタ
+ * @param m_idx フロアのモンスター番号
+ * @param full プレイヤーとの距離更新を行うならばtrue
+ * @details フロア・モンスター・思い出のいずれも書き換えないため、複数のモンスターを並列に判定できる
+ */
+static void decide_monster_sight(PlayerType *player_ptr, const um_player_type &up, um_type *um_ptr, MONSTER_IDX m_idx, bool full)
+{
+    initialize_um_type(player_ptr, um_ptr, m_idx, full);
+    if (disturb_high) {
+        MonsterRaceInfo *ap_r_ptr = &monraces_info[um_ptr->m_ptr->ap_r_idx];
+        if (ap_r_ptr->r_tkills && ap_r_ptr->level >= player_ptr->lev) {
+            um_ptr->do_disturb = true;
+        }
+    }
+
+    if (um_ptr->m_ptr->mflag2.has(MonsterConstantFlagType::MARK)) {
+        um_ptr->flag = true;
+    }
+
+    decide_sight_invisible_monster(player_ptr, up, um_ptr, m_idx);
+}
+
+/*!
+ * @brief 判定フェーズで決めた距離・テレパシー感知・思い出をモンスターに反映する
+ * @param up プレイヤー側の状態
+ * @param um_ptr モンスター情報アップデート構造体への参照ポインタ
+ */
+static void apply_sight_results(const um_player_type &up, um_type *um_ptr)
+{
+    auto *m_ptr = um_ptr->m_ptr;
+    m_ptr->cdis = um_ptr->distance;
+    m_ptr->mflag.reset(MonsterTemporaryFlagType::ESP);
+    if (um_ptr->esp) {
+        m_ptr->mflag.set(MonsterTemporaryFlagType::ESP);
+    }
+
+    if (!m_ptr->is_original_ap() || up.is_hallucinated) {
+        return;
+    }
+
+    auto *r_ptr = &monraces_info[m_ptr->r_idx];
+    r_ptr->r_flags2 |= um_ptr->lore_flags2;
+    r_ptr->r_kind_flags.set(um_ptr->lore_kinds);
+    if (um_ptr->smart_stupid) {
+        update_smart_stupid_flags(r_ptr);
     }
 }
 
@@ -563,26 +573,15 @@ static bool update_clear_monster(PlayerType *player_ptr, um_type *um_ptr)
 }
 
 /*!
- * @brief モンスターの各情報を更新する / This function updates the monster record of the given monster
- * @param m_idx 更新するモンスター情報のID
- * @param full プレイヤーとの距離更新を行うならばtrue
+ * @brief モンスターの感知判定の結果を反映し、見え方の変化に伴う再描画・行動中断を行う (反映フェーズ)
+ * @param player_ptr プレイヤーへの参照ポインタ
+ * @param up プレイヤー側の状態
+ * @param um_ptr 判定フェーズの結果を格納したモンスター情報アップデート構造体への参照ポインタ
+ * @param m_idx フロアのモンスター番号
  */
-void update_monster(PlayerType *player_ptr, MONSTER_IDX m_idx, bool full)
+static void apply_monster_sight(PlayerType *player_ptr, const um_player_type &up, um_type *um_ptr, MONSTER_IDX m_idx)
 {
-    um_type tmp_um;
-    um_type *um_ptr = initialize_um_type(player_ptr, &tmp_um, m_idx, full);
-    if (disturb_high) {
-        MonsterRaceInfo *ap_r_ptr = &monraces_info[um_ptr->m_ptr->ap_r_idx];
-        if (ap_r_ptr->r_tkills && ap_r_ptr->level >= player_ptr->lev) {
-            um_ptr->do_disturb = true;
-        }
-    }
-
-    if (um_ptr->m_ptr->mflag2.has(MonsterConstantFlagType::MARK)) {
-        um_ptr->flag = true;
-    }
-
-    decide_sight_invisible_monster(player_ptr, um_ptr, m_idx);
+    apply_sight_results(up, um_ptr);
     if (um_ptr->flag) {
         update_invisible_monster(player_ptr, um_ptr, m_idx);
     } else {
@@ -599,22 +598,60 @@ void update_monster(PlayerType *player_ptr, MONSTER_IDX m_idx, bool full)
     }
 }
 
+/*!
+ * @brief モンスターの各情報を更新する / This function updates the monster record of the given monster
+ * @param m_idx 更新するモンスター情報のID
+ * @param full プレイヤーとの距離更新を行うならばtrue
+ */
+void update_monster(PlayerType *player_ptr, MONSTER_IDX m_idx, bool full)
+{
+    const auto up = initialize_um_player_type(player_ptr);
+    um_type tmp_um;
+    decide_monster_sight(player_ptr, up, &tmp_um, m_idx, full);
+    apply_monster_sight(player_ptr, up, &tmp_um, m_idx);
+}
+
 /*!
  * @param player_ptr プレイヤーへの参照ポインタ
  * @brief 単純に生存している全モンスターの更新処理を行う / This function simply updates all the (non-dead) monsters (see above).
  * @param full 距離更新を行うならtrue
+ * @param mode 感知判定の進め方 (性能計測の時以外はAUTO)
+ * @details
+ * 感知の判定はフロアを読むだけなので、モンスターが多い時は常駐するスレッドプールで並列に行う.
+ * モンスターが少ない時はスレッドへの受け渡しの方が高くつくため、呼び出し元のスレッドだけで行う.
+ * 判定結果の反映 (再描画要求・行動中断・思い出の更新) は、元の順序を保つためモンスター番号順に直列で行う.
  * @todo モンスターの感知状況しか更新していないように見える。関数名変更を検討する
  */
-void update_monsters(PlayerType *player_ptr, bool full)
+void update_monsters(PlayerType *player_ptr, bool full, UpdateMonstersMode mode)
 {
     auto *floor_ptr = player_ptr->current_floor_ptr;
+    std::vector<MONSTER_IDX> m_idxs;
     for (MONSTER_IDX i = 1; i < floor_ptr->m_max; i++) {
-        auto *m_ptr = &floor_ptr->m_list[i];
-        if (!m_ptr->is_valid()) {
-            continue;
+        if (floor_ptr->m_list[i].is_valid()) {
+            m_idxs.push_back(i);
         }
+    }
+
+    const auto up = initialize_um_player_type(player_ptr);
+    const auto monster_num = static_cast<int>(m_idxs.size());
+    std::vector<um_type> ums(monster_num);
+    const auto is_parallel = (mode == UpdateMonstersMode::AUTO) ? (monster_num > UPDATE_MONSTERS_CHUNK_SIZE) : (mode == UpdateMonstersMode::PARALLEL);
+    if (!is_parallel) {
+        for (auto i = 0; i < monster_num; i++) {
+            decide_monster_sight(player_ptr, up, &ums[i], m_idxs[i], full);
+        }
+    } else {
+        const auto chunk_num = (monster_num + UPDATE_MONSTERS_CHUNK_SIZE - 1) / UPDATE_MONSTERS_CHUNK_SIZE;
+        WorkerPool::get_instance().run(chunk_num, [&](int chunk) {
+            const auto end = std::min(monster_num, (chunk + 1) * UPDATE_MONSTERS_CHUNK_SIZE);
+            for (auto i = chunk * UPDATE_MONSTERS_CHUNK_SIZE; i < end; i++) {
+                decide_monster_sight(player_ptr, up, &ums[i], m_idxs[i], full);
+            }
+        });
+    }
 
-        update_monster(player_ptr, i, full);
+    for (auto i = 0; i < monster_num; i++) {
+        apply_monster_sight(player_ptr, up, &ums[i], m_idxs[i]);
     }
 }
 
@@ -2,6 +2,15 @@
 
 #include "system/angband.h"
 
+/*!
+ * @brief update_monsters() の感知判定の進め方
+ */
+enum class UpdateMonstersMode {
+    AUTO, //!< モンスターの数で決める
+    SERIAL, //!< 呼び出し元のスレッドだけで判定する
+    PARALLEL, //!< 数に関わらずスレッドプールで判定する (性能計測用)
+};
+
 class MonsterRaceInfo;
 class MonsterEntity;
 struct old_race_flags;
@@ -13,5 +22,5 @@ void update_player_type(PlayerType *player_ptr, turn_flags *turn_flags_ptr, Mons
 void update_monster_race_flags(PlayerType *player_ptr, turn_flags *turn_flags_ptr, MonsterEntity *m_ptr);
 void update_player_window(PlayerType *player_ptr, old_race_flags *old_race_flags_ptr);
 void update_monster(PlayerType *player_ptr, MONSTER_IDX m_idx, bool full);
-void update_monsters(PlayerType *player_ptr, bool full);
+void update_monsters(PlayerType *player_ptr, bool full, UpdateMonstersMode mode = UpdateMonstersMode::AUTO);
 void update_smart_learn(PlayerType *player_ptr, MONSTER_IDX m_idx, int what);
@@ -21,7 +21,9 @@
 #include "util/bit-flags-calculator.h"
 #include "view/display-messages.h"
 #include <algorithm>
+#include <array>
 #include <iterator>
+#include <vector>
 
 enum dungeon_mode_type {
     DUNGEON_MODE_AND = 1,
@@ -230,34 +232,112 @@ monsterrace_hook_type get_monster_hook2(PlayerType *player_ptr, POSITION y, POSI
 }
 
 /*!
- * @brief モンスター生成テーブルの重みを指定条件に従って変更する。
+ * @brief get_mon_num_prep() の結果のうち、乱数を使わずに決まる部分のキャッシュ
+ * @details
+ * 地形に応じた生成制約関数とダンジョンによる制約の判定結果は、種族の静的な情報と下記の状態だけで決まる.
+ * フロア生成時にはモンスター1体毎に同じ条件で呼ばれるため、全種族へのこれらの判定を省く.
+ * クエスト中に変化する RF1_QUESTOR 等の判定は使用時に毎回行う.
+ */
+struct MonsterPrepCache {
+    bool is_valid = false;
+    monsterrace_hook_type hook1 = nullptr;
+    monsterrace_hook_type hook2 = nullptr;
+    bool restrict_to_dungeon = false;
+    DUNGEON_IDX dungeon_idx = 0;
+    DEPTH dun_level = 0;
+    QuestId quest_number = QuestId::NONE;
+    bool phase_out = false;
+    bool is_chameleon_change = false;
+    summon_type summon_specific_type = SUMMON_NONE;
+    std::vector<bool> is_allowed; //!< 基本重みが正で、生成制約関数を満たすか
+    std::vector<bool> is_restricted; //!< ダンジョンによる制約に掛かったか
+};
+
+static std::array<MonsterPrepCache, 8> mon_prep_caches;
+static size_t next_mon_prep_cache = 0;
+
+/*!
+ * @brief 生成制約関数が種族とダンジョン・階層だけで結果が決まるものかを返す
+ * @param hook 生成制約関数
+ * @return get_monster_hook() 及び get_monster_hook2() が返す関数か、nullptr ならばtrue
+ * @details 召喚や Vault 用の制約関数はグローバル変数を参照するためキャッシュしない
+ */
+static bool is_cacheable_hook(const monsterrace_hook_type hook)
+{
+    static const std::array<monsterrace_hook_type, 13> cacheable_hooks = {
+        (monsterrace_hook_type)mon_hook_dungeon,
+        (monsterrace_hook_type)mon_hook_town,
+        (monsterrace_hook_type)mon_hook_ocean,
+        (monsterrace_hook_type)mon_hook_shore,
+        (monsterrace_hook_type)mon_hook_waste,
+        (monsterrace_hook_type)mon_hook_grass,
+        (monsterrace_hook_type)mon_hook_wood,
+        (monsterrace_hook_type)mon_hook_volcano,
+        (monsterrace_hook_type)mon_hook_mountain,
+        (monsterrace_hook_type)mon_hook_deep_water,
+        (monsterrace_hook_type)mon_hook_shallow_water,
+        (monsterrace_hook_type)mon_hook_lava,
+        (monsterrace_hook_type)mon_hook_floor,
+    };
+
+    return (hook == nullptr) || std::find(cacheable_hooks.begin(), cacheable_hooks.end(), hook) != cacheable_hooks.end();
+}
+
+/*!
+ * @brief 指定条件での判定結果をキャッシュしてよいかを返す
+ * @details ダンジョンの出現制約が RF1_QUESTOR を参照する場合、判定結果がクエストの状態で変わるためキャッシュしない
+ */
+static bool can_cache_prep(PlayerType *player_ptr, const monsterrace_hook_type hook1, const monsterrace_hook_type hook2)
+{
+    return is_cacheable_hook(hook1) && is_cacheable_hook(hook2) && none_bits(dungeons_info[player_ptr->dungeon_idx].mflags1, RF1_QUESTOR);
+}
+
+/*!
+ * @brief キャッシュが指定条件で構築したものかを返す
+ */
+static bool is_same_prep_condition(PlayerType *player_ptr, const MonsterPrepCache &cache, const monsterrace_hook_type hook1, const monsterrace_hook_type hook2, const bool restrict_to_dungeon)
+{
+    const auto &floor_ref = *player_ptr->current_floor_ptr;
+    auto is_same = cache.is_valid && (cache.hook1 == hook1) && (cache.hook2 == hook2) && (cache.restrict_to_dungeon == restrict_to_dungeon);
+    is_same &= (cache.dungeon_idx == player_ptr->dungeon_idx) && (cache.dun_level == floor_ref.dun_level) && (cache.quest_number == floor_ref.quest_number);
+    is_same &= (cache.phase_out == player_ptr->phase_out) && (cache.is_chameleon_change == (chameleon_change_m_idx != 0)) && (cache.summon_specific_type == summon_specific_type);
+    return is_same;
+}
+
+/*!
+ * @brief 生成制約関数及びダンジョンによる制約を各要素に適用した結果をキャッシュに書き込む
  * @param player_ptr
+ * @param cache 結果を書き込むキャッシュ
  * @param hook1 生成制約関数1 (nullptr の場合、制約なし)
  * @param hook2 生成制約関数2 (nullptr の場合、制約なし)
  * @param restrict_to_dungeon 現在プレイヤーのいるダンジョンの制約を適用するか
- * @return 常に 0
- *
- * モンスター生成テーブル alloc_race_table の各要素の基本重み prob1 を指定条件
- * に従って変更し、結果を prob2 に書き込む。
  */
-static errr do_get_mon_num_prep(PlayerType *player_ptr, const monsterrace_hook_type hook1, const monsterrace_hook_type hook2, const bool restrict_to_dungeon)
+static void build_prep_cache(PlayerType *player_ptr, MonsterPrepCache &cache, const monsterrace_hook_type hook1, const monsterrace_hook_type hook2, const bool restrict_to_dungeon)
 {
     const FloorType *const floor_ptr = player_ptr->current_floor_ptr;
-
-    // デバッグ用統計情報。
-    int mon_num = 0; // 重み(prob2)が正の要素数
-    DEPTH lev_min = MAX_DEPTH; // 重みが正の要素のうち最小階
-    DEPTH lev_max = 0; // 重みが正の要素のうち最大階
-    int prob2_total = 0; // 重みの総和
-
-    // モンスター生成テーブルの各要素について重みを修正する。
+    cache.is_valid = true;
+    cache.hook1 = hook1;
+    cache.hook2 = hook2;
+    cache.restrict_to_dungeon = restrict_to_dungeon;
+    cache.dungeon_idx = player_ptr->dungeon_idx;
+    cache.dun_level = floor_ptr->dun_level;
+    cache.quest_number = floor_ptr->quest_number;
+    cache.phase_out = player_ptr->phase_out;
+    cache.is_chameleon_change = chameleon_change_m_idx != 0;
+    cache.summon_specific_type = summon_specific_type;
+    cache.is_allowed.assign(alloc_race_table.size(), false);
+    cache.is_restricted.assign(alloc_race_table.size(), false);
+
+    // ダンジョンによる制約を適用する条件:
+    //
+    //   * フェイズアウト状態でない
+    //   * 1階かそれより深いところにいる
+    //   * ランダムクエスト中でない
+    const bool in_random_quest = inside_quest(floor_ptr->quest_number) && !quest_type::is_fixed(floor_ptr->quest_number);
+    const bool cond = restrict_to_dungeon && !player_ptr->phase_out && floor_ptr->dun_level > 0 && !in_random_quest;
     for (auto i = 0U; i < alloc_race_table.size(); i++) {
-        alloc_entry *const entry = &alloc_race_table[i];
+        const alloc_entry *const entry = &alloc_race_table[i];
         const auto entry_r_idx = i2enum<MonsterRaceId>(entry->index);
-        const MonsterRaceInfo *const r_ptr = &monraces_info[entry_r_idx];
-
-        // 生成を禁止する要素は重み 0 とする。
-        entry->prob2 = 0;
 
         // 基本重みが 0 以下なら生成禁止。
         // テーブル内の無効エントリもこれに該当する(alloc_race_table は生成時にゼロクリアされるため)。
@@ -270,51 +350,107 @@ static errr do_get_mon_num_prep(PlayerType *player_ptr, const monsterrace_hook_t
             continue;
         }
 
-        // 原則生成禁止するものたち(フェイズアウト状態 / カメレオンの変身先 / ダンジョンの主召喚 は例外)。
-        if (!player_ptr->phase_out && !chameleon_change_m_idx && summon_specific_type != SUMMON_GUARDIANS) {
-            // クエストモンスターは生成禁止。
-            if (r_ptr->flags1 & RF1_QUESTOR) {
-                continue;
-            }
+        cache.is_allowed[i] = true;
+        cache.is_restricted[i] = cond && !restrict_monster_to_dungeon(player_ptr, entry_r_idx);
+    }
+}
 
-            // ダンジョンの主は生成禁止。
-            if (r_ptr->flags7 & RF7_GUARDIAN) {
-                continue;
-            }
+/*!
+ * @brief モンスター生成テーブルの要素1つの重みを決める
+ * @param player_ptr
+ * @param cache 生成制約関数及びダンジョンによる制約の判定結果
+ * @param i alloc_race_table の要素番号
+ * @return 重み (生成禁止なら0)
+ */
+static PROB decide_mon_num_prob(PlayerType *player_ptr, const MonsterPrepCache &cache, const size_t i)
+{
+    const FloorType *const floor_ptr = player_ptr->current_floor_ptr;
+    const alloc_entry *const entry = &alloc_race_table[i];
+    const MonsterRaceInfo *const r_ptr = &monraces_info[i2enum<MonsterRaceId>(entry->index)];
+    if (!cache.is_allowed[i]) {
+        return 0;
+    }
 
-            // RF1_FORCE_DEPTH フラグ持ちは指定階未満では生成禁止。
-            if ((r_ptr->flags1 & RF1_FORCE_DEPTH) && (r_ptr->level > floor_ptr->dun_level)) {
-                continue;
-            }
+    // 原則生成禁止するものたち(フェイズアウト状態 / カメレオンの変身先 / ダンジョンの主召喚 は例外)。
+    if (!player_ptr->phase_out && !chameleon_change_m_idx && summon_specific_type != SUMMON_GUARDIANS) {
+        // クエストモンスターは生成禁止。
+        if (r_ptr->flags1 & RF1_QUESTOR) {
+            return 0;
+        }
 
-            // クエスト内でRES_ALLの生成を禁止する (殲滅系クエストの詰み防止)
-            if (inside_quest(player_ptr->current_floor_ptr->quest_number) && r_ptr->resistance_flags.has(MonsterResistanceType::RESIST_ALL)) {
-                continue;
-            }
+        // ダンジョンの主は生成禁止。
+        if (r_ptr->flags7 & RF7_GUARDIAN) {
+            return 0;
         }
 
-        // 生成を許可するものは基本重みをそのまま引き継ぐ。
-        entry->prob2 = entry->prob1;
-
-        // 引数で指定されていればさらにダンジョンによる制約を試みる。
-        if (restrict_to_dungeon) {
-            // ダンジョンによる制約を適用する条件:
-            //
-            //   * フェイズアウト状態でない
-            //   * 1階かそれより深いところにいる
-            //   * ランダムクエスト中でない
-            const bool in_random_quest = inside_quest(floor_ptr->quest_number) && !quest_type::is_fixed(floor_ptr->quest_number);
-            const bool cond = !player_ptr->phase_out && floor_ptr->dun_level > 0 && !in_random_quest;
-
-            if (cond && !restrict_monster_to_dungeon(player_ptr, entry_r_idx)) {
-                // ダンジョンによる制約に掛かった場合、重みを special_div/64 倍する。
-                // 丸めは確率的に行う。
-                const int numer = entry->prob2 * dungeons_info[player_ptr->dungeon_idx].special_div;
-                const int q = numer / 64;
-                const int r = numer % 64;
-                entry->prob2 = (PROB)(randint0(64) < r ? q + 1 : q);
-            }
+        // RF1_FORCE_DEPTH フラグ持ちは指定階未満では生成禁止。
+        if ((r_ptr->flags1 & RF1_FORCE_DEPTH) && (r_ptr->level > floor_ptr->dun_level)) {
+            return 0;
+        }
+
+        // クエスト内でRES_ALLの生成を禁止する (殲滅系クエストの詰み防止)
+        if (inside_quest(floor_ptr->quest_number) && r_ptr->resistance_flags.has(MonsterResistanceType::RESIST_ALL)) {
+            return 0;
+        }
+    }
+
+    // 生成を許可するものは基本重みをそのまま引き継ぐ。
+    if (!cache.is_restricted[i]) {
+        return entry->prob1;
+    }
+
+    // ダンジョンによる制約に掛かった場合、重みを special_div/64 倍する。
+    // 丸めは確率的に行う。
+    const int numer = entry->prob1 * dungeons_info[player_ptr->dungeon_idx].special_div;
+    const int q = numer / 64;
+    const int r = numer % 64;
+    return (PROB)(randint0(64) < r ? q + 1 : q);
+}
+
+/*!
+ * @brief モンスター生成テーブルの重みを指定条件に従って変更する。
+ * @param player_ptr
+ * @param hook1 生成制約関数1 (nullptr の場合、制約なし)
+ * @param hook2 生成制約関数2 (nullptr の場合、制約なし)
+ * @param restrict_to_dungeon 現在プレイヤーのいるダンジョンの制約を適用するか
+ * @return 常に 0
+ *
+ * モンスター生成テーブル alloc_race_table の各要素の基本重み prob1 を指定条件
+ * に従って変更し、結果を prob2 に書き込む。
+ * 生成制約関数とダンジョンによる制約の判定結果は条件毎にキャッシュし、それ以外は毎回判定する。
+ */
+static errr do_get_mon_num_prep(PlayerType *player_ptr, const monsterrace_hook_type hook1, const monsterrace_hook_type hook2, const bool restrict_to_dungeon)
+{
+    MonsterPrepCache uncached;
+    auto *cache_ptr = &uncached;
+    if (can_cache_prep(player_ptr, hook1, hook2)) {
+        auto it = std::find_if(mon_prep_caches.begin(), mon_prep_caches.end(), [&](const auto &cache) {
+            return is_same_prep_condition(player_ptr, cache, hook1, hook2, restrict_to_dungeon);
+        });
+        if (it != mon_prep_caches.end()) {
+            cache_ptr = &*it;
+        } else {
+            cache_ptr = &mon_prep_caches[next_mon_prep_cache];
+            next_mon_prep_cache = (next_mon_prep_cache + 1) % mon_prep_caches.size();
+            build_prep_cache(player_ptr, *cache_ptr, hook1, hook2, restrict_to_dungeon);
         }
+    } else {
+        build_prep_cache(player_ptr, uncached, hook1, hook2, restrict_to_dungeon);
+    }
+
+    // デバッグ用統計情報。
+    int mon_num = 0; // 重み(prob2)が正の要素数
+    DEPTH lev_min = MAX_DEPTH; // 重みが正の要素のうち最小階
+    DEPTH lev_max = 0; // 重みが正の要素のうち最大階
+    int prob2_total = 0; // 重みの総和
+
+    // モンスター生成テーブルの各要素について重みを修正する。
+    auto is_changed = false;
+    for (auto i = 0U; i < alloc_race_table.size(); i++) {
+        alloc_entry *const entry = &alloc_race_table[i];
+        const auto prob2 = decide_mon_num_prob(player_ptr, *cache_ptr, i);
+        is_changed |= entry->prob2 != prob2;
+        entry->prob2 = prob2;
 
         // 統計情報更新。
         if (entry->prob2 > 0) {
@@ -329,6 +465,11 @@ static errr do_get_mon_num_prep(PlayerType *player_ptr, const monsterrace_hook_t
         }
     }
 
+    // 重みが変わった時だけ get_mon_num() の抽選テーブルのキャッシュを無効にする。
+    if (is_changed) {
+        alloc_race_table_generation++;
+    }
+
     // チートオプションが有効なら統計情報を出力。
     if (cheat_hear) {
         msg_format(_("モンスター第2次候補数:%d(%d-%dF)%d ", "monster second selection:%d(%d-%dF)%d "), mon_num, lev_min, lev_max, prob2_total);
@@ -118,7 +118,7 @@ bool raise_possible(PlayerType *player_ptr, MonsterEntity *m_ptr)
             }
 
             g_ptr = &floor_ptr->grid_array[yy][xx];
-            for (const auto this_o_idx : g_ptr->o_idx_list) {
+            for (const auto this_o_idx : floor_ptr->grid_array.o_idx_list(g_ptr)) {
                 const auto &item = floor_ptr->o_list[this_o_idx];
                 if (item.bi_key.tval() == ItemKindType::CORPSE) {
                     auto corpse_r_idx = i2enum<MonsterRaceId>(item.pval);
@@ -61,6 +61,7 @@
 #include "system/player-type-definition.h"
 #include "target/target-checker.h"
 #include "target/target-getter.h"
+#include "term/animation-scheduler.h"
 #include "term/screen-processor.h"
 #include "timed-effect/player-blindness.h"
 #include "timed-effect/player-hallucination.h"
@@ -223,6 +224,8 @@ void ObjectThrowEntity::exe_throw()
         this->attack_racial_power();
         break;
     }
+
+    AnimationScheduler::get_instance().finish();
 }
 
 void ObjectThrowEntity::display_figurine_throw()
@@ -399,7 +402,7 @@ bool ObjectThrowEntity::check_racial_target_bold()
 void ObjectThrowEntity::check_racial_target_seen()
 {
     if (!panel_contains(this->ny[this->cur_dis], this->nx[this->cur_dis]) || !player_can_see_bold(this->player_ptr, this->ny[this->cur_dis], this->nx[this->cur_dis])) {
-        term_xtra(TERM_XTRA_DELAY, this->msec);
+        AnimationScheduler::get_instance().present_frame(this->msec);
         return;
     }
 
@@ -411,10 +414,8 @@ void ObjectThrowEntity::check_racial_target_seen()
     const auto a = this->q_ptr->get_color();
     print_rel(this->player_ptr, c, a, this->ny[this->cur_dis], this->nx[this->cur_dis]);
     move_cursor_relative(this->ny[this->cur_dis], this->nx[this->cur_dis]);
-    term_fresh();
-    term_xtra(TERM_XTRA_DELAY, this->msec);
+    AnimationScheduler::get_instance().present_frame(this->msec);
     lite_spot(this->player_ptr, this->ny[this->cur_dis], this->nx[this->cur_dis]);
-    term_fresh();
 }
 
 bool ObjectThrowEntity::check_racial_target_monster()
@@ -519,7 +520,7 @@ void ObjectThrowEntity::process_boomerang_throw()
 
     for (auto i = this->cur_dis - 1; i > 0; i--) {
         if (!panel_contains(this->ny[i], this->nx[i]) || !player_can_see_bold(this->player_ptr, this->ny[i], this->nx[i])) {
-            term_xtra(TERM_XTRA_DELAY, this->msec);
+            AnimationScheduler::get_instance().present_frame(this->msec);
             continue;
         }
 
@@ -531,12 +532,12 @@ void ObjectThrowEntity::process_boomerang_throw()
 
         print_rel(this->player_ptr, c, a, this->ny[i], this->nx[i]);
         move_cursor_relative(this->ny[i], this->nx[i]);
-        term_fresh();
-        term_xtra(TERM_XTRA_DELAY, this->msec);
+        AnimationScheduler::get_instance().present_frame(this->msec);
         lite_spot(this->player_ptr, this->ny[i], this->nx[i]);
-        term_fresh();
     }
 
+    AnimationScheduler::get_instance().finish();
+
     this->display_boomerang_throw();
 }
 
@@ -0,0 +1,125 @@
+﻿/*!
+ * @brief 特性フラグを得ている要因の表
+ */
+
+#include "player/player-flag-cause-table.h"
+#include "core/player-update-types.h"
+#include "inventory/inventory-slot-types.h"
+#include "object/object-flags.h"
+#include "pet/pet-util.h"
+#include "player-base/player-class.h"
+#include "player-base/player-race.h"
+#include "player/player-status-flags.h"
+#include "system/item-entity.h"
+#include "system/player-type-definition.h"
+#include "timed-effect/player-blindness.h"
+#include "timed-effect/timed-effects.h"
+#include "util/bit-flags-calculator.h"
+#include "util/enum-converter.h"
+
+/*!
+ * @brief 特性フラグを得ている要因の集合を取得する
+ * @param player_ptr プレイヤーへの参照ポインタ
+ * @param tr_flag 特性フラグ
+ * @return tr_flag が得られる要因となるフラグの集合
+ * @details 表が古ければ作り直してから引く. PU_BONUS の保留中に作った表は装備品の変更途中かもしれないので使い回さない
+ */
+BIT_FLAGS PlayerFlagCauseTable::get_causes(PlayerType *player_ptr, tr_type tr_flag)
+{
+    if (!this->is_up_to_date(player_ptr)) {
+        this->rebuild(player_ptr);
+    }
+
+    return this->causes[tr_flag];
+}
+
+/*!
+ * @brief 表を無効にし、次に引いた時に作り直させる
+ * @details PU_BONUS を処理する時に呼び、それまでの装備品の変更を確実に反映させる
+ */
+void PlayerFlagCauseTable::invalidate()
+{
+    this->is_valid = false;
+}
+
+PlayerFlagCauseTable::State PlayerFlagCauseTable::State::capture(PlayerType *player_ptr)
+{
+    PlayerClass pc(player_ptr);
+    State state;
+    state.lev = player_ptr->lev;
+    state.prace = player_ptr->prace;
+    state.pclass = player_ptr->pclass;
+    state.mimic_form = player_ptr->mimic_form;
+    state.samurai_stance = pc.get_samurai_stance();
+    state.monk_stance = pc.get_monk_stance();
+    state.is_blind = player_ptr->effects()->blindness()->is_blind();
+    state.riding = player_ptr->riding;
+    state.two_hands_riding = any_bits(player_ptr->pet_extra_flags, PF_TWO_HANDS);
+    state.is_icky_wield = { player_ptr->is_icky_wield[0], player_ptr->is_icky_wield[1] };
+    return state;
+}
+
+bool PlayerFlagCauseTable::State::operator==(const State &other) const
+{
+    auto is_same = this->lev == other.lev;
+    is_same &= this->prace == other.prace;
+    is_same &= this->pclass == other.pclass;
+    is_same &= this->mimic_form == other.mimic_form;
+    is_same &= this->samurai_stance == other.samurai_stance;
+    is_same &= this->monk_stance == other.monk_stance;
+    is_same &= this->is_blind == other.is_blind;
+    is_same &= this->riding == other.riding;
+    is_same &= this->two_hands_riding == other.two_hands_riding;
+    is_same &= this->is_icky_wield == other.is_icky_wield;
+    return is_same;
+}
+
+bool PlayerFlagCauseTable::is_up_to_date(PlayerType *player_ptr) const
+{
+    if (!this->is_valid || any_bits(player_ptr->update, PU_BONUS)) {
+        return false;
+    }
+
+    return this->state == State::capture(player_ptr);
+}
+
+void PlayerFlagCauseTable::rebuild(PlayerType *player_ptr)
+{
+    this->causes.fill(0);
+    for (int i = INVEN_MAIN_HAND; i < INVEN_TOTAL; i++) {
+        auto *o_ptr = &player_ptr->inventory_list[i];
+        if (!o_ptr->bi_id) {
+            continue;
+        }
+
+        const auto flgs = object_flags(o_ptr);
+        const auto cause = convert_inventory_slot_type_to_flag_cause(i2enum<inventory_slot_type>(i));
+        for (auto tr = 0; tr < TR_FLAG_MAX; tr++) {
+            if (flgs.has(i2enum<tr_type>(tr))) {
+                set_bits(this->causes[tr], cause);
+            }
+        }
+    }
+
+    PlayerClass pc(player_ptr);
+    const auto race_flags = PlayerRace(player_ptr).tr_flags();
+    const auto class_flags = pc.tr_flags();
+    const auto stance_flags = pc.stance_tr_flags();
+    for (auto tr = 0; tr < TR_FLAG_MAX; tr++) {
+        const auto flag = i2enum<tr_type>(tr);
+        if (race_flags.has(flag)) {
+            set_bits(this->causes[tr], FLAG_CAUSE_RACE);
+        }
+
+        if (class_flags.has(flag)) {
+            set_bits(this->causes[tr], FLAG_CAUSE_CLASS);
+        }
+
+        if (stance_flags.has(flag)) {
+            set_bits(this->causes[tr], FLAG_CAUSE_STANCE);
+        }
+    }
+
+    this->is_valid = none_bits(player_ptr->update, PU_BONUS);
+    this->state = State::capture(player_ptr);
+}
@@ -0,0 +1,54 @@
+﻿#pragma once
+
+#include "object-enchant/tr-types.h"
+#include "system/h-type.h"
+#include <array>
+#include <cstdint>
+
+enum class MimicKindType;
+enum class MonkStanceType : uint8_t;
+enum class PlayerClassType : short;
+enum class PlayerRaceType;
+enum class SamuraiStanceType : uint8_t;
+class PlayerType;
+
+/*!
+ * @brief 特性フラグ毎に、それを得ている基本的な要因 (装備スロット・種族・職業・構え) の集合を覚えておく表
+ * @details
+ * 装備品が変われば PU_BONUS が立つため、PU_BONUS が保留中でない限り装備スロットの要因は使い回せる.
+ * 種族・職業・構えの要因はレベル・変身・構え・盲目・武器の扱い等でも変わるため、これらが作成時と違えば作り直す.
+ */
+class PlayerFlagCauseTable {
+public:
+    PlayerFlagCauseTable() = default;
+
+    BIT_FLAGS get_causes(PlayerType *player_ptr, tr_type tr_flag);
+    void invalidate();
+
+private:
+    /*!
+     * @brief 種族・職業・構えによる特性フラグを左右するプレイヤーの状態
+     */
+    struct State {
+        PLAYER_LEVEL lev{};
+        PlayerRaceType prace{};
+        PlayerClassType pclass{};
+        MimicKindType mimic_form{};
+        SamuraiStanceType samurai_stance{};
+        MonkStanceType monk_stance{};
+        bool is_blind{};
+        MONSTER_IDX riding{};
+        bool two_hands_riding{};
+        std::array<bool, 2> is_icky_wield{};
+
+        static State capture(PlayerType *player_ptr);
+        bool operator==(const State &other) const;
+    };
+
+    std::array<BIT_FLAGS, TR_FLAG_MAX> causes{};
+    bool is_valid = false;
+    State state{};
+
+    bool is_up_to_date(PlayerType *player_ptr) const;
+    void rebuild(PlayerType *player_ptr);
+};
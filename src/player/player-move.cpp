@@ -84,7 +84,7 @@ static void discover_hidden_things(PlayerType *player_ptr, POSITION y, POSITION
         disturb(player_ptr, false, false);
     }
 
-    for (const auto this_o_idx : g_ptr->o_idx_list) {
+    for (const auto this_o_idx : floor_ptr->grid_array.o_idx_list(g_ptr)) {
         ItemEntity *o_ptr;
         o_ptr = &floor_ptr->o_list[this_o_idx];
         if (o_ptr->bi_key.tval() != ItemKindType::CHEST) {
@@ -156,6 +156,7 @@ bool move_player_effect(PlayerType *player_ptr, POSITION ny, POSITION nx, BIT_FL
                 MonsterEntity *om_ptr = &floor_ptr->m_list[om_idx];
                 om_ptr->fy = ny;
                 om_ptr->fx = nx;
+                floor_ptr->m_spatial_index.place(om_idx, ny, nx);
                 update_monster(player_ptr, om_idx, true);
             }
 
@@ -163,6 +164,7 @@ bool move_player_effect(PlayerType *player_ptr, POSITION ny, POSITION nx, BIT_FL
                 MonsterEntity *nm_ptr = &floor_ptr->m_list[nm_idx];
                 nm_ptr->fy = oy;
                 nm_ptr->fx = ox;
+                floor_ptr->m_spatial_index.place(nm_idx, oy, ox);
                 update_monster(player_ptr, nm_idx, true);
             }
         }
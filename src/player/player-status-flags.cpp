@@ -61,21 +61,7 @@ namespace {
  */
 BIT_FLAGS common_cause_flags(PlayerType *player_ptr, tr_type tr_flag)
 {
-    BIT_FLAGS result = check_equipment_flags(player_ptr, tr_flag);
-
-    if (PlayerRace(player_ptr).tr_flags().has(tr_flag)) {
-        set_bits(result, FLAG_CAUSE_RACE);
-    }
-
-    if (PlayerClass(player_ptr).tr_flags().has(tr_flag)) {
-        set_bits(result, FLAG_CAUSE_CLASS);
-    }
-
-    if (PlayerClass(player_ptr).stance_tr_flags().has(tr_flag)) {
-        set_bits(result, FLAG_CAUSE_STANCE);
-    }
-
-    return result;
+    return player_ptr->flag_cause_table.get_causes(player_ptr, tr_flag);
 }
 
 }
@@ -118,24 +104,12 @@ BIT_FLAGS convert_inventory_slot_type_to_flag_cause(inventory_slot_type inventor
 
 /*!
  * @brief 装備による所定の特性フラグを得ているかを一括して取得する関数。
+ * @details 装備品を毎回調べずに、特性フラグの要因の表から装備スロットの要因だけを取り出す
  */
 BIT_FLAGS check_equipment_flags(PlayerType *player_ptr, tr_type tr_flag)
 {
-    ItemEntity *o_ptr;
-    BIT_FLAGS result = 0L;
-    for (int i = INVEN_MAIN_HAND; i < INVEN_TOTAL; i++) {
-        o_ptr = &player_ptr->inventory_list[i];
-        if (!o_ptr->bi_id) {
-            continue;
-        }
-
-        auto flgs = object_flags(o_ptr);
-
-        if (flgs.has(tr_flag)) {
-            set_bits(result, convert_inventory_slot_type_to_flag_cause(i2enum<inventory_slot_type>(i)));
-        }
-    }
-    return result;
+    constexpr BIT_FLAGS equipment_causes = (FLAG_CAUSE_INVEN_FEET << 1) - 1;
+    return player_ptr->flag_cause_table.get_causes(player_ptr, tr_flag) & equipment_causes;
 }
 
 BIT_FLAGS player_flags_brand_pois(PlayerType *player_ptr)
@@ -739,7 +713,7 @@ void check_no_flowed(PlayerType *player_ptr)
         }
     }
 
-    for (const auto this_o_idx : player_ptr->current_floor_ptr->grid_array[player_ptr->y][player_ptr->x].o_idx_list) {
+    for (const auto this_o_idx : player_ptr->current_floor_ptr->grid_array.o_idx_list(player_ptr->y, player_ptr->x)) {
         o_ptr = &player_ptr->current_floor_ptr->o_list[this_o_idx];
 
         if (o_ptr->bi_key == BaseitemKey(ItemKindType::NATURE_BOOK, 2)) {
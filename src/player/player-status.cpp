@@ -2692,6 +2692,7 @@ void update_creature(PlayerType *player_ptr)
 
     if (any_bits(player_ptr->update, (PU_BONUS))) {
         reset_bits(player_ptr->update, PU_BONUS);
+        player_ptr->flag_cause_table.invalidate();
         PlayerAlignment(player_ptr).update_alignment();
         PlayerSkill ps(player_ptr);
         ps.apply_special_weapon_skill_max_values();
@@ -2787,7 +2788,7 @@ bool player_has_no_spellbooks(PlayerType *player_ptr)
     }
 
     auto *floor_ptr = player_ptr->current_floor_ptr;
-    for (const auto this_o_idx : floor_ptr->grid_array[player_ptr->y][player_ptr->x].o_idx_list) {
+    for (const auto this_o_idx : floor_ptr->grid_array.o_idx_list(player_ptr->y, player_ptr->x)) {
         o_ptr = &floor_ptr->o_list[this_o_idx];
         if (o_ptr->bi_id && o_ptr->marked.has(OmType::FOUND) && check_book_realm(player_ptr, o_ptr->bi_key)) {
             return false;
@@ -1,14 +1,36 @@
 ﻿#include "player/player-view.h"
 #include "core/player-update-types.h"
+#include "core/profiler.h"
 #include "floor/cave.h"
+#include "floor/grid-bitmap.h"
 #include "floor/line-of-sight.h"
 #include "game-option/map-screen-options.h"
 #include "grid/grid.h"
 #include "system/floor-type-definition.h"
 #include "system/grid-type-definition.h"
 #include "system/player-type-definition.h"
-#include "util/point-2d.h"
-#include <vector>
+
+namespace {
+GridBitmap view_bitmap; /*!< プレイヤーから見えている座標 (CAVE_VIEWと同じ内容) */
+GridBitmap prev_view_bitmap; /*!< 前回プレイヤーから見えていた座標 */
+GridBitmap easy_view_bitmap; /*!< 「容易に」見える座標 */
+}
+
+/*!
+ * @brief 座標を視界に加える
+ * @param floor_ptr フロアへの参照ポインタ
+ * @param y 座標Y
+ * @param x 座標X
+ * @param is_easy 「容易に」見える座標ならtrue
+ */
+static void set_view(FloorType *floor_ptr, POSITION y, POSITION x, bool is_easy)
+{
+    cave_view_hack(floor_ptr, y, x);
+    view_bitmap.set(y, x);
+    if (is_easy) {
+        easy_view_bitmap.set(y, x);
+    }
+}
 
 /*
  * Helper function for "update_view()" below
@@ -20,8 +42,8 @@
  * Grid (y1,x1) is on the "diagonal" between (player_ptr->y,player_ptr->x) and (y,x)
  * Grid (y2,x2) is "adjacent", also between (player_ptr->y,player_ptr->x) and (y,x).
  *
- * Note that we are using the "CAVE_XTRA" field for marking grids as
- * "easily viewable".  This bit is cleared at the end of "update_view()".
+ * Note that we are using "easy_view_bitmap" for marking grids as
+ * "easily viewable".  It is cleared at the beginning of "update_view()".
  *
  * This function adds (y,x) to the "viewable set" if necessary.
  *
@@ -30,50 +52,30 @@
 static bool update_view_aux(PlayerType *player_ptr, POSITION y, POSITION x, POSITION y1, POSITION x1, POSITION y2, POSITION x2)
 {
     auto *floor_ptr = player_ptr->current_floor_ptr;
-    grid_type *g1_c_ptr;
-    grid_type *g2_c_ptr;
-    g1_c_ptr = &floor_ptr->grid_array[y1][x1];
-    g2_c_ptr = &floor_ptr->grid_array[y2][x2];
-    bool f1 = (feat_supports_los(g1_c_ptr->feat));
-    bool f2 = (feat_supports_los(g2_c_ptr->feat));
-    if (!f1 && !f2) {
+    bool v1 = view_bitmap.test(y1, x1);
+    bool v2 = view_bitmap.test(y2, x2);
+    if (!v1 && !v2) {
         return true;
     }
 
-    bool v1 = (f1 && (g1_c_ptr->info & CAVE_VIEW));
-    bool v2 = (f2 && (g2_c_ptr->info & CAVE_VIEW));
+    bool f1 = (feat_supports_los(floor_ptr->grid_array[y1][x1].feat));
+    bool f2 = (feat_supports_los(floor_ptr->grid_array[y2][x2].feat));
+    v1 = (f1 && v1);
+    v2 = (f2 && v2);
     if (!v1 && !v2) {
         return true;
     }
 
-    grid_type *g_ptr;
-    g_ptr = &floor_ptr->grid_array[y][x];
-    bool wall = (!feat_supports_los(g_ptr->feat));
-    bool z1 = (v1 && (g1_c_ptr->info & CAVE_XTRA));
-    bool z2 = (v2 && (g2_c_ptr->info & CAVE_XTRA));
-    if (z1 && z2) {
-        g_ptr->info |= CAVE_XTRA;
-        cave_view_hack(floor_ptr, y, x);
-        return wall;
-    }
-
-    if (z1) {
-        cave_view_hack(floor_ptr, y, x);
-        return wall;
-    }
-
-    if (v1 && v2) {
-        cave_view_hack(floor_ptr, y, x);
-        return wall;
-    }
-
-    if (wall) {
-        cave_view_hack(floor_ptr, y, x);
+    bool wall = (!feat_supports_los(floor_ptr->grid_array[y][x].feat));
+    bool z1 = (v1 && easy_view_bitmap.test(y1, x1));
+    bool z2 = (v2 && easy_view_bitmap.test(y2, x2));
+    if (z1 || (v1 && v2) || wall) {
+        set_view(floor_ptr, y, x, z1 && z2);
         return wall;
     }
 
     if (los(player_ptr, player_ptr->y, player_ptr->x, y, x)) {
-        cave_view_hack(floor_ptr, y, x);
+        set_view(floor_ptr, y, x, false);
         return wall;
     }
 
@@ -97,12 +99,11 @@ static bool update_view_aux(PlayerType *player_ptr, POSITION y, POSITION x, POSI
  *  4c: Process both "sides" of each "direction" of each strip
  *  4c1: Each side aborts as soon as possible
  *  4c2: Each side tells the next strip how far it has to check
+ *  5: Compare the new view with the old one word by word and redraw the changed grids
  */
 void update_view(PlayerType *player_ptr)
 {
-    // 前回プレイヤーから見えていた座標たちを格納する配列。
-    std::vector<Pos2D> points;
-
+    ProfileScope profile_scope(ProfileSection::UPDATE_VIEW);
     int n, m, d, k, z;
     POSITION y, x;
 
@@ -114,7 +115,6 @@ void update_view(PlayerType *player_ptr)
     POSITION y_max = floor_ptr->height - 1;
     POSITION x_max = floor_ptr->width - 1;
 
-    grid_type *g_ptr;
     if (view_reduce_view && !floor_ptr->dun_level) {
         full = MAX_PLAYER_SIGHT / 2;
         over = MAX_PLAYER_SIGHT * 3 / 4;
@@ -123,95 +123,77 @@ void update_view(PlayerType *player_ptr)
         over = MAX_PLAYER_SIGHT * 3 / 2;
     }
 
+    prev_view_bitmap.clear();
     for (n = 0; n < floor_ptr->view_n; n++) {
         y = floor_ptr->view_y[n];
         x = floor_ptr->view_x[n];
-        g_ptr = &floor_ptr->grid_array[y][x];
-        g_ptr->info &= ~(CAVE_VIEW);
-        g_ptr->info |= CAVE_TEMP;
-
-        points.emplace_back(y, x);
+        floor_ptr->grid_array[y][x].info &= ~(CAVE_VIEW);
+        prev_view_bitmap.set(y, x);
     }
 
     floor_ptr->view_n = 0;
+    view_bitmap.clear();
+    easy_view_bitmap.clear();
     y = player_ptr->y;
     x = player_ptr->x;
-    g_ptr = &floor_ptr->grid_array[y][x];
-    g_ptr->info |= CAVE_XTRA;
-    cave_view_hack(floor_ptr, y, x);
+    set_view(floor_ptr, y, x, true);
 
     z = full * 2 / 3;
     for (d = 1; d <= z; d++) {
-        g_ptr = &floor_ptr->grid_array[y + d][x + d];
-        g_ptr->info |= CAVE_XTRA;
-        cave_view_hack(floor_ptr, y + d, x + d);
-        if (!feat_supports_los(g_ptr->feat)) {
+        set_view(floor_ptr, y + d, x + d, true);
+        if (!feat_supports_los(floor_ptr->grid_array[y + d][x + d].feat)) {
             break;
         }
     }
 
     for (d = 1; d <= z; d++) {
-        g_ptr = &floor_ptr->grid_array[y + d][x - d];
-        g_ptr->info |= CAVE_XTRA;
-        cave_view_hack(floor_ptr, y + d, x - d);
-        if (!feat_supports_los(g_ptr->feat)) {
+        set_view(floor_ptr, y + d, x - d, true);
+        if (!feat_supports_los(floor_ptr->grid_array[y + d][x - d].feat)) {
             break;
         }
     }
 
     for (d = 1; d <= z; d++) {
-        g_ptr = &floor_ptr->grid_array[y - d][x + d];
-        g_ptr->info |= CAVE_XTRA;
-        cave_view_hack(floor_ptr, y - d, x + d);
-        if (!feat_supports_los(g_ptr->feat)) {
+        set_view(floor_ptr, y - d, x + d, true);
+        if (!feat_supports_los(floor_ptr->grid_array[y - d][x + d].feat)) {
             break;
         }
     }
 
     for (d = 1; d <= z; d++) {
-        g_ptr = &floor_ptr->grid_array[y - d][x - d];
-        g_ptr->info |= CAVE_XTRA;
-        cave_view_hack(floor_ptr, y - d, x - d);
-        if (!feat_supports_los(g_ptr->feat)) {
+        set_view(floor_ptr, y - d, x - d, true);
+        if (!feat_supports_los(floor_ptr->grid_array[y - d][x - d].feat)) {
             break;
         }
     }
 
     for (d = 1; d <= full; d++) {
-        g_ptr = &floor_ptr->grid_array[y + d][x];
-        g_ptr->info |= CAVE_XTRA;
-        cave_view_hack(floor_ptr, y + d, x);
-        if (!feat_supports_los(g_ptr->feat)) {
+        set_view(floor_ptr, y + d, x, true);
+        if (!feat_supports_los(floor_ptr->grid_array[y + d][x].feat)) {
             break;
         }
     }
 
     se = sw = d;
     for (d = 1; d <= full; d++) {
-        g_ptr = &floor_ptr->grid_array[y - d][x];
-        g_ptr->info |= CAVE_XTRA;
-        cave_view_hack(floor_ptr, y - d, x);
-        if (!feat_supports_los(g_ptr->feat)) {
+        set_view(floor_ptr, y - d, x, true);
+        if (!feat_supports_los(floor_ptr->grid_array[y - d][x].feat)) {
             break;
         }
     }
 
     ne = nw = d;
     for (d = 1; d <= full; d++) {
-        g_ptr = &floor_ptr->grid_array[y][x + d];
-        g_ptr->info |= CAVE_XTRA;
-        cave_view_hack(floor_ptr, y, x + d);
-        if (!feat_supports_los(g_ptr->feat)) {
+        set_view(floor_ptr, y, x + d, true);
+        if (!feat_supports_los(floor_ptr->grid_array[y][x + d].feat)) {
             break;
         }
     }
 
     es = en = d;
     for (d = 1; d <= full; d++) {
-        g_ptr = &floor_ptr->grid_array[y][x - d];
-        g_ptr->info |= CAVE_XTRA;
-        cave_view_hack(floor_ptr, y, x - d);
-        if (!feat_supports_los(g_ptr->feat)) {
+        set_view(floor_ptr, y, x - d, true);
+        if (!feat_supports_los(floor_ptr->grid_array[y][x - d].feat)) {
             break;
         }
     }
@@ -357,27 +339,10 @@ void update_view(PlayerType *player_ptr)
         }
     }
 
-    for (n = 0; n < floor_ptr->view_n; n++) {
-        y = floor_ptr->view_y[n];
-        x = floor_ptr->view_x[n];
-        g_ptr = &floor_ptr->grid_array[y][x];
-        g_ptr->info &= ~(CAVE_XTRA);
-        if (g_ptr->info & CAVE_TEMP) {
-            continue;
-        }
-
-        cave_note_and_redraw_later(floor_ptr, y, x);
-    }
-
-    for (const auto &[py, px] : points) {
-        g_ptr = &floor_ptr->grid_array[py][px];
-        g_ptr->info &= ~(CAVE_TEMP);
-        if (g_ptr->info & CAVE_VIEW) {
-            continue;
-        }
-
-        cave_redraw_later(floor_ptr, py, px);
-    }
+    GridBitmap::for_each_difference(
+        prev_view_bitmap, view_bitmap, 0, y_max,
+        [floor_ptr](POSITION py, POSITION px) { cave_note_and_redraw_later(floor_ptr, py, px); },
+        [floor_ptr](POSITION py, POSITION px) { cave_redraw_later(floor_ptr, py, px); });
 
     player_ptr->update |= PU_DELAY_VIS;
 }
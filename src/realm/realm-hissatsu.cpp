@@ -422,6 +422,7 @@ concptr do_hissatsu_spell(PlayerType *player_ptr, SPELL_IDX spell, SpellProcessT
                     player_ptr->current_floor_ptr->grid_array[ty][tx].m_idx = m_idx;
                     m_ptr->fy = ty;
                     m_ptr->fx = tx;
+                    player_ptr->current_floor_ptr->m_spatial_index.place(m_idx, ty, tx);
 
                     update_monster(player_ptr, m_idx, true);
                     lite_spot(player_ptr, oy, ox);
@@ -852,6 +853,7 @@ concptr do_hissatsu_spell(PlayerType *player_ptr, SPELL_IDX spell, SpellProcessT
                 player_ptr->current_floor_ptr->grid_array[ny][nx].m_idx = m_idx;
                 m_ptr->fy = ny;
                 m_ptr->fx = nx;
+                player_ptr->current_floor_ptr->m_spatial_index.place(m_idx, ny, nx);
 
                 update_monster(player_ptr, m_idx, true);
 
@@ -113,72 +113,30 @@ static concptr pit_subtype_string(int type, bool nest)
     return inner_buf;
 }
 
-/*
- *! @brief nestのモンスターリストをソートするための関数 /
- *  Comp function for sorting nest monster information
- *  @param u ソート処理対象配列ポインタ
- *  @param v 未使用
- *  @param a 比較対象参照ID1
- *  @param b 比較対象参照ID2
- *  TODO: to sort.c
+/*!
+ * @brief nestのモンスターリストをソートするための関数 /
+ * Comp function for sorting nest monster information
+ * @param info1 比較対象1
+ * @param info2 比較対象2
+ * @return 比較対象1が先に来るべきならTRUE
  */
-static bool ang_sort_comp_nest_mon_info(PlayerType *player_ptr, vptr u, vptr v, int a, int b)
+static bool ang_sort_comp_nest_mon_info(const nest_mon_info_type &info1, const nest_mon_info_type &info2)
 {
-    /* Unused */
-    (void)player_ptr;
-    (void)v;
-
-    nest_mon_info_type *nest_mon_info = (nest_mon_info_type *)u;
-    auto w1 = nest_mon_info[a].r_idx;
-    auto w2 = nest_mon_info[b].r_idx;
-    MonsterRaceInfo *r1_ptr = &monraces_info[w1];
-    MonsterRaceInfo *r2_ptr = &monraces_info[w2];
-    int z1 = nest_mon_info[a].used;
-    int z2 = nest_mon_info[b].used;
-
-    if (z1 < z2) {
-        return false;
-    }
-    if (z1 > z2) {
-        return true;
+    const auto &r1_ref = monraces_info[info1.r_idx];
+    const auto &r2_ref = monraces_info[info2.r_idx];
+    if (info1.used != info2.used) {
+        return info1.used;
     }
 
-    if (r1_ptr->level < r2_ptr->level) {
-        return true;
-    }
-    if (r1_ptr->level > r2_ptr->level) {
-        return false;
+    if (r1_ref.level != r2_ref.level) {
+        return r1_ref.level < r2_ref.level;
     }
 
-    if (r1_ptr->mexp < r2_ptr->mexp) {
-        return true;
+    if (r1_ref.mexp != r2_ref.mexp) {
+        return r1_ref.mexp < r2_ref.mexp;
     }
-    if (r1_ptr->mexp > r2_ptr->mexp) {
-        return false;
-    }
-
-    return w1 <= w2;
-}
-
-/*!
- * @brief nestのモンスターリストをスワップするための関数 /
- * Swap function for sorting nest monster information
- * @param u スワップ処理対象配列ポインタ
- * @param v 未使用
- * @param a スワップ対象参照ID1
- * @param b スワップ対象参照ID2
- * TODO: to sort.c
- */
-static void ang_sort_swap_nest_mon_info(PlayerType *player_ptr, vptr u, vptr v, int a, int b)
-{
-    /* Unused */
-    (void)player_ptr;
-    (void)v;
 
-    nest_mon_info_type *nest_mon_info = (nest_mon_info_type *)u;
-    nest_mon_info_type holder = nest_mon_info[a];
-    nest_mon_info[a] = nest_mon_info[b];
-    nest_mon_info[b] = holder;
+    return info1.r_idx < info2.r_idx;
 }
 
 /*!
@@ -392,7 +350,7 @@ bool build_type5(PlayerType *player_ptr, dun_data_type *dd_ptr)
     }
 
     if (cheat_room) {
-        ang_sort(player_ptr, nest_mon_info, nullptr, NUM_NEST_MON_TYPE, ang_sort_comp_nest_mon_info, ang_sort_swap_nest_mon_info);
+        ang_sort(nest_mon_info, ang_sort_comp_nest_mon_info);
 
         /* Dump the entries (prevent multi-printing) */
         for (i = 0; i < NUM_NEST_MON_TYPE; i++) {
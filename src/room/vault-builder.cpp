@@ -94,7 +94,7 @@ void vault_objects(PlayerType *player_ptr, POSITION y, POSITION x, int num)
 
             grid_type *g_ptr;
             g_ptr = &floor_ptr->grid_array[j][k];
-            if (!g_ptr->is_floor() || !g_ptr->o_idx_list.empty()) {
+            if (!g_ptr->is_floor() || !floor_ptr->grid_array.o_idx_list(g_ptr).empty()) {
                 continue;
             }
 
@@ -140,7 +140,7 @@ static void vault_trap_aux(PlayerType *player_ptr, POSITION y, POSITION x, POSIT
         }
 
         g_ptr = &floor_ptr->grid_array[y1][x1];
-        if (!g_ptr->is_floor() || !g_ptr->o_idx_list.empty() || g_ptr->m_idx) {
+        if (!g_ptr->is_floor() || !floor_ptr->grid_array.o_idx_list(g_ptr).empty() || g_ptr->m_idx) {
             continue;
         }
 
@@ -8,7 +8,9 @@
 #include "io/files-util.h"
 #include "io/uid-checker.h"
 #include "load/floor-loader.h"
+#include "load/load-util.h"
 #include "monster-floor/monster-lite.h"
+#include "monster-race/monster-race.h"
 #include "monster/monster-compaction.h"
 #include "save/item-writer.h"
 #include "save/monster-writer.h"
@@ -16,8 +18,99 @@
 #include "system/floor-type-definition.h"
 #include "system/grid-type-definition.h"
 #include "system/item-entity.h"
+#include "system/monster-entity.h"
+#include "system/monster-race-info.h"
+#include "system/player-type-definition.h"
 #include "util/angband-files.h"
-#include "util/sort.h"
+#include "world/world.h"
+#include <algorithm>
+#include <array>
+#include <memory>
+#include <numeric>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+/*!
+ * @brief 保存フロアの地形テンプレートを識別するキー
+ */
+struct GridTemplateKey {
+    BIT_FLAGS info;
+    FEAT_IDX feat;
+    FEAT_IDX mimic;
+    int16_t special;
+
+    bool operator==(const GridTemplateKey &other) const
+    {
+        return (this->info == other.info) && (this->feat == other.feat) && (this->mimic == other.mimic) && (this->special == other.special);
+    }
+};
+
+struct GridTemplateKeyHash {
+    size_t operator()(const GridTemplateKey &key) const
+    {
+        auto hash = static_cast<uint64_t>(key.info);
+        hash = hash * 0x100000001b3ULL ^ static_cast<uint16_t>(key.feat);
+        hash = hash * 0x100000001b3ULL ^ static_cast<uint16_t>(key.mimic);
+        hash = hash * 0x100000001b3ULL ^ static_cast<uint16_t>(key.special);
+        return static_cast<size_t>(hash);
+    }
+};
+
+/*!
+ * @brief 読み戻したフロアが保存元のフロアと一致するかを調べる
+ * @param floor 保存元のフロア
+ * @param loaded 読み戻したフロア
+ * @return 地形・マス情報・アイテム・モンスターが全て一致すればtrue
+ */
+bool is_same_saved_floor(const FloorType &floor, const FloorType &loaded)
+{
+    if ((floor.height != loaded.height) || (floor.width != loaded.width) || (floor.base_level != loaded.base_level) || (floor.num_repro != loaded.num_repro)) {
+        return false;
+    }
+
+    if ((floor.o_max != loaded.o_max) || (floor.m_max != loaded.m_max)) {
+        return false;
+    }
+
+    for (POSITION y = 0; y < floor.height; y++) {
+        for (POSITION x = 0; x < floor.width; x++) {
+            const auto &grid = floor.grid_array[y][x];
+            const auto &loaded_grid = loaded.grid_array[y][x];
+            auto is_same = (grid.info == loaded_grid.info) && (grid.feat == loaded_grid.feat) && (grid.mimic == loaded_grid.mimic);
+            is_same &= (grid.special == loaded_grid.special) && (grid.m_idx == loaded_grid.m_idx);
+            const auto &o_idx_list = floor.grid_array.o_idx_list(y, x);
+            const auto &loaded_o_idx_list = loaded.grid_array.o_idx_list(y, x);
+            is_same &= std::equal(o_idx_list.begin(), o_idx_list.end(), loaded_o_idx_list.begin(), loaded_o_idx_list.end());
+            if (!is_same) {
+                return false;
+            }
+        }
+    }
+
+    for (OBJECT_IDX i = 1; i < floor.o_max; i++) {
+        const auto &item = floor.o_list[i];
+        const auto &loaded_item = loaded.o_list[i];
+        auto is_same = (item.bi_id == loaded_item.bi_id) && (item.iy == loaded_item.iy) && (item.ix == loaded_item.ix);
+        is_same &= (item.number == loaded_item.number) && (item.held_m_idx == loaded_item.held_m_idx);
+        if (!is_same) {
+            return false;
+        }
+    }
+
+    for (MONSTER_IDX i = 1; i < floor.m_max; i++) {
+        const auto &monster = floor.m_list[i];
+        const auto &loaded_monster = loaded.m_list[i];
+        auto is_same = (monster.r_idx == loaded_monster.r_idx) && (monster.fy == loaded_monster.fy) && (monster.fx == loaded_monster.fx);
+        is_same &= (monster.hp == loaded_monster.hp) && (monster.maxhp == loaded_monster.maxhp);
+        if (!is_same) {
+            return false;
+        }
+    }
+
+    return true;
+}
+}
 
 /*!
  * @brief 保存フロアの書き込み / Actually write a saved floor data using effectively compressed format.
@@ -58,31 +151,36 @@ void wr_saved_floor(PlayerType *player_ptr, saved_floor_type *sf_ptr)
      */
 
     std::vector<grid_template_type> templates;
+    std::unordered_map<GridTemplateKey, uint16_t, GridTemplateKeyHash> template_indices;
+    std::vector<uint16_t> grid_templates;
+    grid_templates.reserve(floor_ptr->height * floor_ptr->width);
     for (int y = 0; y < floor_ptr->height; y++) {
         for (int x = 0; x < floor_ptr->width; x++) {
-            auto *g_ptr = &floor_ptr->grid_array[y][x];
-            uint i;
-            for (i = 0; i < templates.size(); i++) {
-                if (templates[i].info == g_ptr->info && templates[i].feat == g_ptr->feat && templates[i].mimic == g_ptr->mimic && templates[i].special == g_ptr->special) {
-                    templates[i].occurrence++;
-                    break;
-                }
+            const auto *g_ptr = &floor_ptr->grid_array[y][x];
+            const GridTemplateKey key{ g_ptr->info, g_ptr->feat, g_ptr->mimic, g_ptr->special };
+            const auto [it, is_new] = template_indices.emplace(key, static_cast<uint16_t>(templates.size()));
+            if (is_new) {
+                templates.push_back({ g_ptr->info, g_ptr->feat, g_ptr->mimic, g_ptr->special, 0 });
             }
 
-            if (i < templates.size()) {
-                continue;
-            }
-
-            templates.push_back({ g_ptr->info, g_ptr->feat, g_ptr->mimic, g_ptr->special, 1 });
+            templates[it->second].occurrence++;
+            grid_templates.push_back(it->second);
         }
     }
 
-    int dummy_why;
-    ang_sort(player_ptr, templates.data(), &dummy_why, templates.size(), ang_sort_comp_cave_temp, ang_sort_swap_cave_temp);
+    /* 出現頻度の高いテンプレートほど小さなIDを割り当てる */
+    std::vector<uint16_t> order(templates.size());
+    std::iota(order.begin(), order.end(), static_cast<uint16_t>(0));
+    std::stable_sort(order.begin(), order.end(), [&templates](auto a, auto b) { return templates[a].occurrence > templates[b].occurrence; });
+    std::vector<uint16_t> template_ids(templates.size());
+    for (size_t i = 0; i < order.size(); i++) {
+        template_ids[order[i]] = static_cast<uint16_t>(i);
+    }
 
     /*** Dump templates ***/
     wr_u16b(static_cast<uint16_t>(templates.size()));
-    for (const auto &ct_ref : templates) {
+    for (const auto i : order) {
+        const auto &ct_ref = templates[i];
         wr_u16b(static_cast<uint16_t>(ct_ref.info));
         wr_s16b(ct_ref.feat);
         wr_s16b(ct_ref.mimic);
@@ -91,32 +189,22 @@ void wr_saved_floor(PlayerType *player_ptr, saved_floor_type *sf_ptr)
 
     byte count = 0;
     uint16_t prev_u16b = 0;
-    for (int y = 0; y < floor_ptr->height; y++) {
-        for (int x = 0; x < floor_ptr->width; x++) {
-            auto *g_ptr = &floor_ptr->grid_array[y][x];
-            uint i;
-            for (i = 0; i < templates.size(); i++) {
-                if (templates[i].info == g_ptr->info && templates[i].feat == g_ptr->feat && templates[i].mimic == g_ptr->mimic && templates[i].special == g_ptr->special) {
-                    break;
-                }
-            }
-
-            uint16_t tmp16u = (uint16_t)i;
-            if ((tmp16u == prev_u16b) && (count != MAX_UCHAR)) {
-                count++;
-                continue;
-            }
-
-            wr_byte((byte)count);
-            while (prev_u16b >= MAX_UCHAR) {
-                wr_byte(MAX_UCHAR);
-                prev_u16b -= MAX_UCHAR;
-            }
+    for (const auto grid_template : grid_templates) {
+        const auto tmp16u = template_ids[grid_template];
+        if ((tmp16u == prev_u16b) && (count != MAX_UCHAR)) {
+            count++;
+            continue;
+        }
 
-            wr_byte((byte)prev_u16b);
-            prev_u16b = tmp16u;
-            count = 1;
+        wr_byte((byte)count);
+        while (prev_u16b >= MAX_UCHAR) {
+            wr_byte(MAX_UCHAR);
+            prev_u16b -= MAX_UCHAR;
         }
+
+        wr_byte((byte)prev_u16b);
+        prev_u16b = tmp16u;
+        count = 1;
     }
 
     if (count > 0) {
@@ -224,7 +312,7 @@ static bool save_floor_aux(PlayerType *player_ptr, saved_floor_type *sf_ptr)
     wr_u32b(v_stamp);
     wr_u32b(x_stamp);
 
-    return !ferror(saving_savefile) && (fflush(saving_savefile) != EOF);
+    return flush_saving_savefile() && !ferror(saving_savefile) && (fflush(saving_savefile) != EOF);
 }
 /*!
  * @brief ゲームプレイ中のフロア一時保存出力処理メインルーチン / Attempt to save the temporarily saved-floor data
@@ -241,6 +329,7 @@ bool save_floor(PlayerType *player_ptr, saved_floor_type *sf_ptr, BIT_FLAGS mode
 
     char floor_savefile[sizeof(savefile) + 32];
     if ((mode & SLF_SECOND) != 0) {
+        (void)flush_saving_savefile();
         old_fff = saving_savefile;
         old_xor_byte = save_xor_byte;
         old_v_stamp = v_stamp;
@@ -267,6 +356,7 @@ bool save_floor(PlayerType *player_ptr, saved_floor_type *sf_ptr, BIT_FLAGS mode
                 is_save_successful = true;
             }
 
+            (void)flush_saving_savefile();
             if (angband_fclose(saving_savefile)) {
                 is_save_successful = false;
             }
@@ -288,3 +378,69 @@ bool save_floor(PlayerType *player_ptr, saved_floor_type *sf_ptr, BIT_FLAGS mode
 
     return is_save_successful;
 }
+
+/*!
+ * @brief 現在のフロアを予備の保存枠へ書き出して読み戻し、元のフロアと一致するかを検査する
+ * @param player_ptr プレイヤーへの参照ポインタ
+ * @return 一致すればtrue (書き出し・読み戻しに失敗した場合はfalse)
+ * @details
+ * wr_saved_floor() の地形テンプレートの索引や連長圧縮の誤りは、rd_saved_floor() で読んだ時に初めて表に出るため、
+ * 実際に保存ファイルを作って読み戻し、地形・マス情報・アイテム・モンスターを比べる.
+ * 保存枠は saved_floors[] の外 (番号 MAX_SAVED_FLOORS) を使い、読み戻したファイルは消す.
+ * 読み戻しは作業用のフロアに行い、現在のフロア・プレイヤーの位置・モンスター種族の生存数・読み込み中のバージョン・乱数の状態は元のまま残す.
+ * 保存の際にアイテムとモンスターの圧縮が走るため、フロアを離れる時 (保存済か破棄される時) に呼ぶこと.
+ */
+bool verify_floor_round_trip(PlayerType *player_ptr)
+{
+    auto *floor_ptr = player_ptr->current_floor_ptr;
+    saved_floor_type sf{};
+    sf.floor_id = player_ptr->floor_id;
+    sf.savefile_id = MAX_SAVED_FLOORS;
+    sf.dun_level = floor_ptr->dun_level;
+    sf.last_visit = w_ptr->game_turn;
+
+    const auto rng_state = w_ptr->rng.get_state();
+    const auto is_saved = save_floor(player_ptr, &sf, 0);
+    w_ptr->rng.set_state(rng_state);
+    if (!is_saved) {
+        return false;
+    }
+
+    auto loaded_floor = std::make_unique<FloorType>();
+    loaded_floor->o_list.assign(w_ptr->max_o_idx, {});
+    loaded_floor->m_list.assign(w_ptr->max_m_idx, {});
+    loaded_floor->grid_array.resize(MAX_HGT, MAX_WID);
+    loaded_floor->dun_level = floor_ptr->dun_level;
+    loaded_floor->quest_number = floor_ptr->quest_number;
+
+    std::vector<MONSTER_NUMBER> cur_nums;
+    cur_nums.reserve(monraces_info.size());
+    for (const auto &[r_idx, r_ref] : monraces_info) {
+        cur_nums.push_back(r_ref.cur_num);
+    }
+
+    const auto y = player_ptr->y;
+    const auto x = player_ptr->x;
+    const auto feeling = player_ptr->feeling;
+    const std::array<byte, 4> h_ver = { { w_ptr->h_ver_major, w_ptr->h_ver_minor, w_ptr->h_ver_patch, w_ptr->h_ver_extra } };
+    const auto savefile_version = loading_savefile_version;
+    player_ptr->current_floor_ptr = loaded_floor.get();
+    const auto is_loaded = load_floor(player_ptr, &sf, 0);
+    const auto is_same_position = (player_ptr->y == y) && (player_ptr->x == x) && (player_ptr->feeling == feeling);
+    player_ptr->current_floor_ptr = floor_ptr;
+    player_ptr->y = y;
+    player_ptr->x = x;
+    player_ptr->feeling = feeling;
+    w_ptr->h_ver_major = h_ver[0];
+    w_ptr->h_ver_minor = h_ver[1];
+    w_ptr->h_ver_patch = h_ver[2];
+    w_ptr->h_ver_extra = h_ver[3];
+    loading_savefile_version = savefile_version;
+
+    auto cur_num = cur_nums.begin();
+    for (auto &[r_idx, r_ref] : monraces_info) {
+        r_ref.cur_num = *cur_num++;
+    }
+
+    return is_loaded && is_same_position && is_same_saved_floor(*floor_ptr, *loaded_floor);
+}
@@ -11,3 +11,4 @@ struct saved_floor_type;
 void wr_saved_floor(PlayerType *player_ptr, saved_floor_type *sf_ptr);
 bool wr_dungeon(PlayerType *player_ptr);
 bool save_floor(PlayerType *player_ptr, saved_floor_type *sf_ptr, BIT_FLAGS mode);
+bool verify_floor_round_trip(PlayerType *player_ptr);
@@ -1,4 +1,7 @@
 ﻿#include "save/save-util.h"
+#include <algorithm>
+#include <array>
+#include <numeric>
 
 FILE *saving_savefile; /* Current save "file" */
 byte save_xor_byte; /* Simple encryption */
@@ -6,18 +9,64 @@ uint32_t v_stamp = 0L; /* A simple "checksum" on the actual values */
 uint32_t x_stamp = 0L; /* A simple "checksum" on the encoded bytes */
 
 /*!
- * @brief 1バイトをファイルに書き込む / These functions place information into a savefile a byte at a time
- * @param v 書き込むバイト値
+ * @brief 書き込みバッファの大きさ
  */
-static void sf_put(byte v)
+constexpr auto SAVE_BUFFER_SIZE = 65536U;
+
+static std::array<byte, SAVE_BUFFER_SIZE> save_buffer; /* Encoded bytes not yet written to the file */
+static size_t save_buffer_len = 0;
+
+/*!
+ * @brief 符号化済みのバッファをファイルへ書き出す
+ * @return 書き込みに成功すればtrue
+ * @details ファイルを閉じる前や、入れ子の保存でファイルを切り替える前に必ず呼ぶこと.
+ */
+bool flush_saving_savefile()
+{
+    if (save_buffer_len == 0) {
+        return true;
+    }
+
+    const auto written = fwrite(save_buffer.data(), 1, save_buffer_len, saving_savefile);
+    const auto is_successful = written == save_buffer_len;
+    save_buffer_len = 0;
+    return is_successful;
+}
+
+/*!
+ * @brief 複数バイトをまとめて符号化しバッファへ書き込む / These functions place information into a savefile a block at a time
+ * @param values 書き込むバイト列
+ * @param size 書き込むバイト数
+ * @details 1バイトずつ書き込んだ場合と同じ XOR 連鎖とチェックサムを維持する.
+ */
+static void sf_put(const byte *values, size_t size)
 {
-    /* Encode the value, write a character */
-    save_xor_byte ^= v;
-    (void)putc((int)save_xor_byte, saving_savefile);
+    while (size > 0) {
+        if (save_buffer_len == SAVE_BUFFER_SIZE) {
+            (void)flush_saving_savefile();
+        }
+
+        const auto length = std::min(size, SAVE_BUFFER_SIZE - save_buffer_len);
+        auto *encoded = &save_buffer[save_buffer_len];
 
-    /* Maintain the checksum info */
-    v_stamp += v;
-    x_stamp += save_xor_byte;
+        /* Maintain the checksum info */
+        v_stamp = std::accumulate(values, values + length, v_stamp);
+
+        /* Encode the values */
+        auto xor_byte = save_xor_byte;
+        auto encoded_sum = x_stamp;
+        for (size_t i = 0; i < length; i++) {
+            xor_byte ^= values[i];
+            encoded[i] = xor_byte;
+            encoded_sum += xor_byte;
+        }
+
+        save_xor_byte = xor_byte;
+        x_stamp = encoded_sum;
+        save_buffer_len += length;
+        values += length;
+        size -= length;
+    }
 }
 
 /*!
@@ -35,7 +84,7 @@ void wr_bool(bool v)
  */
 void wr_byte(byte v)
 {
-    sf_put(v);
+    sf_put(&v, 1);
 }
 
 /*!
@@ -44,8 +93,8 @@ void wr_byte(byte v)
  */
 void wr_u16b(uint16_t v)
 {
-    wr_byte((byte)(v & 0xFF));
-    wr_byte((byte)((v >> 8) & 0xFF));
+    const byte values[] = { (byte)(v & 0xFF), (byte)((v >> 8) & 0xFF) };
+    sf_put(values, sizeof(values));
 }
 
 /*!
@@ -63,10 +112,8 @@ void wr_s16b(int16_t v)
  */
 void wr_u32b(uint32_t v)
 {
-    wr_byte((byte)(v & 0xFF));
-    wr_byte((byte)((v >> 8) & 0xFF));
-    wr_byte((byte)((v >> 16) & 0xFF));
-    wr_byte((byte)((v >> 24) & 0xFF));
+    const byte values[] = { (byte)(v & 0xFF), (byte)((v >> 8) & 0xFF), (byte)((v >> 16) & 0xFF), (byte)((v >> 24) & 0xFF) };
+    sf_put(values, sizeof(values));
 }
 
 /*!
@@ -84,8 +131,6 @@ void wr_s32b(int32_t v)
  */
 void wr_string(std::string_view sv)
 {
-    for (auto c : sv) {
-        wr_byte(c);
-    }
+    sf_put(reinterpret_cast<const byte *>(sv.data()), sv.size());
     wr_byte('\0');
 }
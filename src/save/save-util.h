@@ -8,6 +8,7 @@ extern byte save_xor_byte;
 extern uint32_t v_stamp;
 extern uint32_t x_stamp;
 
+bool flush_saving_savefile();
 void wr_bool(bool v);
 void wr_byte(byte v);
 void wr_u16b(uint16_t v);
@@ -244,7 +244,7 @@ static bool wr_savefile_new(PlayerType *player_ptr, SaveType type)
 
     wr_u32b(v_stamp);
     wr_u32b(x_stamp);
-    return !ferror(saving_savefile) && (fflush(saving_savefile) != EOF);
+    return flush_saving_savefile() && !ferror(saving_savefile) && (fflush(saving_savefile) != EOF);
 }
 
 /*!
@@ -274,6 +274,7 @@ static bool save_player_aux(PlayerType *player_ptr, char *name, SaveType type)
                 is_save_successful = true;
             }
 
+            (void)flush_saving_savefile();
             if (angband_fclose(saving_savefile)) {
                 is_save_successful = false;
             }
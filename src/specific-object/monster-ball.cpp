@@ -7,6 +7,7 @@
 #include "monster-floor/place-monster-types.h"
 #include "monster-race/monster-race.h"
 #include "monster/monster-info.h"
+#include "monster/monster-processor.h"
 #include "monster/monster-util.h"
 #include "object-activation/activation-util.h"
 #include "object/tval-types.h"
@@ -164,7 +165,9 @@ static void check_monster_ball_use(PlayerType *player_ptr, ae_type *ae_ptr)
 
     auto *floor_ptr = player_ptr->current_floor_ptr;
     if (ae_ptr->o_ptr->captured_monster_speed > 0) {
+        settle_monster_energy(player_ptr, hack_m_idx_ii);
         floor_ptr->m_list[hack_m_idx_ii].mspeed = ae_ptr->o_ptr->captured_monster_speed;
+        reschedule_monster(player_ptr, hack_m_idx_ii);
     }
 
     if (ae_ptr->o_ptr->captured_monster_max_hp) {
@@ -36,6 +36,7 @@
 #include "target/grid-selector.h"
 #include "target/projection-path-calculator.h"
 #include "target/target-checker.h"
+#include "term/animation-scheduler.h"
 #include "timed-effect/player-blindness.h"
 #include "timed-effect/player-hallucination.h"
 #include "timed-effect/timed-effects.h"
@@ -312,16 +313,14 @@ void SpellsMirrorMaster::project_seeker_ray(int target_x, int target_y, int dam)
                 if (panel_contains(ny, nx) && player_has_los_bold(this->player_ptr, ny, nx)) {
                     print_bolt_pict(this->player_ptr, oy, ox, ny, nx, typ);
                     move_cursor_relative(ny, nx);
-                    term_fresh();
-                    term_xtra(TERM_XTRA_DELAY, delay_factor);
+                    AnimationScheduler::get_instance().present_frame(delay_factor);
                     lite_spot(this->player_ptr, ny, nx);
-                    term_fresh();
 
                     print_bolt_pict(this->player_ptr, ny, nx, ny, nx, typ);
 
                     visual = true;
                 } else if (visual) {
-                    term_xtra(TERM_XTRA_DELAY, delay_factor);
+                    AnimationScheduler::get_instance().present_frame(delay_factor);
                 }
             }
 
@@ -330,6 +329,10 @@ void SpellsMirrorMaster::project_seeker_ray(int target_x, int target_y, int dam)
             }
         }
 
+        if (visual) {
+            AnimationScheduler::get_instance().finish();
+        }
+
         for (const auto &[py, px] : path_g) {
             if (affect_monster(this->player_ptr, 0, 0, py, px, dam, typ, flag, true)) {
                 res.notice = true;
@@ -396,8 +399,7 @@ static void draw_super_ray_pict(PlayerType *player_ptr, const std::map<int, std:
                 }
             }
         }
-        term_fresh();
-        term_xtra(TERM_XTRA_DELAY, delay_factor);
+        AnimationScheduler::get_instance().present_frame(delay_factor);
 
         for (const auto &[y, x] : drawn_last_pos_list) {
             if (panel_contains(y, x) && player_has_los_bold(player_ptr, y, x)) {
@@ -407,8 +409,8 @@ static void draw_super_ray_pict(PlayerType *player_ptr, const std::map<int, std:
         }
     }
 
-    term_fresh();
-    term_xtra(TERM_XTRA_DELAY, delay_factor);
+    AnimationScheduler::get_instance().present_frame(delay_factor);
+    AnimationScheduler::get_instance().finish();
 
     for (const auto &[y, x] : drawn_pos_list) {
         lite_spot(player_ptr, y, x);
@@ -488,17 +490,15 @@ void SpellsMirrorMaster::project_super_ray(int target_x, int target_y, int dam)
             if (panel_contains(ny, nx) && player_has_los_bold(this->player_ptr, ny, nx)) {
                 print_bolt_pict(this->player_ptr, oy, ox, ny, nx, typ);
                 move_cursor_relative(ny, nx);
-                term_fresh();
-                term_xtra(TERM_XTRA_DELAY, delay_factor);
+                AnimationScheduler::get_instance().present_frame(delay_factor);
                 lite_spot(this->player_ptr, ny, nx);
-                term_fresh();
 
                 print_bolt_pict(this->player_ptr, ny, nx, ny, nx, typ);
 
                 drawn_pos_list.emplace_back(ny, nx);
                 visual = true;
             } else if (visual) {
-                term_xtra(TERM_XTRA_DELAY, delay_factor);
+                AnimationScheduler::get_instance().present_frame(delay_factor);
             }
         }
 
@@ -509,6 +509,10 @@ void SpellsMirrorMaster::project_super_ray(int target_x, int target_y, int dam)
         ox = nx;
     }
 
+    if (visual) {
+        AnimationScheduler::get_instance().finish();
+    }
+
     for (const auto &[y, x] : drawn_pos_list) {
         lite_spot(player_ptr, y, x);
     }
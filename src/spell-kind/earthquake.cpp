@@ -300,6 +300,7 @@ bool earthquake(PlayerType *player_ptr, POSITION cy, POSITION cx, POSITION r, MO
             floor_ptr->grid_array[sy][sx].m_idx = m_idx_aux;
             m_ptr->fy = sy;
             m_ptr->fx = sx;
+            floor_ptr->m_spatial_index.place(m_idx_aux, sy, sx);
             update_monster(player_ptr, m_idx_aux, true);
             lite_spot(player_ptr, yy, xx);
             lite_spot(player_ptr, sy, sx);
@@ -28,6 +28,7 @@
 #include "system/terrain-type-definition.h"
 #include "util/string-processor.h"
 #include "view/display-messages.h"
+#include <vector>
 
 /*!
  * @brief プレイヤー周辺の地形を感知する
@@ -332,6 +333,19 @@ bool detect_objects_magic(PlayerType *player_ptr, POSITION range)
     return detect;
 }
 
+/*!
+ * @brief プレイヤーから一定距離内のモンスターを集める
+ * @param player_ptr プレイヤーへの参照ポインタ
+ * @param range 効果範囲
+ * @return モンスターIDの配列 (昇順)
+ */
+static std::vector<MONSTER_IDX> collect_monsters_in_range(PlayerType *player_ptr, POSITION range)
+{
+    std::vector<MONSTER_IDX> m_idxs;
+    player_ptr->current_floor_ptr->m_spatial_index.collect_in_radius(player_ptr->y, player_ptr->x, range, m_idxs);
+    return m_idxs;
+}
+
 /*!
  * @brief 一般のモンスターを感知する / Detect all "normal" monsters on the current panel
  * @param player_ptr プレイヤーへの参照ポインタ
@@ -345,19 +359,13 @@ bool detect_monsters_normal(PlayerType *player_ptr, POSITION range)
     }
 
     bool flag = false;
-    for (MONSTER_IDX i = 1; i < player_ptr->current_floor_ptr->m_max; i++) {
+    for (const auto i : collect_monsters_in_range(player_ptr, range)) {
         auto *m_ptr = &player_ptr->current_floor_ptr->m_list[i];
         auto *r_ptr = &monraces_info[m_ptr->r_idx];
         if (!m_ptr->is_valid()) {
             continue;
         }
 
-        POSITION y = m_ptr->fy;
-        POSITION x = m_ptr->fx;
-        if (distance(player_ptr->y, player_ptr->x, y, x) > range) {
-            continue;
-        }
-
         if (!(r_ptr->flags2 & RF2_INVISIBLE) || player_ptr->see_inv) {
             m_ptr->mflag2.set({ MonsterConstantFlagType::MARK, MonsterConstantFlagType::SHOW });
             update_monster(player_ptr, i, false);
@@ -388,7 +396,7 @@ bool detect_monsters_invis(PlayerType *player_ptr, POSITION range)
     }
 
     bool flag = false;
-    for (MONSTER_IDX i = 1; i < player_ptr->current_floor_ptr->m_max; i++) {
+    for (const auto i : collect_monsters_in_range(player_ptr, range)) {
         auto *m_ptr = &player_ptr->current_floor_ptr->m_list[i];
         auto *r_ptr = &monraces_info[m_ptr->r_idx];
 
@@ -396,13 +404,6 @@ bool detect_monsters_invis(PlayerType *player_ptr, POSITION range)
             continue;
         }
 
-        POSITION y = m_ptr->fy;
-        POSITION x = m_ptr->fx;
-
-        if (distance(player_ptr->y, player_ptr->x, y, x) > range) {
-            continue;
-        }
-
         if (r_ptr->flags2 & RF2_INVISIBLE) {
             if (player_ptr->monster_race_idx == m_ptr->r_idx) {
                 player_ptr->window_flags |= (PW_MONSTER);
@@ -437,20 +438,13 @@ bool detect_monsters_evil(PlayerType *player_ptr, POSITION range)
     }
 
     bool flag = false;
-    for (MONSTER_IDX i = 1; i < player_ptr->current_floor_ptr->m_max; i++) {
+    for (const auto i : collect_monsters_in_range(player_ptr, range)) {
         auto *m_ptr = &player_ptr->current_floor_ptr->m_list[i];
         auto *r_ptr = &monraces_info[m_ptr->r_idx];
         if (!m_ptr->is_valid()) {
             continue;
         }
 
-        POSITION y = m_ptr->fy;
-        POSITION x = m_ptr->fx;
-
-        if (distance(player_ptr->y, player_ptr->x, y, x) > range) {
-            continue;
-        }
-
         if (r_ptr->kind_flags.has(MonsterKindType::EVIL)) {
             if (m_ptr->is_original_ap()) {
                 r_ptr->r_kind_flags.set(MonsterKindType::EVIL);
@@ -485,18 +479,12 @@ bool detect_monsters_nonliving(PlayerType *player_ptr, POSITION range)
     }
 
     bool flag = false;
-    for (MONSTER_IDX i = 1; i < player_ptr->current_floor_ptr->m_max; i++) {
+    for (const auto i : collect_monsters_in_range(player_ptr, range)) {
         auto *m_ptr = &player_ptr->current_floor_ptr->m_list[i];
         if (!m_ptr->is_valid()) {
             continue;
         }
 
-        POSITION y = m_ptr->fy;
-        POSITION x = m_ptr->fx;
-        if (distance(player_ptr->y, player_ptr->x, y, x) > range) {
-            continue;
-        }
-
         if (!monster_living(m_ptr->r_idx)) {
             if (player_ptr->monster_race_idx == m_ptr->r_idx) {
                 player_ptr->window_flags |= (PW_MONSTER);
@@ -528,20 +516,13 @@ bool detect_monsters_mind(PlayerType *player_ptr, POSITION range)
     }
 
     bool flag = false;
-    for (MONSTER_IDX i = 1; i < player_ptr->current_floor_ptr->m_max; i++) {
+    for (const auto i : collect_monsters_in_range(player_ptr, range)) {
         auto *m_ptr = &player_ptr->current_floor_ptr->m_list[i];
         auto *r_ptr = &monraces_info[m_ptr->r_idx];
         if (!m_ptr->is_valid()) {
             continue;
         }
 
-        POSITION y = m_ptr->fy;
-        POSITION x = m_ptr->fx;
-
-        if (distance(player_ptr->y, player_ptr->x, y, x) > range) {
-            continue;
-        }
-
         if (!(r_ptr->flags2 & RF2_EMPTY_MIND)) {
             if (player_ptr->monster_race_idx == m_ptr->r_idx) {
                 player_ptr->window_flags |= (PW_MONSTER);
@@ -574,20 +555,13 @@ bool detect_monsters_string(PlayerType *player_ptr, POSITION range, concptr Matc
     }
 
     bool flag = false;
-    for (MONSTER_IDX i = 1; i < player_ptr->current_floor_ptr->m_max; i++) {
+    for (const auto i : collect_monsters_in_range(player_ptr, range)) {
         auto *m_ptr = &player_ptr->current_floor_ptr->m_list[i];
         auto *r_ptr = &monraces_info[m_ptr->r_idx];
         if (!m_ptr->is_valid()) {
             continue;
         }
 
-        POSITION y = m_ptr->fy;
-        POSITION x = m_ptr->fx;
-
-        if (distance(player_ptr->y, player_ptr->x, y, x) > range) {
-            continue;
-        }
-
         if (angband_strchr(Match, r_ptr->d_char)) {
             if (player_ptr->monster_race_idx == m_ptr->r_idx) {
                 player_ptr->window_flags |= (PW_MONSTER);
@@ -39,11 +39,12 @@
  */
 void fetch_item(PlayerType *player_ptr, DIRECTION dir, WEIGHT wgt, bool require_los)
 {
+    auto *floor_ptr = player_ptr->current_floor_ptr;
     grid_type *g_ptr;
     ItemEntity *o_ptr;
     GAME_TEXT o_name[MAX_NLEN];
 
-    if (!player_ptr->current_floor_ptr->grid_array[player_ptr->y][player_ptr->x].o_idx_list.empty()) {
+    if (!floor_ptr->grid_array.o_idx_list(player_ptr->y, player_ptr->x).empty()) {
         msg_print(_("自分の足の下にある物は取れません。", "You can't fetch when you're already standing on something."));
         return;
     }
@@ -59,7 +60,7 @@ void fetch_item(PlayerType *player_ptr, DIRECTION dir, WEIGHT wgt, bool require_
         }
 
         g_ptr = &player_ptr->current_floor_ptr->grid_array[ty][tx];
-        if (g_ptr->o_idx_list.empty()) {
+        if (floor_ptr->grid_array.o_idx_list(g_ptr).empty()) {
             msg_print(_("そこには何もありません。", "There is no object there."));
             return;
         }
@@ -83,7 +84,7 @@ void fetch_item(PlayerType *player_ptr, DIRECTION dir, WEIGHT wgt, bool require_
         tx = player_ptr->x;
         bool is_first_loop = true;
         g_ptr = &player_ptr->current_floor_ptr->grid_array[ty][tx];
-        while (is_first_loop || g_ptr->o_idx_list.empty()) {
+        while (is_first_loop || floor_ptr->grid_array.o_idx_list(g_ptr).empty()) {
             is_first_loop = false;
             ty += ddy[dir];
             tx += ddx[dir];
@@ -95,15 +96,15 @@ void fetch_item(PlayerType *player_ptr, DIRECTION dir, WEIGHT wgt, bool require_
         }
     }
 
-    o_ptr = &player_ptr->current_floor_ptr->o_list[g_ptr->o_idx_list.front()];
+    o_ptr = &floor_ptr->o_list[floor_ptr->grid_array.o_idx_list(g_ptr).front()];
     if (o_ptr->weight > wgt) {
         msg_print(_("そのアイテムは重過ぎます。", "The object is too heavy."));
         return;
     }
 
-    OBJECT_IDX i = g_ptr->o_idx_list.front();
-    g_ptr->o_idx_list.pop_front();
-    player_ptr->current_floor_ptr->grid_array[player_ptr->y][player_ptr->x].o_idx_list.add(player_ptr->current_floor_ptr, i); /* 'move' it */
+    OBJECT_IDX i = floor_ptr->grid_array.o_idx_list(g_ptr).front();
+    floor_ptr->grid_array.o_idx_list(g_ptr).pop_front();
+    floor_ptr->grid_array.o_idx_list(player_ptr->y, player_ptr->x).add(floor_ptr, i); /* 'move' it */
 
     o_ptr->iy = player_ptr->y;
     o_ptr->ix = player_ptr->x;
@@ -158,6 +159,7 @@ bool fetch_monster(PlayerType *player_ptr)
     player_ptr->current_floor_ptr->grid_array[ty][tx].m_idx = m_idx;
     m_ptr->fy = ty;
     m_ptr->fx = tx;
+    player_ptr->current_floor_ptr->m_spatial_index.place(m_idx, ty, tx);
     (void)set_monster_csleep(player_ptr, m_idx, 0);
     update_monster(player_ptr, m_idx, true);
     lite_spot(player_ptr, target_row, target_col);
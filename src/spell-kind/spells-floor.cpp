@@ -342,7 +342,7 @@ bool destroy_area(PlayerType *player_ptr, POSITION y1, POSITION x1, POSITION r,
             /* During generation, destroyed artifacts are "preserved" */
             if (preserve_mode || in_generate) {
                 /* Scan all objects in the grid */
-                for (const auto this_o_idx : g_ptr->o_idx_list) {
+                for (const auto this_o_idx : floor_ptr->grid_array.o_idx_list(g_ptr)) {
                     ItemEntity *o_ptr;
                     o_ptr = &floor_ptr->o_list[this_o_idx];
 
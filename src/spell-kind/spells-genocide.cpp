@@ -30,6 +30,7 @@
 #include "system/player-type-definition.h"
 #include "util/bit-flags-calculator.h"
 #include "view/display-messages.h"
+#include <vector>
 
 /*!
  * @brief モンスターへの単体抹殺処理サブルーチン / Delete a non-unique/non-quest monster
@@ -174,7 +175,9 @@ bool mass_genocide(PlayerType *player_ptr, int power, bool player_cast)
     }
 
     bool result = false;
-    for (MONSTER_IDX i = 1; i < player_ptr->current_floor_ptr->m_max; i++) {
+    std::vector<MONSTER_IDX> m_idxs;
+    floor_ptr->m_spatial_index.collect_in_radius(player_ptr->y, player_ptr->x, MAX_PLAYER_SIGHT, m_idxs);
+    for (const auto i : m_idxs) {
         auto *m_ptr = &player_ptr->current_floor_ptr->m_list[i];
         if (!m_ptr->is_valid()) {
             continue;
@@ -211,7 +214,9 @@ bool mass_genocide_undead(PlayerType *player_ptr, int power, bool player_cast)
     }
 
     bool result = false;
-    for (MONSTER_IDX i = 1; i < player_ptr->current_floor_ptr->m_max; i++) {
+    std::vector<MONSTER_IDX> m_idxs;
+    floor_ptr->m_spatial_index.collect_in_radius(player_ptr->y, player_ptr->x, MAX_PLAYER_SIGHT, m_idxs);
+    for (const auto i : m_idxs) {
         auto *m_ptr = &player_ptr->current_floor_ptr->m_list[i];
         auto *r_ptr = &monraces_info[m_ptr->r_idx];
         if (!m_ptr->is_valid()) {
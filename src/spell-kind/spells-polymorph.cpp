@@ -110,6 +110,7 @@ bool polymorph_monster(PlayerType *player_ptr, POSITION y, POSITION x)
     if (place_monster_aux(player_ptr, 0, y, x, new_r_idx, mode)) {
         floor_ptr->m_list[hack_m_idx_ii].nickname = back_m.nickname;
         floor_ptr->m_list[hack_m_idx_ii].parent_m_idx = back_m.parent_m_idx;
+        floor_ptr->m_list[hack_m_idx_ii].parent_generation = back_m.parent_generation;
         floor_ptr->m_list[hack_m_idx_ii].hold_o_idx_list = back_m.hold_o_idx_list;
         polymorphed = true;
     } else {
@@ -189,6 +189,7 @@ bool teleport_away(PlayerType *player_ptr, MONSTER_IDX m_idx, POSITION dis, tele
 
     m_ptr->fy = ny;
     m_ptr->fx = nx;
+    player_ptr->current_floor_ptr->m_spatial_index.place(m_idx, ny, nx);
 
     reset_target(m_ptr);
     update_monster(player_ptr, m_idx, true);
@@ -271,6 +272,7 @@ void teleport_monster_to(PlayerType *player_ptr, MONSTER_IDX m_idx, POSITION ty,
 
     m_ptr->fy = ny;
     m_ptr->fx = nx;
+    player_ptr->current_floor_ptr->m_spatial_index.place(m_idx, ny, nx);
 
     update_monster(player_ptr, m_idx, true);
     lite_spot(player_ptr, oy, ox);
@@ -3,5 +3,8 @@
 /* The entries in the "race allocator table" */
 std::vector<alloc_entry> alloc_race_table;
 
+/* Incremented whenever "prob2" of the race allocator table is rewritten */
+uint32_t alloc_race_table_generation = 0;
+
 /* The entries in the "kind allocator table" */
 std::vector<alloc_entry> alloc_kind_table;
@@ -26,5 +26,6 @@ struct alloc_entry {
 };
 
 extern std::vector<alloc_entry> alloc_race_table;
+extern uint32_t alloc_race_table_generation;
 
 extern std::vector<alloc_entry> alloc_kind_table;
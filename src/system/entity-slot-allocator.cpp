@@ -0,0 +1,64 @@
+﻿#include "system/entity-slot-allocator.h"
+
+/*!
+ * @brief 要素番号を解放し、空きリストへ積む
+ * @param idx 解放する要素番号
+ * @details 世代番号を進め、解放前に作られたハンドルを無効にする
+ */
+void EntitySlotAllocator::release(int16_t idx)
+{
+    if (idx <= 0) {
+        return;
+    }
+
+    if (static_cast<std::size_t>(idx) >= this->generations.size()) {
+        this->generations.resize(idx + 1, 0);
+    }
+
+    this->generations[idx]++;
+    this->free_slots.push_back(idx);
+}
+
+/*!
+ * @brief 要素番号の現在の世代番号を返す
+ * @param idx 要素番号
+ * @return 世代番号
+ */
+uint32_t EntitySlotAllocator::get_generation(int16_t idx) const
+{
+    if ((idx <= 0) || (static_cast<std::size_t>(idx) >= this->generations.size())) {
+        return 0;
+    }
+
+    return this->generations[idx];
+}
+
+/*!
+ * @brief ハンドルの指す要素が、ハンドルを作ってから解放されていないかを返す
+ * @param idx 要素番号
+ * @param generation ハンドルを作った時の世代番号
+ * @return 解放されていなければtrue
+ */
+bool EntitySlotAllocator::is_current(int16_t idx, uint32_t generation) const
+{
+    return this->get_generation(idx) == generation;
+}
+
+/*!
+ * @brief 空きリストを空にする
+ * @details 配列を詰め直した後のように、要素番号の空き状況がまとめて変わった時に呼ぶ. 世代番号は保つ
+ */
+void EntitySlotAllocator::clear_free_slots()
+{
+    this->free_slots.clear();
+}
+
+/*!
+ * @brief 空きリストと世代番号を全て初期化する
+ * @details フロアの全要素を消去した時に呼ぶ. 以前のハンドルを持つ要素も残っていないので世代番号は0からやり直す
+ */
+void EntitySlotAllocator::reset()
+{
+    this->free_slots.clear();
+    this->generations.clear();
+}
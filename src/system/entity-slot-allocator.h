@@ -0,0 +1,47 @@
+﻿#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/*!
+ * @brief フロアのモンスター・アイテム配列の空き要素と世代番号を管理する
+ * @details
+ * 削除された要素番号を空きリストへ積んでおき、次の確保で取り出すことで確保・解放を定数時間で行う.
+ * 要素番号毎に世代番号を持ち、解放の度に進める. 要素番号と確保時の世代番号の組 (ハンドル) を覚えておけば、
+ * 後からその要素が解放・再利用されていないかを判定できる.
+ * 空きリストには既に使われた要素番号が残っていることがあるため、取り出す側で空きであることを確かめる.
+ */
+class EntitySlotAllocator {
+public:
+    EntitySlotAllocator() = default;
+
+    /*!
+     * @brief 空きリストから空いている要素番号を取り出す
+     * @param is_vacant 要素番号が空きかを判定する関数
+     * @return 空いている要素番号、空きリストが尽きたら0
+     */
+    template <typename F>
+    int16_t acquire(F &&is_vacant)
+    {
+        while (!this->free_slots.empty()) {
+            const auto idx = this->free_slots.back();
+            this->free_slots.pop_back();
+            if (is_vacant(idx)) {
+                return idx;
+            }
+        }
+
+        return 0;
+    }
+
+    void release(int16_t idx);
+    uint32_t get_generation(int16_t idx) const;
+    bool is_current(int16_t idx, uint32_t generation) const;
+    void clear_free_slots();
+    void reset();
+
+private:
+    std::vector<int16_t> free_slots; //!< 解放された要素番号 (後に解放したものから再利用する)
+    std::vector<uint32_t> generations; //!< 要素番号毎の世代番号 (未解放の要素は0)
+};
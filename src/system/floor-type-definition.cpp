@@ -4,3 +4,44 @@ bool FloorType::is_in_dungeon() const
 {
     return this->dun_level > 0;
 }
+
+/*!
+ * @brief 地形変化が流れ場の結果に影響し得るかを返す
+ * @param y 地形の変化したY座標
+ * @param x 地形の変化したX座標
+ * @return 流れ場を書き込んだ範囲かその外周1マスに含まれるならばTRUE
+ * @details 範囲外のマスは一度も到達されていないので、通行可否が変わっても
+ * 到達済みのマスに隣接していない限り結果は変わらない.
+ */
+bool FlowFieldState::is_affected_by(POSITION y, POSITION x) const
+{
+    if (this->whole_floor) {
+        return true;
+    }
+
+    return (y >= this->top - 1) && (y <= this->bottom + 1) && (x >= this->left - 1) && (x <= this->right + 1);
+}
+
+/*!
+ * @brief 流れ場の記録を破棄し、次回の update_flow() でフロア全体を再計算させる
+ * @details フロアの生成・読み込みや forget_flow() のように、流れ場の内容を外部から書き換えた時に呼ぶ.
+ */
+void FloorType::reset_flow()
+{
+    this->flow_state = {};
+}
+
+/*!
+ * @brief 地形の変化を流れ場に通知する
+ * @param y 地形の変化したY座標
+ * @param x 地形の変化したX座標
+ * @details 変化が前回の流れ場に影響し得る場合のみ、次回の update_flow() で再計算させる.
+ * 地形の版数は変化の位置に依らず常に進める.
+ */
+void FloorType::notice_terrain_change(POSITION y, POSITION x)
+{
+    this->terrain_version++;
+    if (this->flow_state.valid && this->flow_state.is_affected_by(y, x)) {
+        this->flow_state.valid = false;
+    }
+}
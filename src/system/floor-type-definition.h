@@ -2,8 +2,12 @@
 
 #include "dungeon/quest.h"
 #include "floor/floor-base-definitions.h"
+#include "floor/monster-spatial-index.h"
+#include "monster/monster-scheduler.h"
 #include "monster/monster-timed-effect-types.h"
 #include "system/angband.h"
+#include "system/entity-slot-allocator.h"
+#include "system/grid-array.h"
 #include <array>
 #include <vector>
 
@@ -33,6 +37,24 @@ constexpr auto VIEW_MAX = 1536;
  */
 constexpr auto REDRAW_MAX = 2298;
 
+/*!
+ * @brief 前回 update_flow() で計算した流れ場の記録 / Record of the last flow computation
+ * @details 流れ場は起点から一定歩数の範囲にしか広がらないため、起点と書き込んだ矩形範囲を覚えておき、
+ * 消去や地形変化時の無効化判定をその範囲に限定する.
+ */
+struct FlowFieldState {
+    bool valid = false; //!< 流れ場が現在の起点と地形に対して最新か
+    bool whole_floor = true; //!< 範囲が不明でフロア全体の消去が必要か
+    POSITION origin_y = 0; //!< 流れ場の起点 (計算時のプレイヤー位置)
+    POSITION origin_x = 0;
+    POSITION top = 0; //!< 流れ場を書き込んだ範囲 (top > bottom なら空)
+    POSITION bottom = -1;
+    POSITION left = 0;
+    POSITION right = -1;
+
+    bool is_affected_by(POSITION y, POSITION x) const;
+};
+
 struct grid_type;
 class MonsterEntity;
 class ItemEntity;
@@ -40,7 +62,7 @@ class FloorType {
 public:
     FloorType() = default;
     DUNGEON_IDX dungeon_idx = 0;
-    std::vector<std::vector<grid_type>> grid_array;
+    GridArray grid_array; //!< マス目の連続配置ストレージ [MAX_HGT][MAX_WID]
     DEPTH dun_level = 0; /*!< 現在の実ダンジョン階層 base_level の参照元となる / Current dungeon level */
     DEPTH base_level = 0; /*!< 基本生成レベル、後述のobject_level, monster_levelの参照元となる / Base dungeon level */
     DEPTH object_level = 0; /*!< アイテムの生成レベル、 base_level を起点に一時変更する時に参照 / Current object creation level */
@@ -54,10 +76,14 @@ public:
     std::vector<ItemEntity> o_list; /*!< The array of dungeon items [max_o_idx] */
     OBJECT_IDX o_max = 0; /* Number of allocated objects */
     OBJECT_IDX o_cnt = 0; /* Number of live objects */
+    EntitySlotAllocator o_slots; //!< アイテム配列の空き要素と世代番号
 
     std::vector<MonsterEntity> m_list; /*!< The array of dungeon monsters [max_m_idx] */
     MONSTER_IDX m_max = 0; /* Number of allocated monsters */
     MONSTER_IDX m_cnt = 0; /* Number of live monsters */
+    EntitySlotAllocator m_slots; //!< モンスター配列の空き要素と世代番号
+    MonsterScheduler m_scheduler; //!< モンスターの行動予定
+    MonsterSpatialIndex m_spatial_index; //!< モンスターの位置の空間索引
 
     std::vector<int16_t> mproc_list[MAX_MTIMED]{}; /*!< The array to process dungeon monsters[max_m_idx] */
     int16_t mproc_max[MAX_MTIMED]{}; /*!< Number of monsters to be processed */
@@ -82,5 +108,10 @@ public:
     QuestId quest_number = QuestId::NONE; /* Inside quest level */
     bool inside_arena = false; /* Is character inside on_defeat_arena_monster? */
 
+    FlowFieldState flow_state{}; //!< 流れ場の計算範囲と起点
+    uint32_t terrain_version = 0; //!< 地形が変化する度に増える版数 (地形に依存する計算結果の使い回し判定用)
+
     bool is_in_dungeon() const;
+    void reset_flow();
+    void notice_terrain_change(POSITION y, POSITION x);
 };
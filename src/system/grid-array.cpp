@@ -0,0 +1,90 @@
+﻿#include "system/grid-array.h"
+#include "monster-race/race-flags7.h"
+#include "system/monster-race-info.h"
+#include <algorithm>
+
+/*!
+ * @brief 全平面を指定の大きさで確保し直す
+ * @param height 縦のマス数
+ * @param width 横のマス数
+ */
+void GridArray::resize(POSITION height, POSITION width)
+{
+    const auto size = static_cast<size_t>(height * width);
+    this->width = width;
+    this->grids.assign(size, grid_type{});
+    this->o_idx_lists.assign(size, ObjectIndexList{});
+    for (auto &plane : this->costs) {
+        plane.assign(size, 0);
+    }
+
+    for (auto &plane : this->dists) {
+        plane.assign(size, 0);
+    }
+
+    this->whens.assign(size, 0);
+}
+
+/*!
+ * @brief モンスターの移動種別に応じた流れ場の移動コストを返す
+ * @param y Y座標
+ * @param x X座標
+ * @param r_ptr モンスター種族への参照ポインタ
+ * @return プレイヤーまでの移動コスト (未到達なら0)
+ */
+byte GridArray::get_cost(POSITION y, POSITION x, const MonsterRaceInfo *r_ptr) const
+{
+    return this->costs[get_flow_type(r_ptr)][y * this->width + x];
+}
+
+/*!
+ * @brief モンスターの移動種別に応じた流れ場の歩数を返す
+ * @param y Y座標
+ * @param x X座標
+ * @param r_ptr モンスター種族への参照ポインタ
+ * @return プレイヤーまでの歩数 (未到達なら0)
+ */
+byte GridArray::get_distance(POSITION y, POSITION x, const MonsterRaceInfo *r_ptr) const
+{
+    return this->dists[get_flow_type(r_ptr)][y * this->width + x];
+}
+
+/*!
+ * @brief 矩形範囲の流れ場を消去する
+ * @details 平面ごとに行単位で連続領域を埋めるため、マス情報には触れない.
+ */
+void GridArray::clear_flow(POSITION y1, POSITION x1, POSITION y2, POSITION x2)
+{
+    if ((y1 > y2) || (x1 > x2)) {
+        return;
+    }
+
+    const auto length = x2 - x1 + 1;
+    for (auto y = y1; y <= y2; y++) {
+        const auto offset = y * this->width + x1;
+        for (auto flow = 0; flow < FLOW_MAX; flow++) {
+            std::fill_n(this->costs[flow].begin() + offset, length, 0);
+            std::fill_n(this->dists[flow].begin() + offset, length, 0);
+        }
+    }
+}
+
+/*!
+ * @brief 矩形範囲の匂いの記録を消去する
+ */
+void GridArray::clear_when(POSITION y1, POSITION x1, POSITION y2, POSITION x2)
+{
+    if ((y1 > y2) || (x1 > x2)) {
+        return;
+    }
+
+    const auto length = x2 - x1 + 1;
+    for (auto y = y1; y <= y2; y++) {
+        std::fill_n(this->whens.begin() + y * this->width + x1, length, 0);
+    }
+}
+
+flow_type GridArray::get_flow_type(const MonsterRaceInfo *r_ptr)
+{
+    return r_ptr->feature_flags.has(MonsterFeatureType::CAN_FLY) ? FLOW_CAN_FLY : FLOW_NORMAL;
+}
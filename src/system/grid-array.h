@@ -0,0 +1,88 @@
+﻿#pragma once
+
+#include "object/object-index-list.h"
+#include "system/angband.h"
+#include "system/grid-type-definition.h"
+#include <array>
+#include <vector>
+
+class MonsterRaceInfo;
+
+/*!
+ * @brief フロアのマス目を行優先で連続配置するストレージ
+ * @details マス情報 (grid_type) は1本の連続領域に並べ、grid_array[y][x] の形で参照できる.
+ * フロア全体を走査する流れ場 (costs/dists) と匂いの記録 (when) はマス情報から切り離し、
+ * それぞれを1バイトの連続した平面として持つことで、走査時にマス情報全体をキャッシュへ読み込まずに済ませる.
+ * 床上のアイテムリスト (o_idx_list) も同じ並びの別表に置き、マス情報を小さく保つ.
+ */
+class GridArray {
+public:
+    GridArray() = default;
+
+    void resize(POSITION height, POSITION width);
+
+    grid_type *operator[](POSITION y)
+    {
+        return &this->grids[y * this->width];
+    }
+
+    const grid_type *operator[](POSITION y) const
+    {
+        return &this->grids[y * this->width];
+    }
+
+    byte &cost(flow_type flow, POSITION y, POSITION x)
+    {
+        return this->costs[flow][y * this->width + x];
+    }
+
+    byte &dist(flow_type flow, POSITION y, POSITION x)
+    {
+        return this->dists[flow][y * this->width + x];
+    }
+
+    byte &when(POSITION y, POSITION x)
+    {
+        return this->whens[y * this->width + x];
+    }
+
+    byte when(POSITION y, POSITION x) const
+    {
+        return this->whens[y * this->width + x];
+    }
+
+    ObjectIndexList &o_idx_list(POSITION y, POSITION x)
+    {
+        return this->o_idx_lists[y * this->width + x];
+    }
+
+    const ObjectIndexList &o_idx_list(POSITION y, POSITION x) const
+    {
+        return this->o_idx_lists[y * this->width + x];
+    }
+
+    ObjectIndexList &o_idx_list(const grid_type *g_ptr)
+    {
+        return this->o_idx_lists[g_ptr - this->grids.data()];
+    }
+
+    const ObjectIndexList &o_idx_list(const grid_type *g_ptr) const
+    {
+        return this->o_idx_lists[g_ptr - this->grids.data()];
+    }
+
+    byte get_cost(POSITION y, POSITION x, const MonsterRaceInfo *r_ptr) const;
+    byte get_distance(POSITION y, POSITION x, const MonsterRaceInfo *r_ptr) const;
+    void clear_flow(POSITION y1, POSITION x1, POSITION y2, POSITION x2);
+    void clear_when(POSITION y1, POSITION x1, POSITION y2, POSITION x2);
+
+private:
+    POSITION width = 0;
+    std::vector<grid_type> grids;
+    std::vector<ObjectIndexList> o_idx_lists;
+    std::array<std::vector<byte>, FLOW_MAX> costs{};
+    std::array<std::vector<byte>, FLOW_MAX> dists{};
+    std::vector<byte> whens;
+
+    static flow_type get_flow_type(const MonsterRaceInfo *r_ptr);
+};
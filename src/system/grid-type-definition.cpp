@@ -91,21 +91,6 @@ bool grid_type::is_rune_explosion() const
     return this->is_object() && terrains_info[this->mimic].flags.has(TerrainCharacteristics::RUNE_EXPLOSION);
 }
 
-byte grid_type::get_cost(MonsterRaceInfo *r_ptr) const
-{
-    return this->costs[get_grid_flow_type(r_ptr)];
-}
-
-byte grid_type::get_distance(MonsterRaceInfo *r_ptr) const
-{
-    return this->dists[get_grid_flow_type(r_ptr)];
-}
-
-flow_type grid_type::get_grid_flow_type(MonsterRaceInfo *r_ptr) const
-{
-    return r_ptr->feature_flags.has(MonsterFeatureType::CAN_FLY) ? FLOW_CAN_FLY : FLOW_NORMAL;
-}
-
 /*
  * @brief グリッドのミミック特性地形を返す
  * @param g_ptr グリッドへの参照ポインタ
@@ -1,6 +1,5 @@
 ﻿#pragma once
 
-#include "object/object-index-list.h"
 #include "system/angband.h"
 
 /*
@@ -51,7 +50,6 @@ public:
     BIT_FLAGS info{}; /* Hack -- grid flags */
 
     FEAT_IDX feat{}; /* Hack -- feature type */
-    ObjectIndexList o_idx_list; /* Object list in this grid */
     MONSTER_IDX m_idx{}; /* Monster in this grid */
 
     /*
@@ -63,10 +61,6 @@ public:
 
     FEAT_IDX mimic{}; /* Feature to mimic */
 
-    byte costs[FLOW_MAX]{}; /* Hack -- cost of flowing */
-    byte dists[FLOW_MAX]{}; /* Hack -- distance from player */
-    byte when{}; /* Hack -- when cost was computed */
-
     bool is_floor() const;
     bool is_room() const;
     bool is_extra() const;
@@ -82,12 +76,7 @@ public:
     bool is_mirror() const;
     bool is_rune_protection() const;
     bool is_rune_explosion() const;
-    byte get_cost(MonsterRaceInfo *r_ptr) const;
-    byte get_distance(MonsterRaceInfo *r_ptr) const;
     FEAT_IDX get_feat_mimic() const;
     bool cave_has_flag(TerrainCharacteristics feature_flags) const;
     bool is_symbol(const int ch) const;
-
-private:
-    flow_type get_grid_flow_type(MonsterRaceInfo *r_ptr) const;
 };
@@ -53,6 +53,7 @@ public:
     /* TODO: クローン、ペット、有効化は意義が異なるので別変数に切り離すこと。save/loadのバージョン更新が面倒そうだけど */
     EnumClassFlagGroup<MonsterSmartLearnType> smart{}; /*!< モンスターのプレイヤーに対する学習状態 / Field for "smart_learn" - Some bit-flags for the "smart" field */
     MONSTER_IDX parent_m_idx{}; /*!< 召喚主のモンスターID */
+    uint32_t parent_generation{}; /*!< 召喚された時の召喚主の世代番号 (召喚主が消滅したかの判定用、セーブ不要) */
 
     bool is_friendly() const;
     bool is_pet() const;
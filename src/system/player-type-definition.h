@@ -6,6 +6,7 @@
 #include "player-info/class-specific-data.h"
 #include "player-info/class-types.h"
 #include "player-info/race-types.h"
+#include "player/player-flag-cause-table.h"
 #include "player/player-personality-types.h"
 #include "player/player-sex.h"
 #include "system/angband.h"
@@ -228,6 +229,7 @@ public:
     std::shared_ptr<ItemEntity[]> inventory_list{}; /* The player's inventory */
     int16_t inven_cnt{}; /* Number of items in inventory */
     int16_t equip_cnt{}; /* Number of items in equipment */
+    PlayerFlagCauseTable flag_cause_table{}; /* 特性フラグを得ている要因の表 */
 
     /*** Temporary fields ***/
 
@@ -14,6 +14,7 @@
 #include "io/screen-util.h"
 #include "system/floor-type-definition.h"
 #include "system/grid-type-definition.h"
+#include "system/player-type-definition.h"
 #include "target/target-checker.h"
 #include "term/screen-processor.h"
 #include "timed-effect/player-hallucination.h"
@@ -84,7 +85,9 @@ static void tgt_pt_prepare(PlayerType *player_ptr, std::vector<POSITION> &ys, st
         }
     }
 
-    ang_sort(player_ptr, xs.data(), ys.data(), size(ys), ang_sort_comp_distance, ang_sort_swap_position);
+    ang_sort_positions(ys, xs, [player_ptr](const auto &pos1, const auto &pos2) {
+        return ang_sort_comp_distance(player_ptr, pos1, pos2);
+    });
 }
 
 /*!
@@ -109,7 +112,7 @@ std::unordered_map<int, std::function<bool(grid_type *)>> tgt_pt_symbol_call_bac
 /*!
  * @brief 位置ターゲット指定情報構造体
  * @details
- * ang_sort() を利用する関係上、y/x 座標それぞれについて配列を作る。
+ * ang_sort_positions() を利用する関係上、y/x 座標それぞれについて配列を作る。
  */
 struct tgt_pt_info {
     TERM_LEN wid; //!< 画面サイズ(幅)
@@ -2,12 +2,14 @@
 #include "effect/effect-characteristics.h"
 #include "effect/spells-effect-util.h"
 #include "floor/cave.h"
+#include "floor/grid-pair-memo.h"
 #include "grid/feature-flag-types.h"
 #include "spell-class/spells-mirror-master.h"
 #include "system/floor-type-definition.h"
 #include "system/grid-type-definition.h"
 #include "system/player-type-definition.h"
 #include "util/bit-flags-calculator.h"
+#include "world/world.h"
 
 struct projection_path_type {
     std::vector<std::pair<int, int>> *position;
@@ -60,6 +62,103 @@ int projection_path::path_num() const
     return static_cast<int>(this->position.size());
 }
 
+namespace {
+constexpr auto PATH_TEMPLATE_RADIUS = 40; //!< 経路テンプレートを用意する終点の相対座標の最大値
+constexpr auto PATH_TEMPLATE_LENGTH = 40; //!< 経路テンプレートの長さ (これを超える射程は逐次計算する)
+constexpr auto PROJECTABLE_MEMO_SIZE = 1024; //!< projectable() の結果を覚えておく数 (2の冪)
+
+/*!
+ * @brief 経路テンプレートの1マス
+ * @details 始点からの相対座標 (符号は終点の象限に合わせて付け直す) と、射程と比較する経路長を持つ
+ */
+struct PathStep {
+    int8_t dy;
+    int8_t dx;
+    uint8_t length;
+};
+
+/*!
+ * @brief 終点が第1象限の (ay, ax) にある時の経路を、地形を無視して最大長まで求める
+ * @param ay 終点の相対Y座標 (0以上)
+ * @param ax 終点の相対X座標 (0以上)
+ * @return 経路テンプレート
+ * @details projection_path の逐次計算と同じ手順で、射程判定に用いる「マス数+斜め移動数/2」も記録する
+ */
+std::vector<PathStep> build_path_template(int ay, int ax)
+{
+    std::vector<PathStep> steps;
+    steps.reserve(PATH_TEMPLATE_LENGTH);
+    if (ay == ax) {
+        for (auto n = 1; n <= PATH_TEMPLATE_LENGTH; n++) {
+            steps.push_back({ static_cast<int8_t>(n), static_cast<int8_t>(n), static_cast<uint8_t>(n * 3 / 2) });
+        }
+
+        return steps;
+    }
+
+    const auto is_vertical = ay > ax;
+    const auto half = ay * ax;
+    const auto full = half << 1;
+    const auto m = is_vertical ? ax * ax * 2 : ay * ay * 2;
+    auto major = 1;
+    auto minor = 0;
+    auto frac = m;
+    auto k = 0;
+    if (frac > half) {
+        minor++;
+        frac -= full;
+        k++;
+    }
+
+    for (auto n = 1; n <= PATH_TEMPLATE_LENGTH; n++) {
+        const auto length = static_cast<uint8_t>(n + k / 2);
+        if (is_vertical) {
+            steps.push_back({ static_cast<int8_t>(major), static_cast<int8_t>(minor), length });
+        } else {
+            steps.push_back({ static_cast<int8_t>(minor), static_cast<int8_t>(major), length });
+        }
+
+        if (m != 0) {
+            frac += m;
+            if (frac > half) {
+                minor++;
+                frac -= full;
+                k++;
+            }
+        }
+
+        major++;
+    }
+
+    return steps;
+}
+
+/*!
+ * @brief 終点の相対座標に対応する経路テンプレートを返す
+ * @param ay 終点の相対Y座標の絶対値
+ * @param ax 終点の相対X座標の絶対値
+ * @details 経路は象限について対称なので、第1象限の分だけを初回呼び出し時にまとめて作る
+ */
+const std::vector<PathStep> &get_path_template(int ay, int ax)
+{
+    static std::vector<std::vector<PathStep>> templates;
+    if (templates.empty()) {
+        templates.resize((PATH_TEMPLATE_RADIUS + 1) * (PATH_TEMPLATE_RADIUS + 1));
+        for (auto y = 0; y <= PATH_TEMPLATE_RADIUS; y++) {
+            for (auto x = 0; x <= PATH_TEMPLATE_RADIUS; x++) {
+                if ((y != 0) || (x != 0)) {
+                    templates[y * (PATH_TEMPLATE_RADIUS + 1) + x] = build_path_template(y, x);
+                }
+            }
+        }
+    }
+
+    return templates[ay * (PATH_TEMPLATE_RADIUS + 1) + ax];
+}
+
+GridPairMemo<PROJECTABLE_MEMO_SIZE> projectable_memo; //!< projectable() の結果 (射程を付加キーとする)
+}
+
 static projection_path_type *initialize_projection_path_type(
     projection_path_type *pp_ptr, std::vector<std::pair<int, int>> *position, POSITION range, BIT_FLAGS flag, POSITION y1, POSITION x1, POSITION y2, POSITION x2)
 {
@@ -213,6 +312,26 @@ static bool calc_horizontal_projection(PlayerType *player_ptr, projection_path_t
     return true;
 }
 
+/*!
+ * @brief 経路テンプレートを辿って経路を求める
+ * @details 射程と停止条件の判定は逐次計算と同じで、マス毎の除算を省く
+ */
+static void calc_projection_by_template(PlayerType *player_ptr, projection_path_type *pp_ptr)
+{
+    for (const auto &step : get_path_template(pp_ptr->ay, pp_ptr->ax)) {
+        pp_ptr->y = pp_ptr->y1 + step.dy * pp_ptr->sy;
+        pp_ptr->x = pp_ptr->x1 + step.dx * pp_ptr->sx;
+        pp_ptr->position->emplace_back(pp_ptr->y, pp_ptr->x);
+        if (step.length >= pp_ptr->range) {
+            break;
+        }
+
+        if (project_stop(player_ptr, pp_ptr)) {
+            break;
+        }
+    }
+}
+
 static void calc_projection_others(PlayerType *player_ptr, projection_path_type *pp_ptr)
 {
     while (true) {
@@ -241,6 +360,7 @@ static void calc_projection_others(PlayerType *player_ptr, projection_path_type
  * @param x2 終点X座標
  * @param flag フラグID
  * @return リストの長さ
+ * @details 終点が近く射程も短い通常の場合は、事前に計算した経路テンプレートを辿る
  */
 projection_path::projection_path(PlayerType *player_ptr, POSITION range, POSITION y1, POSITION x1, POSITION y2, POSITION x2, BIT_FLAGS flag)
 {
@@ -252,6 +372,11 @@ projection_path::projection_path(PlayerType *player_ptr, POSITION range, POSITIO
     projection_path_type tmp_projection_path;
     auto *pp_ptr = initialize_projection_path_type(&tmp_projection_path, &this->position, range, flag, y1, x1, y2, x2);
     set_asxy(pp_ptr);
+    if ((pp_ptr->ay <= PATH_TEMPLATE_RADIUS) && (pp_ptr->ax <= PATH_TEMPLATE_RADIUS) && (range <= PATH_TEMPLATE_LENGTH)) {
+        calc_projection_by_template(player_ptr, pp_ptr);
+        return;
+    }
+
     pp_ptr->half = pp_ptr->ay * pp_ptr->ax;
     pp_ptr->full = pp_ptr->half << 1;
     pp_ptr->k = 0;
@@ -274,20 +399,26 @@ projection_path::projection_path(PlayerType *player_ptr, POSITION range, POSITIO
  * at the final destination, assuming no monster gets in the way.
  *
  * This is slightly (but significantly) different from "los(y1,x1,y2,x2)".
+ *
+ * 結果は地形だけで決まるので、ダンジョン生成後は同じゲームターンかつ地形が変わっていない間は覚えておいて使い回す.
  */
 bool projectable(PlayerType *player_ptr, POSITION y1, POSITION x1, POSITION y2, POSITION x2)
 {
-    projection_path grid_g(player_ptr, (project_length ? project_length : get_max_range(player_ptr)), y1, x1, y2, x2, 0);
-    if (grid_g.path_num() == 0) {
-        return true;
+    const auto range = project_length ? project_length : get_max_range(player_ptr);
+    const auto &floor = *player_ptr->current_floor_ptr;
+    if (const auto *result = projectable_memo.find(floor, y1, x1, y2, x2, range); result != nullptr) {
+        return *result;
     }
 
-    const auto [y, x] = grid_g.back();
-    if ((y != y2) || (x != x2)) {
-        return false;
+    projection_path grid_g(player_ptr, range, y1, x1, y2, x2, 0);
+    auto is_projectable = true;
+    if (grid_g.path_num() > 0) {
+        const auto [y, x] = grid_g.back();
+        is_projectable = (y == y2) && (x == x2);
     }
 
-    return true;
+    projectable_memo.store(y1, x1, y2, x2, is_projectable, range);
+    return is_projectable;
 }
 
 /*!
@@ -375,11 +375,11 @@ static char describe_footing_many_items(PlayerType *player_ptr, eg_type *eg_ptr,
             return eg_ptr->query;
         }
 
-        if (eg_ptr->g_ptr->o_idx_list.size() < 2) {
+        if (player_ptr->current_floor_ptr->grid_array.o_idx_list(eg_ptr->g_ptr).size() < 2) {
             continue;
         }
 
-        eg_ptr->g_ptr->o_idx_list.rotate(player_ptr->current_floor_ptr);
+        player_ptr->current_floor_ptr->grid_array.o_idx_list(eg_ptr->g_ptr).rotate(player_ptr->current_floor_ptr);
 
         // ターゲットしている床の座標を渡す必要があるので、window_stuff経由ではなく直接呼び出す
         fix_floor_item_list(player_ptr, eg_ptr->y, eg_ptr->x);
@@ -449,7 +449,7 @@ static int16_t describe_footing_sight(PlayerType *player_ptr, eg_type *eg_ptr, I
 
 static int16_t sweep_footing_items(PlayerType *player_ptr, eg_type *eg_ptr)
 {
-    for (const auto this_o_idx : eg_ptr->g_ptr->o_idx_list) {
+    for (const auto this_o_idx : player_ptr->current_floor_ptr->grid_array.o_idx_list(eg_ptr->g_ptr)) {
         ItemEntity *o_ptr;
         o_ptr = &player_ptr->current_floor_ptr->o_list[this_o_idx];
         int16_t ret = describe_footing_sight(player_ptr, eg_ptr, o_ptr);
@@ -500,7 +500,7 @@ static concptr decide_target_floor(PlayerType *player_ptr, eg_type *eg_ptr)
     return eg_ptr->f_ptr->name.data();
 }
 
-static void describe_grid_monster_all(eg_type *eg_ptr)
+static void describe_grid_monster_all(PlayerType *player_ptr, eg_type *eg_ptr)
 {
     if (!w_ptr->wizard) {
 #ifdef JP
@@ -511,6 +511,10 @@ static void describe_grid_monster_all(eg_type *eg_ptr)
         return;
     }
 
+    auto &grid_array = player_ptr->current_floor_ptr->grid_array;
+    const auto dist = grid_array.dist(FLOW_NORMAL, eg_ptr->y, eg_ptr->x);
+    const auto cost = grid_array.cost(FLOW_NORMAL, eg_ptr->y, eg_ptr->x);
+    const auto when = grid_array.when(eg_ptr->y, eg_ptr->x);
     char f_idx_str[32];
     if (eg_ptr->g_ptr->mimic) {
         sprintf(f_idx_str, "%d/%d", eg_ptr->g_ptr->feat, eg_ptr->g_ptr->mimic);
@@ -520,11 +524,11 @@ static void describe_grid_monster_all(eg_type *eg_ptr)
 
 #ifdef JP
     sprintf(eg_ptr->out_val, "%s%s%s%s[%s] %x %s %d %d %d (%d,%d) %d", eg_ptr->s1, eg_ptr->name, eg_ptr->s2, eg_ptr->s3, eg_ptr->info,
-        (uint)eg_ptr->g_ptr->info, f_idx_str, eg_ptr->g_ptr->dists[FLOW_NORMAL], eg_ptr->g_ptr->costs[FLOW_NORMAL], eg_ptr->g_ptr->when, (int)eg_ptr->y,
+        (uint)eg_ptr->g_ptr->info, f_idx_str, dist, cost, when, (int)eg_ptr->y,
         (int)eg_ptr->x, travel.cost[eg_ptr->y][eg_ptr->x]);
 #else
     sprintf(eg_ptr->out_val, "%s%s%s%s [%s] %x %s %d %d %d (%d,%d)", eg_ptr->s1, eg_ptr->s2, eg_ptr->s3, eg_ptr->name, eg_ptr->info, eg_ptr->g_ptr->info,
-        f_idx_str, eg_ptr->g_ptr->dists[FLOW_NORMAL], eg_ptr->g_ptr->costs[FLOW_NORMAL], eg_ptr->g_ptr->when, (int)eg_ptr->y, (int)eg_ptr->x);
+        f_idx_str, dist, cost, when, (int)eg_ptr->y, (int)eg_ptr->x);
 #endif
 }
 
@@ -600,7 +604,7 @@ char examine_grid(PlayerType *player_ptr, const POSITION y, const POSITION x, ta
     }
 #endif
 
-    describe_grid_monster_all(eg_ptr);
+    describe_grid_monster_all(player_ptr, eg_ptr);
     prt(eg_ptr->out_val, 0, 0);
     move_cursor_relative(y, x);
     eg_ptr->query = inkey();
@@ -94,7 +94,7 @@ static bool target_set_accept(PlayerType *player_ptr, POSITION y, POSITION x)
         }
     }
 
-    for (const auto this_o_idx : g_ptr->o_idx_list) {
+    for (const auto this_o_idx : floor_ptr->grid_array.o_idx_list(g_ptr)) {
         ItemEntity *o_ptr;
         o_ptr = &floor_ptr->o_list[this_o_idx];
         if (o_ptr->marked.has(OmType::FOUND)) {
@@ -164,9 +164,13 @@ void target_set_prepare(PlayerType *player_ptr, std::vector<POSITION> &ys, std::
     }
 
     if (mode & (TARGET_KILL)) {
-        ang_sort(player_ptr, xs.data(), ys.data(), size(ys), ang_sort_comp_distance, ang_sort_swap_position);
+        ang_sort_positions(ys, xs, [player_ptr](const auto &pos1, const auto &pos2) {
+            return ang_sort_comp_distance(player_ptr, pos1, pos2);
+        });
     } else {
-        ang_sort(player_ptr, xs.data(), ys.data(), size(ys), ang_sort_comp_importance, ang_sort_swap_position);
+        ang_sort_positions(ys, xs, [player_ptr](const auto &pos1, const auto &pos2) {
+            return ang_sort_comp_importance(player_ptr, pos1, pos2);
+        });
     }
 
     // 乗っているモンスターがターゲットリストの先頭にならないようにする調整。
@@ -0,0 +1,89 @@
+﻿/*!
+ * @file animation-scheduler.cpp
+ * @brief アニメーションのコマ描画と待ち時間の管理
+ */
+
+#include "term/animation-scheduler.h"
+#include "term/z-term.h"
+#include <chrono>
+
+namespace {
+constexpr auto MIN_FRAME_MSEC = 16; //!< 1コマの最短表示時間 (これより短いコマはまとめる)
+constexpr auto RESYNC_MSEC = 100; //!< 予定よりこれ以上遅れたら、待ち時間を数え直す
+}
+
+AnimationScheduler &AnimationScheduler::get_instance()
+{
+    static AnimationScheduler instance;
+    return instance;
+}
+
+/*!
+ * @brief 現在の画面をアニメーションの1コマとして表示する
+ * @param msec コマを表示しておく時間 (ミリ秒)
+ * @details
+ * まとめたコマの待ち時間が MIN_FRAME_MSEC に満たなければ、描画せずに次のコマへ持ち越す.
+ * キー入力が溜まっていれば何もしない.
+ */
+void AnimationScheduler::present_frame(int msec)
+{
+    if (is_input_pending()) {
+        this->pending_msec = 0;
+        return;
+    }
+
+    this->pending_msec += msec;
+    if (this->pending_msec < MIN_FRAME_MSEC) {
+        return;
+    }
+
+    this->present();
+}
+
+/*!
+ * @brief アニメーションを終え、持ち越したコマがあれば表示してから最終的な画面を描画する
+ */
+void AnimationScheduler::finish()
+{
+    if ((this->pending_msec > 0) && !is_input_pending()) {
+        this->present();
+    }
+
+    this->pending_msec = 0;
+    term_fresh();
+}
+
+/*!
+ * @brief 画面を描画し、持ち越し分を含めた待ち時間が過ぎるまで待つ
+ * @details 前のコマの表示終了時刻から続けて数えるため、コマの間の処理時間は待ち時間に含まれる
+ */
+void AnimationScheduler::present()
+{
+    const auto now = now_msec();
+    if (now - this->deadline_msec > RESYNC_MSEC) {
+        this->deadline_msec = now;
+    }
+
+    term_fresh();
+    this->deadline_msec += this->pending_msec;
+    this->pending_msec = 0;
+    const auto rest = this->deadline_msec - now_msec();
+    if (rest > 0) {
+        term_xtra(TERM_XTRA_DELAY, static_cast<int>(rest));
+    }
+}
+
+int64_t AnimationScheduler::now_msec()
+{
+    return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/*!
+ * @brief 未処理のキー入力があるかを返す
+ * @details キーは取り出さずに覗くだけにする
+ */
+bool AnimationScheduler::is_input_pending()
+{
+    char ch;
+    return term_inkey(&ch, false, false) == 0;
+}
@@ -0,0 +1,30 @@
+﻿#pragma once
+
+#include <cstdint>
+
+/*!
+ * @brief 投射・ボルト等のアニメーションのコマを、時間を管理しながら描画するスケジューラ
+ * @details
+ * 1コマ毎に term_fresh() と固定時間の待ちを繰り返す代わりに、以下を行う.
+ * - 待ち時間の短いコマはまとめて1回の描画にする (描画は最大でも約60コマ/秒)
+ * - 待ち時間はコマの表示開始時刻から数え、その間のゲーム処理や描画に掛かった時間を差し引く
+ * - キー入力が溜まっていれば描画も待ちも行わず、アニメーションを読み飛ばす
+ * コマを描いたら消去 (lite_spot() 等) 前に present_frame() を呼び、アニメーションの最後に finish() を呼ぶ.
+ */
+class AnimationScheduler {
+public:
+    static AnimationScheduler &get_instance();
+
+    void present_frame(int msec);
+    void finish();
+
+private:
+    AnimationScheduler() = default;
+
+    int pending_msec = 0; //!< まだ描画していないコマの待ち時間の合計
+    int64_t deadline_msec = 0; //!< 最後に描画したコマの表示を終える時刻
+
+    static int64_t now_msec();
+    static bool is_input_pending();
+    void present();
+};
@@ -15,10 +15,12 @@
 #include "world/world.h"
 
 #include <algorithm>
+#include <array>
 #include <cmath>
 #include <limits>
 #include <optional>
 #include <random>
+#include <utility>
 
 /*
  * Angband 2.7.9 introduced a new (optimized) random number generator,
@@ -52,6 +54,10 @@
  * RNG algorithm was fully rewritten. Upper comment is OLD.
  */
 
+namespace {
+bool use_legacy_mapping = false; //!< 範囲への写像に std::uniform_int_distribution を使うか
+}
+
 void Rand_state_init(void)
 {
     using element_type = Xoshiro128StarStar::state_type::value_type;
@@ -69,13 +75,33 @@ void Rand_state_init(void)
     w_ptr->rng.set_state(Rand_state);
 }
 
+/*!
+ * @brief 乱数を範囲へ写像する方法を切り替える
+ * @details
+ * 高速な Xoshiro128StarStar::bounded() は std::uniform_int_distribution と同じ値を返すとは限らない (標準ライブラリの実装による)。
+ * シードから再生成するフレーバーや荒野の地形が既存のセーブファイルと変わらないよう、
+ * それらを生成する間は従来の写像を使う。
+ * @param enable 従来の写像を使うならtrue
+ * @return 切り替える前の設定
+ */
+bool Rand_set_legacy_mapping(bool enable)
+{
+    return std::exchange(use_legacy_mapping, enable);
+}
+
 int rand_range(int a, int b)
 {
     if (a > b) {
         return a;
     }
-    std::uniform_int_distribution<> d(a, b);
-    return d(w_ptr->rng);
+
+    if (use_legacy_mapping) {
+        std::uniform_int_distribution<> d(a, b);
+        return d(w_ptr->rng);
+    }
+
+    const auto range = static_cast<uint32_t>(b) - static_cast<uint32_t>(a) + 1;
+    return static_cast<int>(static_cast<uint32_t>(a) + w_ptr->rng.bounded(range));
 }
 
 /*
@@ -93,14 +119,35 @@ int16_t randnor(int mean, int stand)
 
 /*
  * Generates damage for "2d6" style dice rolls
+ * 出目はまとめて生成するが、1個ずつ randint1() を呼んだ場合と同じ乱数列になる
  */
 int16_t damroll(DICE_NUMBER num, DICE_SID sides)
 {
-    int i, sum = 0;
-    for (i = 0; i < num; i++) {
-        sum += randint1(sides);
+    if (sides <= 0) {
+        return static_cast<int16_t>(std::max<int>(num, 0));
     }
-    return (int16_t)(sum);
+
+    if (use_legacy_mapping) {
+        auto sum = 0;
+        for (auto i = 0; i < num; i++) {
+            sum += randint1(sides);
+        }
+
+        return static_cast<int16_t>(sum);
+    }
+
+    constexpr auto ROLL_BUFFER_SIZE = 16;
+    std::array<uint32_t, ROLL_BUFFER_SIZE> rolls;
+    auto sum = 0;
+    for (auto rest = num; rest > 0; rest -= ROLL_BUFFER_SIZE) {
+        const auto count = std::min(rest, ROLL_BUFFER_SIZE);
+        w_ptr->rng.fill(rolls.begin(), rolls.begin() + count, static_cast<uint32_t>(sides));
+        for (auto i = 0; i < count; i++) {
+            sum += static_cast<int>(rolls[i]) + 1;
+        }
+    }
+
+    return static_cast<int16_t>(sum);
 }
 
 /*
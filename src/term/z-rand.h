@@ -66,6 +66,7 @@ int rand_range(int a, int b);
 #define saving_throw(S) (randint0(100) < (S))
 
 void Rand_state_init(void);
+bool Rand_set_legacy_mapping(bool enable);
 int16_t randnor(int mean, int stand);
 int16_t damroll(DICE_NUMBER num, DICE_SID sides);
 int16_t maxroll(DICE_NUMBER num, DICE_SID sides);
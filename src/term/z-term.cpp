@@ -14,6 +14,7 @@
 #include "term/gameterm.h"
 #include "term/term-color-types.h"
 #include "term/z-virt.h"
+#include <cstring>
 
 /* Special flags in the attr data */
 #define AF_BIGTILE2 0xf0
@@ -39,10 +40,10 @@ term_type *game_term = nullptr;
  * Initialize a "term_win" (using the given window size)
  */
 term_win::term_win(TERM_LEN w, TERM_LEN h)
-    : a(h, std::vector<TERM_COLOR>(w))
-    , c(h, std::vector<char>(w))
-    , ta(h, std::vector<TERM_COLOR>(w))
-    , tc(h, std::vector<char>(w))
+    : a(w, h)
+    , c(w, h)
+    , ta(w, h)
+    , tc(w, h)
 {
 }
 
@@ -66,21 +67,14 @@ std::unique_ptr<term_win> term_win::clone() const
 void term_win::resize(TERM_LEN w, TERM_LEN h)
 {
     /* Ignore non-changes */
-    if (this->a.size() == static_cast<size_t>(h) && this->a[0].size() == static_cast<size_t>(w)) {
+    if ((this->a.height() == h) && (this->a.width() == w)) {
         return;
     }
 
-    this->a.resize(h, std::vector<TERM_COLOR>(w));
-    this->c.resize(h, std::vector<char>(w));
-    this->ta.resize(h, std::vector<TERM_COLOR>(w));
-    this->tc.resize(h, std::vector<char>(w));
-
-    for (TERM_LEN y = 0; y < h; y++) {
-        this->a[y].resize(w);
-        this->c[y].resize(w);
-        this->ta[y].resize(w);
-        this->tc[y].resize(w);
-    }
+    this->a.resize(w, h);
+    this->c.resize(w, h);
+    this->ta.resize(w, h);
+    this->tc.resize(w, h);
 
     /* Illegal cursor */
     if (this->cx >= w) {
@@ -400,17 +394,17 @@ static void term_queue_chars(TERM_LEN x, TERM_LEN y, int n, TERM_COLOR a, concpt
 {
     TERM_LEN x1 = -1, x2 = -1;
 
-    auto &scr_aa = game_term->scr->a[y];
+    auto *scr_aa = game_term->scr->a[y];
 #ifdef JP
-    auto &scr_cc = game_term->scr->c[y];
+    auto *scr_cc = game_term->scr->c[y];
 
-    auto &scr_taa = game_term->scr->ta[y];
-    auto &scr_tcc = game_term->scr->tc[y];
+    auto *scr_taa = game_term->scr->ta[y];
+    auto *scr_tcc = game_term->scr->tc[y];
 #else
-    auto &scr_cc = game_term->scr->c[y];
+    auto *scr_cc = game_term->scr->c[y];
 
-    auto &scr_taa = game_term->scr->ta[y];
-    auto &scr_tcc = game_term->scr->tc[y];
+    auto *scr_taa = game_term->scr->ta[y];
+    auto *scr_tcc = game_term->scr->tc[y];
 #endif
 
 #ifdef JP
@@ -530,23 +524,114 @@ static void term_queue_chars(TERM_LEN x, TERM_LEN y, int n, TERM_COLOR a, concpt
 
 /*** Refresh routines ***/
 
+/*
+ * 8バイト単位の比較に用いる語
+ */
+using term_word = uint64_t;
+constexpr int TERM_WORD_SIZE = sizeof(term_word);
+
+/*
+ * Load 8 cells of a plane as one word
+ */
+template <typename T>
+static term_word term_load_word(const TermPlane<T> &plane, TERM_LEN y, TERM_LEN x)
+{
+    term_word word;
+    std::memcpy(&word, &plane[y][x], sizeof(word));
+    return word;
+}
+
+/*
+ * 表示中の画面と要求された画面で、(x, y) から8マスの内容が全て一致するか
+ */
+static bool term_same_word(const term_win &old, const term_win &scr, TERM_LEN y, TERM_LEN x)
+{
+    const auto diff = (term_load_word(old.a, y, x) ^ term_load_word(scr.a, y, x)) | (term_load_word(old.c, y, x) ^ term_load_word(scr.c, y, x)) | (term_load_word(old.ta, y, x) ^ term_load_word(scr.ta, y, x)) | (term_load_word(old.tc, y, x) ^ term_load_word(scr.tc, y, x));
+    return diff == 0;
+}
+
+/*
+ * 表示中の画面と要求された画面で、(x, y) の内容が一致するか
+ */
+static bool term_same_cell(const term_win &old, const term_win &scr, TERM_LEN y, TERM_LEN x)
+{
+    return (old.a[y][x] == scr.a[y][x]) && (old.c[y][x] == scr.c[y][x]) && (old.ta[y][x] == scr.ta[y][x]) && (old.tc[y][x] == scr.tc[y][x]);
+}
+
+/*
+ * 行の変更範囲 [x1, x2] を、表示中の画面と要求された画面の内容が実際に異なる範囲に絞り込む
+ * 4面を8マスずつまとめて比較し、差のある語の中だけを1マスずつ調べる
+ * 全角文字や大きいタイルの片割れだけを描画しないよう、絞り込んだ両端は対になるマスまで広げる
+ * 差が無ければFALSEを返す
+ */
+static bool term_narrow_row_span(TERM_LEN y, TERM_LEN &x1, TERM_LEN &x2)
+{
+    const auto &old = *game_term->old;
+    const auto &scr = *game_term->scr;
+
+#ifdef JP
+    /* 全角文字の1バイト目は次のマスとまとめて比較される */
+    const auto hi = std::min(x2 + 1, game_term->wid - 1);
+#else
+    const auto hi = x2;
+#endif
+
+    auto first = x1;
+    while ((first + TERM_WORD_SIZE - 1 <= hi) && term_same_word(old, scr, y, first)) {
+        first += TERM_WORD_SIZE;
+    }
+
+    while ((first <= hi) && term_same_cell(old, scr, y, first)) {
+        first++;
+    }
+
+    if (first > hi) {
+        return false;
+    }
+
+    auto last = hi;
+    while ((last - TERM_WORD_SIZE + 1 > first) && term_same_word(old, scr, y, last - TERM_WORD_SIZE + 1)) {
+        last -= TERM_WORD_SIZE;
+    }
+
+    while (term_same_cell(old, scr, y, last)) {
+        last--;
+    }
+
+    auto new_x1 = std::min(first, x2);
+    auto new_x2 = std::min(last, x2);
+#ifdef JP
+    if ((new_x1 > x1) && ((old.a[y][new_x1] | scr.a[y][new_x1]) & AF_KANJI2)) {
+        new_x1--;
+    }
+
+    if ((new_x2 < x2) && ((old.a[y][new_x2] | scr.a[y][new_x2]) & AF_KANJI1)) {
+        new_x2++;
+    }
+#endif
+
+    x1 = new_x1;
+    x2 = new_x2;
+    return true;
+}
+
 /*
  * Flush a row of the current window (see "term_fresh")
  * Display text using "term_pict()"
  */
 static void term_fresh_row_pict(TERM_LEN y, TERM_LEN x1, TERM_LEN x2)
 {
-    auto &old_aa = game_term->old->a[y];
-    auto &old_cc = game_term->old->c[y];
+    auto *old_aa = game_term->old->a[y];
+    auto *old_cc = game_term->old->c[y];
 
-    const auto &scr_aa = game_term->scr->a[y];
-    const auto &scr_cc = game_term->scr->c[y];
+    const auto *scr_aa = game_term->scr->a[y];
+    const auto *scr_cc = game_term->scr->c[y];
 
-    auto &old_taa = game_term->old->ta[y];
-    auto &old_tcc = game_term->old->tc[y];
+    auto *old_taa = game_term->old->ta[y];
+    auto *old_tcc = game_term->old->tc[y];
 
-    const auto &scr_taa = game_term->scr->ta[y];
-    const auto &scr_tcc = game_term->scr->tc[y];
+    const auto *scr_taa = game_term->scr->ta[y];
+    const auto *scr_tcc = game_term->scr->tc[y];
 
     TERM_COLOR ota;
     char otc;
@@ -656,16 +741,16 @@ static void term_fresh_row_pict(TERM_LEN y, TERM_LEN x1, TERM_LEN x2)
  */
 static void term_fresh_row_both(TERM_LEN y, int x1, int x2)
 {
-    auto &old_aa = game_term->old->a[y];
-    auto &old_cc = game_term->old->c[y];
+    auto *old_aa = game_term->old->a[y];
+    auto *old_cc = game_term->old->c[y];
 
-    const auto &scr_aa = game_term->scr->a[y];
-    const auto &scr_cc = game_term->scr->c[y];
+    const auto *scr_aa = game_term->scr->a[y];
+    const auto *scr_cc = game_term->scr->c[y];
 
-    auto &old_taa = game_term->old->ta[y];
-    auto &old_tcc = game_term->old->tc[y];
-    const auto &scr_taa = game_term->scr->ta[y];
-    const auto &scr_tcc = game_term->scr->tc[y];
+    auto *old_taa = game_term->old->ta[y];
+    auto *old_tcc = game_term->old->tc[y];
+    const auto *scr_taa = game_term->scr->ta[y];
+    const auto *scr_tcc = game_term->scr->tc[y];
 
     TERM_COLOR ota;
     char otc;
@@ -857,11 +942,11 @@ static void term_fresh_row_both(TERM_LEN y, int x1, int x2)
  */
 static void term_fresh_row_text(TERM_LEN y, TERM_LEN x1, TERM_LEN x2)
 {
-    auto &old_aa = game_term->old->a[y];
-    auto &old_cc = game_term->old->c[y];
+    auto *old_aa = game_term->old->a[y];
+    auto *old_cc = game_term->old->c[y];
 
-    const auto &scr_aa = game_term->scr->a[y];
-    const auto &scr_cc = game_term->scr->c[y];
+    const auto *scr_aa = game_term->scr->a[y];
+    const auto *scr_cc = game_term->scr->c[y];
 
     /* The "always_text" flag */
     int always_text = game_term->always_text;
@@ -1060,11 +1145,11 @@ errr term_fresh(void)
 
         /* Wipe each row */
         for (TERM_LEN y = 0; y < h; y++) {
-            auto &aa = old->a[y];
-            auto &cc = old->c[y];
+            auto *aa = old->a[y];
+            auto *cc = old->c[y];
 
-            auto &taa = old->ta[y];
-            auto &tcc = old->tc[y];
+            auto *taa = old->ta[y];
+            auto *tcc = old->tc[y];
 
             /* Wipe each column */
             for (TERM_LEN x = 0; x < w; x++) {
@@ -1099,11 +1184,11 @@ errr term_fresh(void)
             TERM_LEN tx = old->cx;
             TERM_LEN ty = old->cy;
 
-            const auto &old_aa = old->a[ty];
-            const auto &old_cc = old->c[ty];
+            const auto *old_aa = old->a[ty];
+            const auto *old_cc = old->c[ty];
 
-            const auto &old_taa = old->ta[ty];
-            const auto &old_tcc = old->tc[ty];
+            const auto *old_taa = old->ta[ty];
+            const auto *old_tcc = old->tc[ty];
 
             TERM_COLOR ota = old_taa[tx];
             char otc = old_tcc[tx];
@@ -1168,6 +1253,13 @@ errr term_fresh(void)
 
             /* Flush each "modified" row */
             if (x1 <= x2) {
+                /* Skip the row when nothing has actually changed */
+                if (!term_narrow_row_span(y, x1, x2)) {
+                    game_term->x1[y] = w;
+                    game_term->x2[y] = 0;
+                    continue;
+                }
+
                 /* Always use "term_pict()" */
                 if (game_term->always_pict) {
                     /* Flush the row */
@@ -1544,11 +1636,11 @@ errr term_erase(TERM_LEN x, TERM_LEN y, int n)
     }
 
     /* Fast access */
-    auto &scr_aa = game_term->scr->a[y];
-    auto &scr_cc = game_term->scr->c[y];
+    auto *scr_aa = game_term->scr->a[y];
+    auto *scr_cc = game_term->scr->c[y];
 
-    auto &scr_taa = game_term->scr->ta[y];
-    auto &scr_tcc = game_term->scr->tc[y];
+    auto *scr_taa = game_term->scr->ta[y];
+    auto *scr_tcc = game_term->scr->tc[y];
 
 #ifdef JP
     /*
@@ -1645,11 +1737,11 @@ errr term_clear(void)
 
     /* Wipe each row */
     for (TERM_LEN y = 0; y < h; y++) {
-        auto &scr_aa = game_term->scr->a[y];
-        auto &scr_cc = game_term->scr->c[y];
+        auto *scr_aa = game_term->scr->a[y];
+        auto *scr_cc = game_term->scr->c[y];
 
-        auto &scr_taa = game_term->scr->ta[y];
-        auto &scr_tcc = game_term->scr->tc[y];
+        auto *scr_taa = game_term->scr->ta[y];
+        auto *scr_tcc = game_term->scr->tc[y];
 
         /* Wipe each column */
         for (TERM_LEN x = 0; x < w; x++) {
@@ -1729,7 +1821,7 @@ errr term_redraw_section(TERM_LEN x1, TERM_LEN y1, TERM_LEN x2, TERM_LEN y2)
         game_term->x1[i] = x1j;
         game_term->x2[i] = x2j;
 
-        auto &g_ptr = game_term->old->c[i];
+        auto *g_ptr = game_term->old->c[i];
 
         /* Clear the section so it is redrawn */
         for (int j = x1j; j <= x2j; j++) {
@@ -1740,7 +1832,7 @@ errr term_redraw_section(TERM_LEN x1, TERM_LEN y1, TERM_LEN x2, TERM_LEN y2)
         game_term->x1[i] = x1;
         game_term->x2[i] = x2;
 
-        auto &g_ptr = game_term->old->c[i];
+        auto *g_ptr = game_term->old->c[i];
 
         /* Clear the section so it is redrawn */
         for (int j = x1; j <= x2; j++) {
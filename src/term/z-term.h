@@ -14,10 +14,69 @@
 #include "system/angband.h"
 #include "system/h-basic.h"
 
+#include <algorithm>
 #include <memory>
 #include <stack>
 #include <vector>
 
+/*!
+ * @brief 端末の1面 (属性または文字) を、行優先で1つの連続領域に格納する配列
+ * @details plane[y][x] で (x, y) の要素を参照する. 行の比較や複写は連続領域に対して行える.
+ */
+template <typename T>
+class TermPlane {
+public:
+    TermPlane(TERM_LEN w, TERM_LEN h)
+        : w(w)
+        , h(h)
+        , buf(static_cast<size_t>(w) * h)
+    {
+    }
+
+    T *operator[](TERM_LEN y)
+    {
+        return &this->buf[static_cast<size_t>(y) * this->w];
+    }
+
+    const T *operator[](TERM_LEN y) const
+    {
+        return &this->buf[static_cast<size_t>(y) * this->w];
+    }
+
+    TERM_LEN width() const
+    {
+        return this->w;
+    }
+
+    TERM_LEN height() const
+    {
+        return this->h;
+    }
+
+    /*!
+     * @brief 大きさを変える
+     * @details 新旧で重なる左上の領域の内容は保ち、広がった部分は0で埋める
+     */
+    void resize(TERM_LEN new_w, TERM_LEN new_h)
+    {
+        std::vector<T> new_buf(static_cast<size_t>(new_w) * new_h);
+        const auto copy_w = std::min(this->w, new_w);
+        const auto copy_h = std::min(this->h, new_h);
+        for (TERM_LEN y = 0; y < copy_h; y++) {
+            std::copy_n((*this)[y], copy_w, &new_buf[static_cast<size_t>(y) * new_w]);
+        }
+
+        this->w = new_w;
+        this->h = new_h;
+        this->buf = std::move(new_buf);
+    }
+
+private:
+    TERM_LEN w;
+    TERM_LEN h;
+    std::vector<T> buf;
+};
+
 /*!
  * @brief A term_win is a "window" for a Term
  */
@@ -30,11 +89,11 @@ public:
     bool cu{}, cv{}; //!< Cursor Useless / Visible codes
     TERM_LEN cx{}, cy{}; //!< Cursor Location (see "Useless")
 
-    std::vector<std::vector<TERM_COLOR>> a; //!< Array[h*w] -- Attribute array
-    std::vector<std::vector<char>> c; //!< Array[h*w] -- Character array
+    TermPlane<TERM_COLOR> a; //!< Array[h*w] -- Attribute array
+    TermPlane<char> c; //!< Array[h*w] -- Character array
 
-    std::vector<std::vector<TERM_COLOR>> ta; //!< Note that the attr pair at(x, y) is a[y][x]
-    std::vector<std::vector<char>> tc; //!< Note that the char pair at(x, y) is c[y][x]
+    TermPlane<TERM_COLOR> ta; //!< Note that the attr pair at(x, y) is a[y][x]
+    TermPlane<char> tc; //!< Note that the char pair at(x, y) is c[y][x]
 
 private:
     term_win(TERM_LEN w, TERM_LEN h);
@@ -0,0 +1,156 @@
+﻿#pragma once
+
+#include "term/z-rand.h"
+
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+/**
+ * @brief エイリアス法による抽選テーブルクラス
+ *
+ * 同じ確率分布から何度も抽選する場合に、1回の抽選を定数時間で行うためのテーブル。
+ * 構築には項目数に比例する時間がかかるが、抽選は乱数2回と配列参照のみで済む。
+ * 重みはすべて整数で扱うため、各項目が選択される確率は
+ * 項目の重み / すべての項目の重みの合計
+ * に厳密に一致する。
+ *
+ * @tparam IdType テーブルに登録するIDの型
+ */
+template <typename IdType>
+class AliasTable {
+public:
+    /**
+     * @brief コンストラクタ
+     *
+     * 空のテーブルを生成する
+     */
+    AliasTable() = default;
+
+    /**
+     * @brief テーブルを空にする
+     */
+    void clear()
+    {
+        ids_.clear();
+        weights_.clear();
+        thresholds_.clear();
+        aliases_.clear();
+        total_prob_ = 0;
+    }
+
+    /**
+     * @brief テーブルに項目を登録する
+     *
+     * probが0もしくは負数の場合はなにも登録しない。
+     * 登録後は build() を呼ぶまで抽選できない。
+     *
+     * @param id 項目のID
+     * @param prob 項目の選択確率
+     */
+    void entry_item(IdType id, int prob)
+    {
+        if (prob > 0) {
+            ids_.push_back(id);
+            weights_.push_back(prob);
+            total_prob_ += prob;
+        }
+    }
+
+    /**
+     * @brief 登録済みの項目から抽選用のテーブルを構築する
+     *
+     * Vose のエイリアス法に従い、各項目の重みを項目数倍して
+     * 容量 total_prob() の列に詰め直す。
+     */
+    void build()
+    {
+        const auto count = ids_.size();
+        thresholds_.assign(count, total_prob_);
+        aliases_.resize(count);
+        std::vector<int64_t> scaled(count);
+        std::vector<size_t> small;
+        std::vector<size_t> large;
+        for (size_t i = 0; i < count; i++) {
+            aliases_[i] = i;
+            scaled[i] = static_cast<int64_t>(weights_[i]) * static_cast<int64_t>(count);
+            (scaled[i] < total_prob_ ? small : large).push_back(i);
+        }
+
+        while (!small.empty() && !large.empty()) {
+            const auto less = small.back();
+            small.pop_back();
+            const auto more = large.back();
+            large.pop_back();
+            thresholds_[less] = static_cast<int>(scaled[less]);
+            aliases_[less] = more;
+            scaled[more] -= total_prob_ - scaled[less];
+            (scaled[more] < total_prob_ ? small : large).push_back(more);
+        }
+    }
+
+    /**
+     * @brief すべての項目の選択確率の合計を取得する
+     *
+     * @return int すべての項目の選択確率の合計
+     */
+    int total_prob() const
+    {
+        return total_prob_;
+    }
+
+    /**
+     * @brief 登録されている項目の数を取得する
+     *
+     * @return size_t 登録されている項目の数
+     */
+    size_t item_count() const
+    {
+        return ids_.size();
+    }
+
+    /**
+     * @brief テーブルの項目が空かどうかを調べる
+     *
+     * @return bool 項目が一つも登録されておらず空であれば true
+     */
+    bool empty() const
+    {
+        return ids_.empty();
+    }
+
+    /**
+     * @brief テーブルから項目をランダムに1つ選択する
+     *
+     * 列をランダムに1つ選び、その列の閾値と乱数を比べて列自身かその別名を返す。
+     * テーブルになにも登録されていない場合、std::runtime_error例外を送出する。
+     *
+     * @return IdType 選択された項目のID
+     */
+    IdType pick_one_at_random() const
+    {
+        if (empty()) {
+            throw std::runtime_error("There is no entry in the alias table.");
+        }
+
+        const auto column = static_cast<size_t>(randint0(static_cast<int>(ids_.size())));
+        const auto key = randint0(total_prob_);
+        return ids_[key < thresholds_[column] ? column : aliases_[column]];
+    }
+
+private:
+    /** 項目のID */
+    std::vector<IdType> ids_;
+
+    /** 項目の重み */
+    std::vector<int> weights_;
+
+    /** 各列で自身を選ぶ閾値 (0～total_prob_) */
+    std::vector<int> thresholds_;
+
+    /** 各列の別名となる項目の位置 */
+    std::vector<size_t> aliases_;
+
+    /** 重みの合計 */
+    int total_prob_ = 0;
+};
@@ -263,7 +263,8 @@ errr angband_fgets(FILE *fff, char *buf, ulong n)
     // Reserve for null termination
     --n;
 
-    std::vector<char> file_read__tmp(FILE_READ_BUFF_SIZE);
+    // 行毎に確保し直すと定義ファイルの読み込みで時間が掛かるため、スレッド毎に使い回す
+    thread_local std::vector<char> file_read__tmp(FILE_READ_BUFF_SIZE);
     if (fgets(file_read__tmp.data(), file_read__tmp.size(), fff)) {
 #ifdef JP
         guess_convert_to_system_encoding(file_read__tmp.data(), FILE_READ_BUFF_SIZE);
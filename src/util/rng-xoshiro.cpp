@@ -65,6 +65,36 @@ Xoshiro128StarStar::result_type Xoshiro128StarStar::operator()()
     return result;
 }
 
+/*!
+ * @brief [0,range) の一様乱数を生成する
+ * @details
+ * Lemire の乗算とシフトによる方法 (Fast Random Integer Generation in an Interval, https://arxiv.org/abs/1805.10941) で、
+ * 除算は棄却が起こり得る場合にだけ行う。
+ * libstdc++ の std::uniform_int_distribution が32ビットの乱数生成器に対して行う計算と同一であるため、
+ * 同じ内部状態からは従来と同じ乱数列が得られる。
+ * 他の標準ライブラリでは値が異なりうるため、シードから再生成する内容には使わない (Rand_set_legacy_mapping() 参照)。
+ * @param range 乱数の取り得る値の数 (0の場合は32ビット全域)
+ * @return 生成した乱数
+ */
+Xoshiro128StarStar::result_type Xoshiro128StarStar::bounded(result_type range)
+{
+    if (range == 0) {
+        return (*this)();
+    }
+
+    auto product = static_cast<uint64_t>((*this)()) * range;
+    auto low = static_cast<uint32_t>(product);
+    if (low < range) {
+        const auto threshold = static_cast<uint32_t>(-range) % range;
+        while (low < threshold) {
+            product = static_cast<uint64_t>((*this)()) * range;
+            low = static_cast<uint32_t>(product);
+        }
+    }
+
+    return static_cast<result_type>(product >> 32);
+}
+
 /*!
  * @brief 乱数の内部状態をセットする
  *
@@ -33,6 +33,23 @@ public:
     }
 
     result_type operator()();
+    result_type bounded(result_type range);
+
+    /*!
+     * @brief 範囲 [first,last) を [0,range) の一様乱数で埋める
+     * @details 要素の先頭から順に bounded() を呼んだ場合と同じ乱数列になる
+     * @tparam OutputIt 出力イテレータの型
+     * @param first 範囲の先頭を指すイテレータ
+     * @param last 範囲の終端を指すイテレータ
+     * @param range 乱数の取り得る値の数 (0の場合は32ビット全域)
+     */
+    template <typename OutputIt>
+    void fill(OutputIt first, OutputIt last, result_type range)
+    {
+        for (; first != last; ++first) {
+            *first = this->bounded(range);
+        }
+    }
 
     void set_state(uint32_t seed);
 
@@ -13,142 +13,52 @@
 #include "system/player-type-definition.h"
 #include "system/terrain-type-definition.h"
 
-/*
- * @brief クイックソートの実行 / Quick sort in place
- * @param u アイテムやモンスター等への配列
- * @param v 条件基準IDへの参照ポインタ
- * @param a 比較対象のID1
- * @param b 比較対象のID2
- * @param ang_sort_comp 比較用の関数ポインタ
- * @param ang_sort_swap スワップ用の関数ポインタ
- */
-static void exe_ang_sort(PlayerType *player_ptr, vptr u, vptr v, int p, int q, bool (*ang_sort_comp)(PlayerType *, vptr, vptr, int, int),
-    void (*ang_sort_swap)(PlayerType *, vptr, vptr, int, int))
-{
-    if (p >= q) {
-        return;
-    }
-
-    int z = p;
-    int a = p;
-    int b = q;
-    while (true) {
-        /* Slide i2 */
-        while (!(*ang_sort_comp)(player_ptr, u, v, b, z)) {
-            b--;
-        }
-
-        /* Slide i1 */
-        while (!(*ang_sort_comp)(player_ptr, u, v, z, a)) {
-            a++;
-        }
-
-        if (a >= b) {
-            break;
-        }
-
-        (*ang_sort_swap)(player_ptr, u, v, a, b);
-
-        a++, b--;
-    }
-
-    /* Recurse left side */
-    exe_ang_sort(player_ptr, u, v, p, b, ang_sort_comp, ang_sort_swap);
-
-    /* Recurse right side */
-    exe_ang_sort(player_ptr, u, v, b + 1, q, ang_sort_comp, ang_sort_swap);
-}
-
-/*
- * @brief クイックソートの受け付け / Accepting auick sort in place
- * @param u アイテムやモンスター等への配列
- * @param v 条件基準IDへの参照ポインタ
- * @param a 比較対象のID1
- * @param b 比較対象のID2
- * @param ang_sort_comp 比較用の関数ポインタ
- * @param ang_sort_swap スワップ用の関数ポインタ
+/*!
+ * @brief プレイヤーからの近似距離(の2倍)を返す
+ * @param player_ptr プレイヤーへの参照ポインタ
+ * @param pos 座標
+ * @return 近似距離の2倍
  */
-void ang_sort(PlayerType *player_ptr, vptr u, vptr v, int n, bool (*ang_sort_comp)(PlayerType *, vptr, vptr, int, int),
-    void (*ang_sort_swap)(PlayerType *, vptr, vptr, int, int))
+static POSITION double_distance_to_player(const PlayerType *player_ptr, const Pos2D &pos)
 {
-    exe_ang_sort(player_ptr, u, v, 0, n - 1, ang_sort_comp, ang_sort_swap);
+    const auto kx = std::abs(pos.x - player_ptr->x);
+    const auto ky = std::abs(pos.y - player_ptr->y);
+    return (kx > ky) ? (kx + kx + ky) : (ky + ky + kx);
 }
 
 /*
  * Sorting hook -- comp function -- by "distance to player"
  *
- * We use "u" and "v" to point to arrays of "x" and "y" positions,
- * and sort the arrays by double-distance to the player.
+ * Sort the positions by double-distance to the player.
  */
-bool ang_sort_comp_distance(PlayerType *player_ptr, vptr u, vptr v, int a, int b)
+bool ang_sort_comp_distance(const PlayerType *player_ptr, const Pos2D &pos1, const Pos2D &pos2)
 {
-    POSITION *x = (POSITION *)(u);
-    POSITION *y = (POSITION *)(v);
-
-    /* Absolute distance components */
-    POSITION kx = x[a];
-    kx -= player_ptr->x;
-    kx = std::abs(kx);
-    POSITION ky = y[a];
-    ky -= player_ptr->y;
-    ky = std::abs(ky);
-
-    /* Approximate Double Distance to the first point */
-    POSITION da = ((kx > ky) ? (kx + kx + ky) : (ky + ky + kx));
-
-    /* Absolute distance components */
-    kx = x[b];
-    kx -= player_ptr->x;
-    kx = std::abs(kx);
-    ky = y[b];
-    ky -= player_ptr->y;
-    ky = std::abs(ky);
-
-    /* Approximate Double Distance to the first point */
-    POSITION db = ((kx > ky) ? (kx + kx + ky) : (ky + ky + kx));
-
-    /* Compare the distances */
-    return da <= db;
+    return double_distance_to_player(player_ptr, pos1) < double_distance_to_player(player_ptr, pos2);
 }
 
 /*
  * Sorting hook -- comp function -- by importance level of grids
  *
- * We use "u" and "v" to point to arrays of "x" and "y" positions,
- * and sort the arrays by level of monster
+ * Sort the positions by level of monster
  */
-bool ang_sort_comp_importance(PlayerType *player_ptr, vptr u, vptr v, int a, int b)
+bool ang_sort_comp_importance(PlayerType *player_ptr, const Pos2D &pos1, const Pos2D &pos2)
 {
-    POSITION *x = (POSITION *)(u);
-    POSITION *y = (POSITION *)(v);
-    grid_type *ca_ptr = &player_ptr->current_floor_ptr->grid_array[y[a]][x[a]];
-    grid_type *cb_ptr = &player_ptr->current_floor_ptr->grid_array[y[b]][x[b]];
-    MonsterEntity *ma_ptr = &player_ptr->current_floor_ptr->m_list[ca_ptr->m_idx];
-    MonsterEntity *mb_ptr = &player_ptr->current_floor_ptr->m_list[cb_ptr->m_idx];
-    MonsterRaceInfo *ap_ra_ptr, *ap_rb_ptr;
+    auto *floor_ptr = player_ptr->current_floor_ptr;
+    const auto &ca_ref = floor_ptr->grid_array[pos1.y][pos1.x];
+    const auto &cb_ref = floor_ptr->grid_array[pos2.y][pos2.x];
+    const auto &ma_ref = floor_ptr->m_list[ca_ref.m_idx];
+    const auto &mb_ref = floor_ptr->m_list[cb_ref.m_idx];
 
     /* The player grid */
-    if (y[a] == player_ptr->y && x[a] == player_ptr->x) {
-        return true;
-    }
-
-    if (y[b] == player_ptr->y && x[b] == player_ptr->x) {
-        return false;
+    const auto is_player_a = (pos1.y == player_ptr->y) && (pos1.x == player_ptr->x);
+    const auto is_player_b = (pos2.y == player_ptr->y) && (pos2.x == player_ptr->x);
+    if (is_player_a || is_player_b) {
+        return is_player_a && !is_player_b;
     }
 
     /* Extract monster race */
-    if (ca_ptr->m_idx && ma_ptr->ml) {
-        ap_ra_ptr = &monraces_info[ma_ptr->ap_r_idx];
-    } else {
-        ap_ra_ptr = nullptr;
-    }
-
-    if (cb_ptr->m_idx && mb_ptr->ml) {
-        ap_rb_ptr = &monraces_info[mb_ptr->ap_r_idx];
-    } else {
-        ap_rb_ptr = nullptr;
-    }
-
+    const auto *ap_ra_ptr = (ca_ref.m_idx && ma_ref.ml) ? &monraces_info[ma_ref.ap_r_idx] : nullptr;
+    const auto *ap_rb_ptr = (cb_ref.m_idx && mb_ref.ml) ? &monraces_info[mb_ref.ap_r_idx] : nullptr;
     if (ap_ra_ptr && !ap_rb_ptr) {
         return true;
     }
@@ -168,10 +78,10 @@ bool ang_sort_comp_importance(PlayerType *player_ptr, vptr u, vptr v, int a, int
         }
 
         /* Shadowers first (あやしい影) */
-        if (ma_ptr->mflag2.has(MonsterConstantFlagType::KAGE) && mb_ptr->mflag2.has_not(MonsterConstantFlagType::KAGE)) {
+        if (ma_ref.mflag2.has(MonsterConstantFlagType::KAGE) && mb_ref.mflag2.has_not(MonsterConstantFlagType::KAGE)) {
             return true;
         }
-        if (ma_ptr->mflag2.has_not(MonsterConstantFlagType::KAGE) && mb_ptr->mflag2.has(MonsterConstantFlagType::KAGE)) {
+        if (ma_ref.mflag2.has_not(MonsterConstantFlagType::KAGE) && mb_ref.mflag2.has(MonsterConstantFlagType::KAGE)) {
             return false;
         }
 
@@ -194,494 +104,250 @@ bool ang_sort_comp_importance(PlayerType *player_ptr, vptr u, vptr v, int a, int
         }
 
         /* Sort by index if all conditions are same */
-        if (ma_ptr->ap_r_idx > mb_ptr->ap_r_idx) {
+        if (ma_ref.ap_r_idx > mb_ref.ap_r_idx) {
             return true;
         }
-        if (ma_ptr->ap_r_idx < mb_ptr->ap_r_idx) {
+        if (ma_ref.ap_r_idx < mb_ref.ap_r_idx) {
             return false;
         }
     }
 
     /* An object get higher priority */
-    if (!player_ptr->current_floor_ptr->grid_array[y[a]][x[a]].o_idx_list.empty() && player_ptr->current_floor_ptr->grid_array[y[b]][x[b]].o_idx_list.empty()) {
+    const auto &ca_items = floor_ptr->grid_array.o_idx_list(pos1.y, pos1.x);
+    const auto &cb_items = floor_ptr->grid_array.o_idx_list(pos2.y, pos2.x);
+    if (!ca_items.empty() && cb_items.empty()) {
         return true;
     }
 
-    if (player_ptr->current_floor_ptr->grid_array[y[a]][x[a]].o_idx_list.empty() && !player_ptr->current_floor_ptr->grid_array[y[b]][x[b]].o_idx_list.empty()) {
+    if (ca_items.empty() && !cb_items.empty()) {
         return false;
     }
 
     /* Priority from the terrain */
-    if (terrains_info[ca_ptr->feat].priority > terrains_info[cb_ptr->feat].priority) {
+    if (terrains_info[ca_ref.feat].priority > terrains_info[cb_ref.feat].priority) {
         return true;
     }
 
-    if (terrains_info[ca_ptr->feat].priority < terrains_info[cb_ptr->feat].priority) {
+    if (terrains_info[ca_ref.feat].priority < terrains_info[cb_ref.feat].priority) {
         return false;
     }
 
     /* If all conditions are same, compare distance */
-    return ang_sort_comp_distance(player_ptr, u, v, a, b);
+    return ang_sort_comp_distance(player_ptr, pos1, pos2);
 }
 
-/*
- * Sorting hook -- swap function -- by "distance to player"
- *
- * We use "u" and "v" to point to arrays of "x" and "y" positions,
- * and sort the arrays by distance to the player.
- */
-void ang_sort_swap_position(PlayerType *player_ptr, vptr u, vptr v, int a, int b)
-{
-    /* Unused */
-    (void)player_ptr;
-
-    POSITION *x = (POSITION *)(u);
-    POSITION *y = (POSITION *)(v);
-
-    POSITION temp = x[a];
-    x[a] = x[b];
-    x[b] = temp;
-
-    temp = y[a];
-    y[a] = y[b];
-    y[b] = temp;
-}
-
-/*
- * Sorting hook -- Comp function -- see below
- *
- * We use "u" to point to array of monster indexes,
- * and "v" to select the type of sorting to perform on "u".
+/*!
+ * @brief 固定アーティファクトを特定の基準によりソートするための比較処理
+ * @param id1 比較する固定アーティファクトのID1
+ * @param id2 比較する固定アーティファクトのID2
+ * @param why 条件基準 (1:レベル、2:sval、3:tvalの順で比較項目が増える)
+ * @return id1が先に来るべきならTRUE
  */
-bool ang_sort_art_comp(PlayerType *player_ptr, vptr u, vptr v, int a, int b)
+bool ang_sort_art_comp(FixedArtifactId id1, FixedArtifactId id2, uint16_t why)
 {
-    /* Unused */
-    (void)player_ptr;
-
-    uint16_t *who = (uint16_t *)(u);
-    uint16_t *why = (uint16_t *)(v);
-
-    const auto w1 = i2enum<FixedArtifactId>(who[a]);
-    const auto w2 = i2enum<FixedArtifactId>(who[b]);
-
-    int z1;
-    int z2;
-
-    /* Sort by total kills */
-    if (*why >= 3) {
-        /* Extract total kills */
-        z1 = enum2i(artifacts_info.at(w1).bi_key.tval());
-        z2 = enum2i(artifacts_info.at(w2).bi_key.tval());
-
-        /* Compare total kills */
-        if (z1 < z2) {
-            return true;
-        }
-
-        if (z1 > z2) {
-            return false;
+    const auto &artifact1 = artifacts_info.at(id1);
+    const auto &artifact2 = artifacts_info.at(id2);
+
+    /* Sort by tval */
+    if (why >= 3) {
+        const auto z1 = enum2i(artifact1.bi_key.tval());
+        const auto z2 = enum2i(artifact2.bi_key.tval());
+        if (z1 != z2) {
+            return z1 < z2;
         }
     }
 
-    /* Sort by monster level */
-    if (*why >= 2) {
-        /* Extract levels */
-        z1 = artifacts_info.at(w1).bi_key.sval().value();
-        z2 = artifacts_info.at(w2).bi_key.sval().value();
-
-        /* Compare levels */
-        if (z1 < z2) {
-            return true;
-        }
-
-        if (z1 > z2) {
-            return false;
+    /* Sort by sval */
+    if (why >= 2) {
+        const auto z1 = artifact1.bi_key.sval().value();
+        const auto z2 = artifact2.bi_key.sval().value();
+        if (z1 != z2) {
+            return z1 < z2;
         }
     }
 
-    /* Sort by monster experience */
-    if (*why >= 1) {
-        /* Extract experience */
-        z1 = artifacts_info.at(w1).level;
-        z2 = artifacts_info.at(w2).level;
-
-        /* Compare experience */
-        if (z1 < z2) {
-            return true;
-        }
-
-        if (z1 > z2) {
-            return false;
+    /* Sort by level */
+    if (why >= 1) {
+        if (artifact1.level != artifact2.level) {
+            return artifact1.level < artifact2.level;
         }
     }
 
     /* Compare indexes */
-    return w1 <= w2;
+    return id1 < id2;
 }
 
-/*
- * Sorting hook -- Swap function -- see below
- *
- * We use "u" to point to array of monster indexes,
- * and "v" to select the type of sorting to perform.
+/*!
+ * @brief クエストを達成時刻とレベルで並べるための比較処理
+ * @param id1 比較するクエストのID1
+ * @param id2 比較するクエストのID2
+ * @return id1が先に来るべきならTRUE
  */
-void ang_sort_art_swap(PlayerType *player_ptr, vptr u, vptr v, int a, int b)
-{
-    /* Unused */
-    (void)player_ptr;
-    (void)v;
-
-    uint16_t *who = (uint16_t *)(u);
-    uint16_t holder = who[a];
-    who[a] = who[b];
-    who[b] = holder;
-}
-
-bool ang_sort_comp_quest_num(PlayerType *player_ptr, vptr u, vptr v, int a, int b)
+bool ang_sort_comp_quest_num(QuestId id1, QuestId id2)
 {
-    /* Unused */
-    (void)player_ptr;
-    (void)v;
-
     const auto &quest_list = QuestList::get_instance();
-    QuestId *q_num = (QuestId *)u;
-    const auto *qa = &quest_list[q_num[a]];
-    const auto *qb = &quest_list[q_num[b]];
-    return (qa->comptime != qb->comptime) ? (qa->comptime < qb->comptime) : (qa->level <= qb->level);
-}
+    const auto &qa = quest_list[id1];
+    const auto &qb = quest_list[id2];
+    if (qa.comptime != qb.comptime) {
+        return qa.comptime < qb.comptime;
+    }
 
-void ang_sort_swap_quest_num(PlayerType *player_ptr, vptr u, vptr v, int a, int b)
-{
-    /* Unused */
-    (void)player_ptr;
-    (void)v;
-
-    QuestId *q_num = (QuestId *)u;
-    QuestId tmp = q_num[a];
-    q_num[a] = q_num[b];
-    q_num[b] = tmp;
+    if (qa.level != qb.level) {
+        return qa.level < qb.level;
+    }
+
+    return id1 < id2;
 }
 
 /*!
  * @brief ペット入りモンスターボールをソートするための比較関数
- * @param u 所持品配列の参照ポインタ
- * @param v 未使用
- * @param a 所持品ID1
- * @param b 所持品ID2
- * @return 1の方が大であればTRUE
+ * @param player_ptr プレイヤーへの参照ポインタ
+ * @param m_idx1 モンスターID1
+ * @param m_idx2 モンスターID2
+ * @return m_idx1が先に来るべきならTRUE
  */
-bool ang_sort_comp_pet(PlayerType *player_ptr, vptr u, vptr v, int a, int b)
+bool ang_sort_comp_pet(PlayerType *player_ptr, MONSTER_IDX m_idx1, MONSTER_IDX m_idx2)
 {
-    /* Unused */
-    (void)v;
-
-    uint16_t *who = (uint16_t *)(u);
-
-    int w1 = who[a];
-    int w2 = who[b];
-
-    MonsterEntity *m_ptr1 = &player_ptr->current_floor_ptr->m_list[w1];
-    MonsterEntity *m_ptr2 = &player_ptr->current_floor_ptr->m_list[w2];
-    MonsterRaceInfo *r_ptr1 = &monraces_info[m_ptr1->r_idx];
-    MonsterRaceInfo *r_ptr2 = &monraces_info[m_ptr2->r_idx];
+    const auto &m_ref1 = player_ptr->current_floor_ptr->m_list[m_idx1];
+    const auto &m_ref2 = player_ptr->current_floor_ptr->m_list[m_idx2];
+    const auto &r_ref1 = monraces_info[m_ref1.r_idx];
+    const auto &r_ref2 = monraces_info[m_ref2.r_idx];
 
-    if (m_ptr1->nickname && !m_ptr2->nickname) {
+    if (m_ref1.nickname && !m_ref2.nickname) {
         return true;
     }
 
-    if (m_ptr2->nickname && !m_ptr1->nickname) {
+    if (m_ref2.nickname && !m_ref1.nickname) {
         return false;
     }
 
-    if (r_ptr1->kind_flags.has(MonsterKindType::UNIQUE) && r_ptr2->kind_flags.has_not(MonsterKindType::UNIQUE)) {
+    if (r_ref1.kind_flags.has(MonsterKindType::UNIQUE) && r_ref2.kind_flags.has_not(MonsterKindType::UNIQUE)) {
         return true;
     }
 
-    if (r_ptr2->kind_flags.has(MonsterKindType::UNIQUE) && r_ptr1->kind_flags.has_not(MonsterKindType::UNIQUE)) {
+    if (r_ref2.kind_flags.has(MonsterKindType::UNIQUE) && r_ref1.kind_flags.has_not(MonsterKindType::UNIQUE)) {
         return false;
     }
 
-    if (r_ptr1->level > r_ptr2->level) {
-        return true;
-    }
-
-    if (r_ptr2->level > r_ptr1->level) {
-        return false;
-    }
-
-    if (m_ptr1->hp > m_ptr2->hp) {
-        return true;
+    if (r_ref1.level != r_ref2.level) {
+        return r_ref1.level > r_ref2.level;
     }
 
-    if (m_ptr2->hp > m_ptr1->hp) {
-        return false;
+    if (m_ref1.hp != m_ref2.hp) {
+        return m_ref1.hp > m_ref2.hp;
     }
 
-    return w1 <= w2;
+    return m_idx1 < m_idx2;
 }
 
 /*!
  * @brief モンスター種族情報を特定の基準によりソートするための比較処理
- * Sorting hook -- Comp function -- see below
- * @param u モンスター種族情報の入れるポインタ
- * @param v 条件基準ID
- * @param a 比較するモンスター種族のID1
- * @param b 比較するモンスター種族のID2
- * @return 2の方が大きければTRUEを返す
- * We use "u" to point to array of monster indexes,
- * and "v" to select the type of sorting to perform on "u".
+ * @param r_idx1 比較するモンスター種族のID1
+ * @param r_idx2 比較するモンスター種族のID2
+ * @param why 条件基準 (1:経験値、2:レベル、3:総撃破数、4:プレイヤーの撃破数の順で比較項目が増える)
+ * @return r_idx1が先に来るべきならTRUE
  */
-bool ang_sort_comp_hook(PlayerType *player_ptr, vptr u, vptr v, int a, int b)
+bool ang_sort_comp_hook(MonsterRaceId r_idx1, MonsterRaceId r_idx2, uint16_t why)
 {
-    /* Unused */
-    (void)player_ptr;
-
-    MonsterRaceId *who = (MonsterRaceId *)(u);
-    uint16_t *why = (uint16_t *)(v);
-
-    auto w1 = who[a];
-    auto w2 = who[b];
-
-    int z1, z2;
+    const auto &r_ref1 = monraces_info[r_idx1];
+    const auto &r_ref2 = monraces_info[r_idx2];
 
     /* Sort by player kills */
-    if (*why >= 4) {
-        /* Extract player kills */
-        z1 = monraces_info[w1].r_pkills;
-        z2 = monraces_info[w2].r_pkills;
-
-        /* Compare player kills */
-        if (z1 < z2) {
-            return true;
-        }
-        if (z1 > z2) {
-            return false;
-        }
+    if ((why >= 4) && (r_ref1.r_pkills != r_ref2.r_pkills)) {
+        return r_ref1.r_pkills < r_ref2.r_pkills;
     }
 
     /* Sort by total kills */
-    if (*why >= 3) {
-        /* Extract total kills */
-        z1 = monraces_info[w1].r_tkills;
-        z2 = monraces_info[w2].r_tkills;
-
-        /* Compare total kills */
-        if (z1 < z2) {
-            return true;
-        }
-        if (z1 > z2) {
-            return false;
-        }
+    if ((why >= 3) && (r_ref1.r_tkills != r_ref2.r_tkills)) {
+        return r_ref1.r_tkills < r_ref2.r_tkills;
     }
 
     /* Sort by monster level */
-    if (*why >= 2) {
-        /* Extract levels */
-        z1 = monraces_info[w1].level;
-        z2 = monraces_info[w2].level;
-
-        /* Compare levels */
-        if (z1 < z2) {
-            return true;
-        }
-        if (z1 > z2) {
-            return false;
-        }
+    if ((why >= 2) && (r_ref1.level != r_ref2.level)) {
+        return r_ref1.level < r_ref2.level;
     }
 
     /* Sort by monster experience */
-    if (*why >= 1) {
-        /* Extract experience */
-        z1 = monraces_info[w1].mexp;
-        z2 = monraces_info[w2].mexp;
-
-        /* Compare experience */
-        if (z1 < z2) {
-            return true;
-        }
-        if (z1 > z2) {
-            return false;
-        }
+    if ((why >= 1) && (r_ref1.mexp != r_ref2.mexp)) {
+        return r_ref1.mexp < r_ref2.mexp;
     }
 
     /* Compare indexes */
-    return w1 <= w2;
-}
-
-/*!
- * @brief モンスター種族情報を特定の基準によりソートするためのスワップ処理
- * Sorting hook -- Swap function -- see below
- * @param u モンスター種族情報の入れるポインタ
- * @param v 未使用
- * @param a スワップするモンスター種族のID1
- * @param b スワップするモンスター種族のID2
- * @details
- * We use "u" to point to array of monster indexes,
- * and "v" to select the type of sorting to perform.
- */
-void ang_sort_swap_hook(PlayerType *player_ptr, vptr u, vptr v, int a, int b)
-{
-    /* Unused */
-    (void)player_ptr;
-    (void)v;
-
-    uint16_t *who = (uint16_t *)(u);
-    uint16_t holder;
-
-    holder = who[a];
-    who[a] = who[b];
-    who[b] = holder;
+    return r_idx1 < r_idx2;
 }
 
 /*
  * hook function to sort monsters by level
  */
-bool ang_sort_comp_monster_level(PlayerType *player_ptr, vptr u, vptr v, int a, int b)
+bool ang_sort_comp_monster_level(MonsterRaceId r_idx1, MonsterRaceId r_idx2)
 {
-    /* Unused */
-    (void)player_ptr;
-    (void)v;
+    const auto &r_ref1 = monraces_info[r_idx1];
+    const auto &r_ref2 = monraces_info[r_idx2];
 
-    MonsterRaceId *who = (MonsterRaceId *)(u);
-
-    auto w1 = who[a];
-    auto w2 = who[b];
-
-    MonsterRaceInfo *r_ptr1 = &monraces_info[w1];
-    MonsterRaceInfo *r_ptr2 = &monraces_info[w2];
-
-    if (r_ptr2->level > r_ptr1->level) {
-        return true;
-    }
-
-    if (r_ptr1->level > r_ptr2->level) {
-        return false;
+    if (r_ref1.level != r_ref2.level) {
+        return r_ref1.level < r_ref2.level;
     }
 
-    if (r_ptr2->kind_flags.has(MonsterKindType::UNIQUE) && r_ptr1->kind_flags.has_not(MonsterKindType::UNIQUE)) {
+    if (r_ref2.kind_flags.has(MonsterKindType::UNIQUE) && r_ref1.kind_flags.has_not(MonsterKindType::UNIQUE)) {
         return true;
     }
 
-    if (r_ptr1->kind_flags.has(MonsterKindType::UNIQUE) && r_ptr2->kind_flags.has_not(MonsterKindType::UNIQUE)) {
+    if (r_ref1.kind_flags.has(MonsterKindType::UNIQUE) && r_ref2.kind_flags.has_not(MonsterKindType::UNIQUE)) {
         return false;
     }
 
-    return w1 <= w2;
+    return r_idx1 < r_idx2;
 }
 
 /*!
  * @brief ペットになっているモンスターをソートするための比較処理
- * @param u モンスターの構造体配列
- * @param v 未使用
- * @param a 比較対象のモンスターID1
- * @param b 比較対象のモンスターID2
- * @return 2番目が大ならばTRUEを返す
+ * @param player_ptr プレイヤーへの参照ポインタ
+ * @param m_idx1 比較対象のモンスターID1
+ * @param m_idx2 比較対象のモンスターID2
+ * @return m_idx1が先に来るべきならTRUE
  */
-bool ang_sort_comp_pet_dismiss(PlayerType *player_ptr, vptr u, vptr v, int a, int b)
+bool ang_sort_comp_pet_dismiss(PlayerType *player_ptr, MONSTER_IDX m_idx1, MONSTER_IDX m_idx2)
 {
-    /* Unused */
-    (void)v;
-
-    uint16_t *who = (uint16_t *)(u);
-
-    int w1 = who[a];
-    int w2 = who[b];
-
-    MonsterEntity *m_ptr1 = &player_ptr->current_floor_ptr->m_list[w1];
-    MonsterEntity *m_ptr2 = &player_ptr->current_floor_ptr->m_list[w2];
-    MonsterRaceInfo *r_ptr1 = &monraces_info[m_ptr1->r_idx];
-    MonsterRaceInfo *r_ptr2 = &monraces_info[m_ptr2->r_idx];
+    const auto &m_ref1 = player_ptr->current_floor_ptr->m_list[m_idx1];
+    const auto &m_ref2 = player_ptr->current_floor_ptr->m_list[m_idx2];
+    const auto &r_ref1 = monraces_info[m_ref1.r_idx];
+    const auto &r_ref2 = monraces_info[m_ref2.r_idx];
 
-    if (w1 == player_ptr->riding) {
-        return true;
+    if ((m_idx1 == player_ptr->riding) || (m_idx2 == player_ptr->riding)) {
+        return (m_idx1 == player_ptr->riding) && (m_idx2 != player_ptr->riding);
     }
 
-    if (w2 == player_ptr->riding) {
-        return false;
-    }
-
-    if (m_ptr1->nickname && !m_ptr2->nickname) {
+    if (m_ref1.nickname && !m_ref2.nickname) {
         return true;
     }
 
-    if (m_ptr2->nickname && !m_ptr1->nickname) {
+    if (m_ref2.nickname && !m_ref1.nickname) {
         return false;
     }
 
-    if (!m_ptr1->parent_m_idx && m_ptr2->parent_m_idx) {
+    if (!m_ref1.parent_m_idx && m_ref2.parent_m_idx) {
         return true;
     }
 
-    if (!m_ptr2->parent_m_idx && m_ptr1->parent_m_idx) {
+    if (!m_ref2.parent_m_idx && m_ref1.parent_m_idx) {
         return false;
     }
 
-    if (r_ptr1->kind_flags.has(MonsterKindType::UNIQUE) && r_ptr2->kind_flags.has_not(MonsterKindType::UNIQUE)) {
+    if (r_ref1.kind_flags.has(MonsterKindType::UNIQUE) && r_ref2.kind_flags.has_not(MonsterKindType::UNIQUE)) {
         return true;
     }
 
-    if (r_ptr2->kind_flags.has(MonsterKindType::UNIQUE) && r_ptr1->kind_flags.has_not(MonsterKindType::UNIQUE)) {
+    if (r_ref2.kind_flags.has(MonsterKindType::UNIQUE) && r_ref1.kind_flags.has_not(MonsterKindType::UNIQUE)) {
         return false;
     }
 
-    if (r_ptr1->level > r_ptr2->level) {
-        return true;
+    if (r_ref1.level != r_ref2.level) {
+        return r_ref1.level > r_ref2.level;
     }
 
-    if (r_ptr2->level > r_ptr1->level) {
-        return false;
-    }
-
-    if (m_ptr1->hp > m_ptr2->hp) {
-        return true;
+    if (m_ref1.hp != m_ref2.hp) {
+        return m_ref1.hp > m_ref2.hp;
     }
 
-    if (m_ptr2->hp > m_ptr1->hp) {
-        return false;
-    }
-
-    return w1 <= w2;
-}
-
-/*!
- * @brief フロア保存時のgrid情報テンプレートをソートするための比較処理
- * @param u gridテンプレートの参照ポインタ
- * @param v 未使用
- * @param a スワップするモンスター種族のID1
- * @param b スワップするモンスター種族のID2
- * @return aの方が大きければtrue
- */
-bool ang_sort_comp_cave_temp(PlayerType *player_ptr, vptr u, vptr v, int a, int b)
-{
-    /* Unused */
-    (void)player_ptr;
-    (void)v;
-
-    grid_template_type *who = (grid_template_type *)(u);
-
-    uint16_t o1 = who[a].occurrence;
-    uint16_t o2 = who[b].occurrence;
-
-    return o2 <= o1;
-}
-
-/*!
- * @brief フロア保存時のgrid情報テンプレートをソートするためのスワップ処理 / Sorting hook -- Swap function
- * @param u gridテンプレートの参照ポインタ
- * @param v 未使用
- * @param a スワップするモンスター種族のID1
- * @param b スワップするモンスター種族のID2
- */
-void ang_sort_swap_cave_temp(PlayerType *player_ptr, vptr u, vptr v, int a, int b)
-{
-    /* Unused */
-    (void)player_ptr;
-    (void)v;
-
-    grid_template_type *who = (grid_template_type *)(u);
-    grid_template_type holder;
-
-    holder = who[a];
-    who[a] = who[b];
-    who[b] = holder;
+    return m_idx1 < m_idx2;
 }
@@ -1,28 +1,94 @@
 ﻿#pragma once
 
 #include "system/angband.h"
+#include "util/point-2d.h"
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <vector>
 
-#include "system/player-type-definition.h"
-void ang_sort(PlayerType *player_ptr, vptr u, vptr v, int n, bool (*ang_sort_comp)(PlayerType *, vptr, vptr, int, int),
-    void (*ang_sort_swap)(PlayerType *, vptr, vptr, int, int));
+/*!
+ * @brief 範囲全体を比較関数でソートする (イントロソート、最悪でもO(n log n))
+ * @param range ソート対象のコンテナや配列
+ * @param comp 厳密な弱順序を満たす比較関数 (前に来るべきならtrue)
+ */
+template <typename Range, typename Compare>
+void ang_sort(Range &range, Compare comp)
+{
+    std::sort(std::begin(range), std::end(range), comp);
+}
 
-bool ang_sort_comp_distance(PlayerType *player_ptr, vptr u, vptr v, int a, int b);
-bool ang_sort_comp_importance(PlayerType *player_ptr, vptr u, vptr v, int a, int b);
-void ang_sort_swap_position(PlayerType *player_ptr, vptr u, vptr v, int a, int b);
+/*!
+ * @brief 範囲全体を比較関数で安定ソートする
+ * @param range ソート対象のコンテナや配列
+ * @param comp 厳密な弱順序を満たす比較関数 (前に来るべきならtrue)
+ * @details 比較関数で等しいとされた要素は元の並び順を保つ
+ */
+template <typename Range, typename Compare>
+void ang_stable_sort(Range &range, Compare comp)
+{
+    std::stable_sort(std::begin(range), std::end(range), comp);
+}
 
-bool ang_sort_art_comp(PlayerType *player_ptr, vptr u, vptr v, int a, int b);
-void ang_sort_art_swap(PlayerType *player_ptr, vptr u, vptr v, int a, int b);
+/*!
+ * @brief 各要素から取り出したキーで範囲全体をソートする
+ * @param range ソート対象のコンテナや配列
+ * @param proj 要素からキーを取り出す関数 (メンバポインタも可)
+ * @param comp キー同士の比較関数 (省略時は昇順)
+ */
+template <typename Range, typename Projection, typename Compare = std::less<>>
+void ang_sort_by(Range &range, Projection proj, Compare comp = {})
+{
+    std::sort(std::begin(range), std::end(range), [&proj, &comp](const auto &a, const auto &b) {
+        return comp(std::invoke(proj, a), std::invoke(proj, b));
+    });
+}
 
-bool ang_sort_comp_quest_num(PlayerType *player_ptr, vptr u, vptr v, int a, int b);
-void ang_sort_swap_quest_num(PlayerType *player_ptr, vptr u, vptr v, int a, int b);
+/*!
+ * @brief 各要素から取り出したキーで範囲全体を安定ソートする
+ * @param range ソート対象のコンテナや配列
+ * @param proj 要素からキーを取り出す関数 (メンバポインタも可)
+ * @param comp キー同士の比較関数 (省略時は昇順)
+ */
+template <typename Range, typename Projection, typename Compare = std::less<>>
+void ang_stable_sort_by(Range &range, Projection proj, Compare comp = {})
+{
+    std::stable_sort(std::begin(range), std::end(range), [&proj, &comp](const auto &a, const auto &b) {
+        return comp(std::invoke(proj, a), std::invoke(proj, b));
+    });
+}
 
-bool ang_sort_comp_pet(PlayerType *player_ptr, vptr u, vptr v, int a, int b);
+/*!
+ * @brief y/x座標それぞれの配列を、座標の組として安定ソートする
+ * @param ys y座標の配列
+ * @param xs x座標の配列 (ysと同じ長さであること)
+ * @param comp 座標同士の比較関数
+ */
+template <typename Compare>
+void ang_sort_positions(std::vector<POSITION> &ys, std::vector<POSITION> &xs, Compare comp)
+{
+    std::vector<Pos2D> positions;
+    positions.reserve(ys.size());
+    for (size_t i = 0; i < ys.size(); i++) {
+        positions.emplace_back(ys[i], xs[i]);
+    }
 
-bool ang_sort_comp_hook(PlayerType *player_ptr, vptr u, vptr v, int a, int b);
-void ang_sort_swap_hook(PlayerType *player_ptr, vptr u, vptr v, int a, int b);
+    ang_stable_sort(positions, comp);
+    for (size_t i = 0; i < positions.size(); i++) {
+        ys[i] = positions[i].y;
+        xs[i] = positions[i].x;
+    }
+}
 
-bool ang_sort_comp_monster_level(PlayerType *player_ptr, vptr u, vptr v, int a, int b);
-bool ang_sort_comp_pet_dismiss(PlayerType *player_ptr, vptr u, vptr v, int a, int b);
-
-bool ang_sort_comp_cave_temp(PlayerType *player_ptr, vptr u, vptr v, int a, int b);
-void ang_sort_swap_cave_temp(PlayerType *player_ptr, vptr u, vptr v, int a, int b);
+enum class FixedArtifactId : short;
+enum class MonsterRaceId : int16_t;
+enum class QuestId : int16_t;
+class PlayerType;
+bool ang_sort_comp_distance(const PlayerType *player_ptr, const Pos2D &pos1, const Pos2D &pos2);
+bool ang_sort_comp_importance(PlayerType *player_ptr, const Pos2D &pos1, const Pos2D &pos2);
+bool ang_sort_art_comp(FixedArtifactId id1, FixedArtifactId id2, uint16_t why);
+bool ang_sort_comp_quest_num(QuestId id1, QuestId id2);
+bool ang_sort_comp_pet(PlayerType *player_ptr, MONSTER_IDX m_idx1, MONSTER_IDX m_idx2);
+bool ang_sort_comp_hook(MonsterRaceId r_idx1, MonsterRaceId r_idx2, uint16_t why);
+bool ang_sort_comp_monster_level(MonsterRaceId r_idx1, MonsterRaceId r_idx2);
+bool ang_sort_comp_pet_dismiss(PlayerType *player_ptr, MONSTER_IDX m_idx1, MONSTER_IDX m_idx2);
@@ -0,0 +1,113 @@
+﻿/*!
+ * @file worker-pool.cpp
+ * @brief 常駐するワーカースレッドで処理を並列に行うスレッドプール
+ */
+
+#include "util/worker-pool.h"
+#include <algorithm>
+
+/*!
+ * @brief スレッドプールを返す
+ * @details ワーカースレッドは (論理コア数 - 1) 個で、呼び出し元のスレッドと合わせてコア数分を使う
+ */
+WorkerPool &WorkerPool::get_instance()
+{
+    static WorkerPool instance;
+    return instance;
+}
+
+WorkerPool::WorkerPool()
+{
+    const auto thread_num = std::max(static_cast<int>(std::thread::hardware_concurrency()), 1);
+    for (auto i = 1; i < thread_num; i++) {
+        this->threads.emplace_back([this] { this->work(); });
+    }
+}
+
+WorkerPool::~WorkerPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        this->stopping = true;
+    }
+
+    this->start_cv.notify_all();
+    for (auto &thread : this->threads) {
+        thread.join();
+    }
+}
+
+/*!
+ * @brief 処理を行うスレッドの数 (呼び出し元を含む) を返す
+ */
+int WorkerPool::get_thread_num() const
+{
+    return static_cast<int>(this->threads.size()) + 1;
+}
+
+/*!
+ * @brief 処理 task(0) ～ task(task_num - 1) を並列に行う
+ * @param task_num 処理の数
+ * @param task 処理の番号を受け取る処理本体. 互いに独立していなければならない
+ * @details 処理の実行順序は不定. 全ての処理が終わってから戻る
+ */
+void WorkerPool::run(int task_num, const std::function<void(int)> &task)
+{
+    if (this->threads.empty() || (task_num <= 1)) {
+        for (auto i = 0; i < task_num; i++) {
+            task(i);
+        }
+
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        this->task = &task;
+        this->task_num = task_num;
+        this->next_task = 0;
+        this->running = static_cast<int>(this->threads.size());
+        this->generation++;
+    }
+
+    this->start_cv.notify_all();
+    this->consume();
+    std::unique_lock<std::mutex> lock(this->mutex);
+    this->done_cv.wait(lock, [this] { return this->running == 0; });
+    this->task = nullptr;
+}
+
+/*!
+ * @brief ワーカースレッドの本体. 処理の開始を待ち、処理を取り出して行うことを繰り返す
+ */
+void WorkerPool::work()
+{
+    auto seen_generation = 0;
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(this->mutex);
+            this->start_cv.wait(lock, [this, seen_generation] { return this->stopping || (this->generation != seen_generation); });
+            if (this->stopping) {
+                return;
+            }
+
+            seen_generation = this->generation;
+        }
+
+        this->consume();
+        std::lock_guard<std::mutex> lock(this->mutex);
+        if (--this->running == 0) {
+            this->done_cv.notify_one();
+        }
+    }
+}
+
+/*!
+ * @brief 残っている処理を1つずつ取り出して行う
+ */
+void WorkerPool::consume()
+{
+    for (auto i = this->next_task++; i < this->task_num; i = this->next_task++) {
+        (*this->task)(i);
+    }
+}
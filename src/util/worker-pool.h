@@ -0,0 +1,50 @@
+﻿#pragma once
+
+/*!
+ * @file worker-pool.h
+ * @brief 常駐するワーカースレッドで処理を並列に行うスレッドプールのヘッダ
+ */
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/*!
+ * @brief 起動済みのワーカースレッドに処理を割り振るスレッドプール
+ * @details
+ * 1ゲームターンに何度も呼ばれる処理を並列化するため、スレッドは最初に使う時に1度だけ作り、以降は待機させておく.
+ * 呼び出し元のスレッドも処理に加わり、全ての処理が終わるまで戻らない.
+ */
+class WorkerPool final {
+public:
+    static WorkerPool &get_instance();
+
+    int get_thread_num() const;
+    void run(int task_num, const std::function<void(int)> &task);
+
+    WorkerPool(const WorkerPool &) = delete;
+    WorkerPool(WorkerPool &&) = delete;
+    WorkerPool &operator=(const WorkerPool &) = delete;
+    WorkerPool &operator=(WorkerPool &&) = delete;
+
+private:
+    WorkerPool();
+    ~WorkerPool();
+
+    void work();
+    void consume();
+
+    std::vector<std::thread> threads;
+    std::mutex mutex;
+    std::condition_variable start_cv; //!< 処理の開始と終了要求の通知
+    std::condition_variable done_cv; //!< 全ワーカーが処理を終えたことの通知
+    const std::function<void(int)> *task = nullptr; //!< 実行中の処理
+    int task_num = 0; //!< 実行中の処理の数
+    std::atomic<int> next_task = 0; //!< 次に取り出す処理の番号
+    int generation = 0; //!< run() の呼び出し毎に増える番号
+    int running = 0; //!< 処理を終えていないワーカースレッドの数
+    bool stopping = false;
+};
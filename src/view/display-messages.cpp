@@ -12,10 +12,13 @@
 #include "util/int-char-converter.h"
 #include "world/world.h"
 
+#include <array>
+#include <charconv>
 #include <deque>
-#include <map>
-#include <memory>
 #include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
 
 /* Used in msg_print() for "buffering" */
 bool msg_flag;
@@ -27,42 +30,148 @@ namespace {
 /*! 表示するメッセージの先頭位置 */
 static int msg_head_pos = 0;
 
-using msg_sp = std::shared_ptr<const std::string>;
-using msg_wp = std::weak_ptr<const std::string>;
+constexpr auto MESSAGE_REPEAT_MAX = 1000; //!< 同じメッセージをまとめる最大の回数
+constexpr auto MESSAGE_SPLIT_WIDTH = 80; //!< これより長いメッセージは分割して履歴に追加する
 
-/** メッセージが同一かどうかを比較するためのラムダ式 */
-auto string_ptr_cmp = [](const std::string *a, const std::string *b) { return *a < *b; };
+/*!
+ * @brief 履歴に保持しているメッセージの文字列
+ * @details 同じ文字列は1つだけ保持し、履歴からの参照が無くなったら再利用する
+ */
+struct InternedMessage {
+    std::string text;
+    int refs = 0; //!< 履歴から参照されている数
+};
 
-/** 同一メッセージの検索に使用するmapオブジェクト。
- * 同一メッセージがあるかどうかを検索し、ヒットしたらweak_ptrからshared_ptrを作成しメッセージを共有する。
- * message_historyのカスタムデリータの中で参照するので、message_historyより先に宣言しなければならない事に注意。
+/*!
+ * @brief メッセージ履歴の1行
  */
-std::map<const std::string *, msg_wp, decltype(string_ptr_cmp)> message_map(string_ptr_cmp);
+struct MessageEntry {
+    uint32_t id = 0; //!< 文字列の番号 (interned_messages の添字)
+    int count = 0; //!< 同じメッセージが連続した回数
+};
 
-/** メッセージ履歴 */
-std::deque<msg_sp> message_history;
+/*! 文字列の本体。要素の追加で既存の文字列が移動しないよう std::deque を使う */
+std::deque<InternedMessage> interned_messages;
 
-/**
- * @brief メッセージを保持する msg_sp オブジェクトを生成する
- *
- * @tparam T メッセージの型。std::string / std::string_view / const char* 等
+/*! 文字列から番号を引く表。キーは interned_messages の文字列を指す */
+std::unordered_map<std::string_view, uint32_t> interned_ids;
+
+/*! 参照が無くなり再利用できる文字列の番号 */
+std::vector<uint32_t> free_message_ids;
+
+/*! メッセージ履歴 (固定長の環状バッファ) */
+std::array<MessageEntry, MESSAGE_MAX> message_history;
+
+int message_history_head = 0; //!< 次に追加する位置
+int message_history_size = 0; //!< 保持しているメッセージの数
+
+/*!
+ * @brief 文字列の番号を得る
+ * @details 既に保持している文字列ならその番号を、無ければ新たに保持して番号を返す。参照数は増やさない
+ */
+uint32_t intern_message(std::string_view str)
+{
+    if (const auto it = interned_ids.find(str); it != interned_ids.end()) {
+        return it->second;
+    }
+
+    uint32_t id;
+    if (free_message_ids.empty()) {
+        id = static_cast<uint32_t>(interned_messages.size());
+        interned_messages.emplace_back();
+    } else {
+        id = free_message_ids.back();
+        free_message_ids.pop_back();
+    }
+
+    auto &message = interned_messages[id];
+    message.text = str;
+    interned_ids.emplace(message.text, id);
+    return id;
+}
+
+/*!
+ * @brief 文字列の参照を1つ外し、参照が無くなったら再利用に回す
+ */
+void release_message(uint32_t id)
+{
+    auto &message = interned_messages[id];
+    if (--message.refs > 0) {
+        return;
+    }
+
+    interned_ids.erase(message.text);
+    message.text.clear();
+    free_message_ids.push_back(id);
+}
+
+MessageEntry &get_message_entry(int age)
+{
+    return message_history[(message_history_head + MESSAGE_MAX - 1 - age) % MESSAGE_MAX];
+}
+
+/*!
+ * @brief 「～ <xNN>」形式の回数表示を取り除く
  * @param str メッセージ
- * @return 生成した msg_sp オブジェクト
+ * @return 回数表示を除いたメッセージと回数 (回数表示が無ければ1)
+ * @details セーブファイルから読み込んだ履歴は回数表示込みの文字列になっているため、回数へ戻す
  */
-template <typename T>
-msg_sp make_message(T &&str)
+std::pair<std::string_view, int> split_repeat_count(std::string_view str)
 {
-    /** std::stringオブジェクトと同時にmessage_mapのエントリも削除するカスタムデリータ */
-    auto deleter = [](std::string *s) {
-        message_map.erase(s);
-        delete s;
-    };
+    if ((str.length() < sizeof(" <xN>") - 1) || (str.back() != '>')) {
+        return { str, 1 };
+    }
+
+    const auto pos = str.rfind(" <x");
+    if (pos == std::string_view::npos) {
+        return { str, 1 };
+    }
+
+    int count;
+    const auto *first = str.data() + pos + 3;
+    const auto *last = str.data() + str.length() - 1;
+    const auto [ptr, ec] = std::from_chars(first, last, count);
+    if ((ec != std::errc()) || (ptr != last) || (count < 1)) {
+        return { str, 1 };
+    }
+
+    return { str.substr(0, pos), count };
+}
+
+/*!
+ * @brief 分割済みの1行をメッセージ履歴に追加する
+ * @details 直前と同じメッセージであれば、新たな行を作らずに回数を増やす
+ */
+void push_message(std::string_view str)
+{
+    const auto [text, count] = split_repeat_count(str);
+    if (message_history_size > 0) {
+        auto &last = get_message_entry(0);
+        if ((count == 1) && (last.count < MESSAGE_REPEAT_MAX) && (interned_messages[last.id].text == text)) {
+            last.count++;
+            if (!now_message) {
+                now_message++;
+            }
+
+            return;
+        }
 
-    // 新たにメッセージを保持する msg_sp オブジェクトを生成し、検索用mapオブジェクトにも追加する
-    auto new_msg = msg_sp(new std::string(std::forward<T>(str)), std::move(deleter));
-    message_map.emplace(new_msg.get(), msg_wp(new_msg));
+        /*流れた行の数を数えておく */
+        num_more++;
+        now_message++;
+    }
+
+    const auto id = intern_message(text);
+    interned_messages[id].refs++;
+    auto &entry = message_history[message_history_head];
+    if (message_history_size == MESSAGE_MAX) {
+        release_message(entry.id);
+    } else {
+        message_history_size++;
+    }
 
-    return new_msg;
+    entry = { id, count };
+    message_history_head = (message_history_head + 1) % MESSAGE_MAX;
 }
 }
 
@@ -72,13 +181,14 @@ msg_sp make_message(T &&str)
  */
 int32_t message_num(void)
 {
-    return message_history.size();
+    return message_history_size;
 }
 
 /*!
  * @brief 過去のゲームメッセージを返す。 / Recall the "text" of a saved message
  * @param age メッセージの世代
  * @return メッセージの文字列ポインタ
+ * @details 回数表示の付くメッセージは共用のバッファに書き出すため、次に呼ぶまでの間だけ有効
  */
 concptr message_str(int age)
 {
@@ -86,111 +196,55 @@ concptr message_str(int age)
         return "";
     }
 
-    return message_history[age]->data();
+    const auto &entry = get_message_entry(age);
+    const auto &text = interned_messages[entry.id].text;
+    if (entry.count == 1) {
+        return text.data();
+    }
+
+    static std::string repeated_message;
+    repeated_message = format("%s <x%d>", text.data(), entry.count);
+    return repeated_message.data();
 }
 
-static void message_add_aux(std::string str)
+/*!
+ * @brief ゲームメッセージをログに追加する。 / Add a new message, with great efficiency
+ * @param msg 保存したいメッセージ
+ * @details 80桁を超えるメッセージは80桁ずつ分割する
+ */
+void message_add(std::string_view msg)
 {
-    std::string splitted;
-
-    if (str.empty()) {
-        return;
-    }
-
-    // 80桁を超えるメッセージは80桁ずつ分割する
-    if (str.length() > 80) {
+    auto str = msg;
+    while (str.length() > MESSAGE_SPLIT_WIDTH) {
         int n;
 #ifdef JP
-        for (n = 0; n < 80; n++) {
+        for (n = 0; n < MESSAGE_SPLIT_WIDTH; n++) {
             if (iskanji(str[n])) {
                 n++;
             }
         }
 
         /* 最後の文字が漢字半分 */
-        if (n == 81) {
-            n = 79;
+        if (n == MESSAGE_SPLIT_WIDTH + 1) {
+            n = MESSAGE_SPLIT_WIDTH - 1;
         }
 #else
-        for (n = 80; n > 60; n--) {
+        for (n = MESSAGE_SPLIT_WIDTH; n > 60; n--) {
             if (str[n] == ' ') {
                 break;
             }
         }
         if (n == 60) {
-            n = 80;
-        }
-#endif
-        splitted = str.substr(n);
-        str = str.substr(0, n);
-    }
-
-    // 直前と同じメッセージの場合、「～ <xNN>」と表示する
-    if (!message_history.empty()) {
-        const char *t;
-        std::string_view last_message = *message_history.front();
-#ifdef JP
-        for (t = last_message.data(); *t && (*t != '<' || (*(t + 1) != 'x')); t++) {
-            if (iskanji(*t)) {
-                t++;
-            }
-        }
-#else
-        for (t = last_message.data(); *t && (*t != '<'); t++) {
-            ;
+            n = MESSAGE_SPLIT_WIDTH;
         }
 #endif
-        int j = 1;
-        if (*t && t != last_message.data()) {
-            if (last_message.length() >= sizeof(" <xN>") - 1) {
-                last_message = last_message.substr(0, t - last_message.data() - 1);
-                j = atoi(t + 2);
-            }
-        }
-
-        if (str == last_message && (j < 1000)) {
-            str = format("%s <x%d>", str.data(), j + 1);
-            message_history.pop_front();
-            if (!now_message) {
-                now_message++;
-            }
-        } else {
-            /*流れた行の数を数えておく */
-            num_more++;
-            now_message++;
-        }
+        push_message(str.substr(0, n));
+        str.remove_prefix(n);
     }
 
-    msg_sp add_msg;
-
-    // メッセージ履歴から同一のメッセージを探す
-    if (const auto &it = message_map.find(&str); it != message_map.end()) {
-        // 同一のメッセージが見つかったならそのメッセージの msg_sp オブジェクトを複製
-        add_msg = it->second.lock();
-    } else {
-        // 見つからなかった場合は新たに msg_sp オブジェクトを作成
-        add_msg = make_message(std::move(str));
+    if (!str.empty()) {
+        push_message(str);
     }
-
-    // メッセージ履歴に追加
-    message_history.push_front(std::move(add_msg));
-
-    if (message_history.size() == MESSAGE_MAX) {
-        message_history.pop_back();
-    }
-
-    if (!splitted.empty()) {
-        message_add_aux(std::move(splitted));
-    }
-}
-
-/*!
- * @brief ゲームメッセージをログに追加する。 / Add a new message, with great efficiency
- * @param msg 保存したいメッセージ
- */
-void message_add(std::string_view msg)
-{
-    message_add_aux(std::string(msg));
 }
 
 bool is_msg_window_flowed(void)
@@ -326,7 +380,7 @@ static int split_length(std::string_view sv, int max)
  */
 void msg_print(std::string_view msg)
 {
-    if (w_ptr->timewalk_m_idx) {
+    if (w_ptr->timewalk_m_idx || w_ptr->is_speculating_floor) {
         return;
     }
 
@@ -375,7 +429,7 @@ void msg_print(std::string_view msg)
 
 void msg_print(std::nullptr_t)
 {
-    if (w_ptr->timewalk_m_idx) {
+    if (w_ptr->timewalk_m_idx || w_ptr->is_speculating_floor) {
         return;
     }
 
@@ -614,7 +614,7 @@ static void display_floor_item_list(PlayerType *player_ptr, const int y, const i
 
     // (y,x) のアイテムを1行に1個ずつ書く。
     TERM_LEN term_y = 1;
-    for (const auto o_idx : g_ptr->o_idx_list) {
+    for (const auto o_idx : floor_ptr->grid_array.o_idx_list(g_ptr)) {
         auto *const o_ptr = &floor_ptr->o_list[o_idx];
         const auto tval = o_ptr->bi_key.tval();
         if (o_ptr->marked.has_not(OmType::FOUND) || tval == ItemKindType::GOLD) {
@@ -43,7 +43,7 @@
 /*!
  * @brief デバグコマンド一覧表
  * @details
- * 空き: A,B,E,I,J,k,K,L,M,q,Q,R,T,U,V,W,y,Y
+ * 空き: A,B,E,I,J,k,K,L,M,q,Q,U,V,W,y,Y
  */
 constexpr std::array debug_menu_table = {
     std::make_tuple('a', _("全状態回復", "Restore all status")),
@@ -70,8 +70,10 @@ constexpr std::array debug_menu_table = {
     std::make_tuple('p', _("ショート・テレポート", "Phase door")),
     std::make_tuple('P', _("プレイヤー設定変更メニュー", "Modify player configurations")),
     std::make_tuple('r', _("カオスパトロンの報酬", "Get reward of chaos patron")),
+    std::make_tuple('R', _("乱数の写像の比較", "Benchmark RNG range mapping")),
     std::make_tuple('s', _("フロア相当のモンスター召喚", "Summon monster which be in target depth")),
     std::make_tuple('t', _("テレポート", "Teleport self")),
+    std::make_tuple('T', _("サブシステム毎の処理時間を表示", "Show subsystem profile")),
     std::make_tuple('u', _("啓蒙(忍者以外)", "Wiz-lite all floor except Ninja")),
     std::make_tuple('w', _("啓蒙(忍者配慮)", "Wiz-lite all floor")),
     std::make_tuple('x', _("経験値を得る(指定可)", "Get experience")),
@@ -197,6 +199,9 @@ bool exe_cmd_debug(PlayerType *player_ptr, char cmd)
     case 'r':
         patron_list[player_ptr->chaos_patron].gain_level_reward(player_ptr, command_arg);
         break;
+    case 'R':
+        wiz_benchmark_rng();
+        break;
     case 'N':
         wiz_summon_pet(player_ptr, i2enum<MonsterRaceId>(command_arg));
         break;
@@ -225,6 +230,9 @@ bool exe_cmd_debug(PlayerType *player_ptr, char cmd)
     case 't':
         teleport_player(player_ptr, 100, TELEPORT_SPONTANEOUS);
         break;
+    case 'T':
+        wiz_show_profile();
+        break;
     case 'u':
         for (int y = 0; y < player_ptr->current_floor_ptr->height; y++) {
             for (int x = 0; x < player_ptr->current_floor_ptr->width; x++) {
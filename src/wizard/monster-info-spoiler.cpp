@@ -9,6 +9,7 @@
 #include "term/term-color-types.h"
 #include "util/angband-files.h"
 #include "util/bit-flags-calculator.h"
+#include "util/enum-converter.h"
 #include "util/sort.h"
 #include "util/string-processor.h"
 #include "view/display-lore.h"
@@ -74,7 +75,6 @@ static concptr attr_to_text(MonsterRaceInfo *r_ptr)
 
 SpoilerOutputResultType spoil_mon_desc(concptr fname, std::function<bool(const MonsterRaceInfo *)> filter_monster)
 {
-    PlayerType dummy;
     uint16_t why = 2;
     char buf[1024];
     char nam[MAX_MONSTER_NAME + 10]; // ユニークには[U] が付くので少し伸ばす
@@ -109,7 +109,7 @@ SpoilerOutputResultType spoil_mon_desc(concptr fname, std::function<bool(const M
         }
     }
 
-    ang_sort(&dummy, who.data(), &why, who.size(), ang_sort_comp_hook, ang_sort_swap_hook);
+    ang_sort(who, [why](auto r_idx1, auto r_idx2) { return ang_sort_comp_hook(r_idx1, r_idx2, why); });
     for (auto r_idx : who) {
         auto *r_ptr = &monraces_info[r_idx];
         if (filter_monster && !filter_monster(r_ptr)) {
@@ -172,7 +172,6 @@ static void roff_func(TERM_COLOR attr, concptr str)
  */
 SpoilerOutputResultType spoil_mon_info(concptr fname)
 {
-    PlayerType dummy;
     char buf[1024];
     path_build(buf, sizeof(buf), ANGBAND_DIR_USER, fname);
     spoiler_file = angband_fopen(buf, "w");
@@ -194,7 +193,7 @@ SpoilerOutputResultType spoil_mon_info(concptr fname)
     }
 
     uint16_t why = 2;
-    ang_sort(&dummy, who.data(), &why, who.size(), ang_sort_comp_hook, ang_sort_swap_hook);
+    ang_sort(who, [why](auto r_idx1, auto r_idx2) { return ang_sort_comp_hook(r_idx1, r_idx2, why); });
     for (auto r_idx : who) {
         auto *r_ptr = &monraces_info[r_idx];
         if (r_ptr->kind_flags.has(MonsterKindType::UNIQUE)) {
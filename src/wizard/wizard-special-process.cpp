@@ -20,6 +20,7 @@
 #include "core/asking-player.h"
 #include "core/player-redraw-types.h"
 #include "core/player-update-types.h"
+#include "core/profiler.h"
 #include "core/stuff-handler.h"
 #include "core/window-redrawer.h"
 #include "dungeon/quest.h"
@@ -39,6 +40,7 @@
 #include "inventory/inventory-object.h"
 #include "inventory/inventory-slot-types.h"
 #include "io/files-util.h"
+#include "io/input-key-acceptor.h"
 #include "io/input-key-requester.h"
 #include "io/write-diary.h"
 #include "market/arena.h"
@@ -94,6 +96,7 @@
 #include "util/bit-flags-calculator.h"
 #include "util/enum-converter.h"
 #include "util/int-char-converter.h"
+#include "util/rng-xoshiro.h"
 #include "view/display-messages.h"
 #include "wizard/spoiler-table.h"
 #include "wizard/tval-descriptions-table.h"
@@ -101,7 +104,12 @@
 #include "wizard/wizard-spoiler.h"
 #include "world/world.h"
 #include <algorithm>
+#include <array>
+#include <chrono>
+#include <functional>
+#include <numeric>
 #include <optional>
+#include <random>
 #include <sstream>
 #include <tuple>
 #include <vector>
@@ -615,7 +623,7 @@ static bool select_debugging_floor(PlayerType *player_ptr, int dungeon_type)
  * @brief 任意のダンジョン及び階層に飛ぶ
  * Go to any level
  */
-static void wiz_jump_floor(PlayerType *player_ptr, DUNGEON_IDX dun_idx, DEPTH depth)
+void wiz_jump_floor(PlayerType *player_ptr, DUNGEON_IDX dun_idx, DEPTH depth)
 {
     player_ptr->dungeon_idx = dun_idx;
     auto &floor_ref = *player_ptr->current_floor_ptr;
@@ -800,6 +808,137 @@ void wiz_dump_options(void)
     msg_format(_("オプションbit使用状況をファイル %s に書き出しました。", "Option bits usage dump saved to file %s."), buf);
 }
 
+/*!
+ * @brief 直近のゲームターンにおけるサブシステム毎の処理時間を表示する
+ * @details
+ * 計測の有効/無効の切替、計測値の破棄及びCSVへの書き出しもここで行う.
+ * 処理区分は入れ子になりうるため、割合の合計は100%を超えることがある.
+ * USE_PROFILER が無効なビルドでは計測できないため、その旨を表示するだけとする.
+ */
+void wiz_show_profile()
+{
+#ifndef USE_PROFILER
+    msg_print(_("このビルドにはプロファイラが組み込まれていません (configure --enable-profiler で有効になります)。", "The profiler is compiled out of this build (configure with --enable-profiler)."));
+#else
+    auto &profiler = Profiler::get_instance();
+    screen_save();
+    while (true) {
+        for (auto y = 1; y < enum2i(ProfileSection::MAX) + 5; y++) {
+            term_erase(14, y, 255);
+        }
+
+        const auto turns = profiler.get_recorded_turns();
+        const auto records = profiler.get_recent(turns);
+        const auto &total = records[enum2i(ProfileSection::GAME_TURN)];
+        put_str(format(_("直近 %d ゲームターン (計測%s)", "Last %d game turns (profiler %s)"), turns, profiler.is_enabled() ? _("中", "on") : _("停止", "off")), 1, 15);
+        put_str(format("%-16s %10s %7s %8s", "section", "us/turn", "share", "calls"), 2, 15);
+        for (auto i = 0; i < enum2i(ProfileSection::MAX); i++) {
+            const auto &record = records[i];
+            const auto time_per_turn = turns > 0 ? record.time_ns / 1000.0 / turns : 0.0;
+            const auto share = total.time_ns > 0 ? record.time_ns * 100.0 / total.time_ns : 0.0;
+            const auto name = Profiler::get_name(i2enum<ProfileSection>(i));
+            put_str(format("%-16s %10.1f %6.1f%% %8d", name.data(), time_per_turn, share, record.calls), i + 3, 15);
+        }
+
+        char cmd = ESCAPE;
+        get_com(_("[e]計測切替 [r]リセット [d]CSV出力 [ESC]終了: ", "[e]nable/disable [r]eset [d]ump CSV [ESC]: "), &cmd, false);
+        switch (cmd) {
+        case ESCAPE:
+            screen_load();
+            return;
+        case 'e':
+            profiler.set_enabled(!profiler.is_enabled());
+            break;
+        case 'r':
+            profiler.reset();
+            break;
+        case 'd': {
+            char buf[1024];
+            path_build(buf, sizeof(buf), ANGBAND_DIR_USER, "profile.csv");
+            if (profiler.dump_csv(buf)) {
+                msg_format(_("処理時間をファイル %s に書き出しました。", "Profile dump saved to file %s."), buf);
+            } else {
+                msg_format(_("ファイル %s を開けませんでした。", "Failed to open file %s."), buf);
+            }
+
+            msg_print(nullptr);
+            break;
+        }
+        default:
+            break;
+        }
+    }
+#endif
+}
+
+/*!
+ * @brief 乱数の範囲への写像を従来の方法と比較する
+ * @details
+ * 同じシードから std::uniform_int_distribution と Xoshiro128StarStar::fill() でそれぞれ乱数を生成し、
+ * 1回あたりの処理時間、一様分布に対するカイ二乗値 (自由度に近ければ良い) 及び両者の値が一致した割合を表示する.
+ * ゲーム本体の乱数には影響しない.
+ */
+void wiz_benchmark_rng()
+{
+    constexpr auto SAMPLES = 1000000;
+    constexpr uint32_t SEED = 0x5a17b3c9;
+    constexpr std::array<uint32_t, 6> ranges = { { 2, 6, 100, 1000, 10007, 0x10000000 } };
+    constexpr uint32_t CHI_SQUARE_BINS = 16384;
+
+    const auto calc_chi_square = [](const std::vector<uint32_t> &values, uint32_t range, uint32_t bins) {
+        std::vector<int> counts(bins);
+        for (const auto value : values) {
+            counts[static_cast<uint64_t>(value) * bins / range]++;
+        }
+
+        const auto expected = static_cast<double>(values.size()) / bins;
+        auto chi_square = 0.0;
+        for (const auto count : counts) {
+            chi_square += (count - expected) * (count - expected) / expected;
+        }
+
+        return chi_square;
+    };
+
+    screen_save();
+    for (auto y = 1; y < static_cast<int>(ranges.size()) + 4; y++) {
+        term_erase(14, y, 255);
+    }
+
+    put_str(format(_("各範囲で乱数を %d 回生成 (従来/高速)", "%d draws per range (legacy / fast)"), SAMPLES), 1, 15);
+    put_str(format("%10s %8s %8s %9s %9s %5s %7s", "range", "ns/old", "ns/fast", "chi2/old", "chi2/fast", "df", "same"), 2, 15);
+    auto row = 3;
+    for (const auto range : ranges) {
+        std::vector<uint32_t> legacy_values(SAMPLES);
+        Xoshiro128StarStar legacy_rng(SEED);
+        const auto legacy_start = std::chrono::steady_clock::now();
+        for (auto &value : legacy_values) {
+            std::uniform_int_distribution<> d(0, static_cast<int>(range) - 1);
+            value = static_cast<uint32_t>(d(legacy_rng));
+        }
+
+        const auto legacy_time = std::chrono::steady_clock::now() - legacy_start;
+
+        std::vector<uint32_t> fast_values(SAMPLES);
+        Xoshiro128StarStar fast_rng(SEED);
+        const auto fast_start = std::chrono::steady_clock::now();
+        fast_rng.fill(fast_values.begin(), fast_values.end(), range);
+        const auto fast_time = std::chrono::steady_clock::now() - fast_start;
+
+        const auto same = std::inner_product(legacy_values.begin(), legacy_values.end(), fast_values.begin(), 0, std::plus<>(), std::equal_to<>());
+        const auto bins = std::min(range, CHI_SQUARE_BINS);
+        const auto legacy_ns = std::chrono::duration<double, std::nano>(legacy_time).count() / SAMPLES;
+        const auto fast_ns = std::chrono::duration<double, std::nano>(fast_time).count() / SAMPLES;
+        put_str(format("%10u %8.2f %8.2f %9.1f %9.1f %5u %6.2f%%", range, legacy_ns, fast_ns, calc_chi_square(legacy_values, range, bins),
+                    calc_chi_square(fast_values, range, bins), bins - 1, same * 100.0 / SAMPLES),
+            row++, 15);
+    }
+
+    prt(_("何かキーを押してください", "Hit any key"), row + 1, 15);
+    (void)inkey();
+    screen_load();
+}
+
 /*!
  * @brief プレイ日数を変更する / Set gametime.
  * @return 実際に変更を行ったらTRUEを返す
@@ -19,11 +19,20 @@
  * @param floo_ptr 現在フロアへの参照ポインタ
  * @return 開いているオブジェクト要素のID
  * @details
+ * 削除されたアイテムの要素を空きリストから優先して再利用し、無ければ配列の末尾を伸ばす.
  * This routine should almost never fail, but in case it does,
  * we must be sure to handle "failure" of this routine.
  */
 OBJECT_IDX o_pop(FloorType *floor_ptr)
 {
+    const auto recycled_idx = floor_ptr->o_slots.acquire([floor_ptr](OBJECT_IDX idx) {
+        return (idx < floor_ptr->o_max) && !floor_ptr->o_list[idx].is_valid();
+    });
+    if (recycled_idx > 0) {
+        floor_ptr->o_cnt++;
+        return recycled_idx;
+    }
+
     if (floor_ptr->o_max < w_ptr->max_o_idx) {
         OBJECT_IDX i = floor_ptr->o_max;
         floor_ptr->o_max++;
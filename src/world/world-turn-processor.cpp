@@ -3,6 +3,7 @@
 #include "cmd-io/cmd-save.h"
 #include "core/disturbance.h"
 #include "core/magic-effects-timeout-reducer.h"
+#include "core/profiler.h"
 #include "floor/floor-events.h"
 #include "floor/floor-mode-changer.h"
 #include "floor/wild.h"
@@ -55,6 +56,7 @@ WorldTurnProcessor::WorldTurnProcessor(PlayerType *player_ptr)
  */
 void WorldTurnProcessor::process_world()
 {
+    ProfileScope profile_scope(ProfileSection::WORLD);
     const int32_t a_day = TURNS_PER_TICK * TOWN_DAWN;
     int32_t prev_turn_in_today = ((w_ptr->game_turn - TURNS_PER_TICK) % a_day + a_day / 4) % a_day;
     int prev_min = (1440 * prev_turn_in_today / a_day) % 60;
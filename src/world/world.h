@@ -25,6 +25,7 @@ struct world_type {
     uint16_t total_winner{}; /* Total winner */
 
     MONSTER_IDX timewalk_m_idx{}; /*!< 現在時間停止を行っているモンスターのID */
+    bool is_speculating_floor{}; /*!< 次のフロアを先読みで生成中か (生成中のメッセージを出さない) */
 
     bounty_type bounties[MAX_BOUNTY]{};
     MonsterRaceId today_mon{}; //!< 実際の日替わり賞金首